@@ -0,0 +1,14 @@
+let tests = require("tests");
+
+// Arrays keep their elements as properties named by index
+let a = [];
+for (let i = 0; i < 100; i++) {
+    a.push(i * 2);
+}
+let sum = 0;
+for (let n = 0; n < 10; n++) {
+    for (let i = 0; i < 100; i = i + 3) {
+        sum = sum + a[i];
+    }
+}
+tests.assert_eq(33660, sum);
@@ -0,0 +1,9 @@
+let tests = require("tests");
+let math = require("math");
+
+// Module objects are the widest objects most scripts touch
+let sum = 0;
+for (let n = 0; n < 300; n++) {
+    sum = sum + math.abs(-1) + math.max(1, 2) + math.floor(math.PI) + math.sign(-3);
+}
+tests.assert_eq(1500, sum);
@@ -0,0 +1,52 @@
+let tests = require("tests");
+
+// Wide object: lookups go through the property index
+let o = {
+    alpha: 0,
+    bravo: 1,
+    charlie: 2,
+    delta: 3,
+    echo: 4,
+    foxtrot: 5,
+    golf: 6,
+    hotel: 7,
+    india: 8,
+    juliett: 9,
+    kilo: 10,
+    lima: 11,
+    mike: 12,
+    november: 13,
+    oscar: 14,
+    papa: 15,
+    quebec: 16,
+    romeo: 17,
+    sierra: 18,
+    tango: 19,
+    uniform: 20,
+    victor: 21,
+    whiskey: 22,
+    xray: 23,
+};
+
+let sum = 0;
+for (let n = 0; n < 500; n++) {
+    sum = sum + o.alpha + o.xray + o.mike + o.whiskey + o.golf + o.uniform;
+}
+tests.assert_eq(41500, sum);
+
+// Properties added after the index was built are found as well
+o.yankee = 100;
+o.zulu = 200;
+o.alpha = 1000;
+tests.assert_eq(100, o.yankee);
+tests.assert_eq(200, o.zulu);
+tests.assert_eq(1000, o.alpha);
+tests.assert_eq(undefined, o.nonexistent);
+
+// Narrow object: stays a plain property list
+let p = { x: 1, y: 2, z: 3 };
+sum = 0;
+for (let n = 0; n < 500; n++) {
+    sum = sum + p.x + p.y + p.z;
+}
+tests.assert_eq(3000, sum);
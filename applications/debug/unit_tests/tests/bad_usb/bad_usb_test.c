@@ -0,0 +1,627 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <storage/storage.h>
+#include <applications/main/bad_usb/helpers/bad_usb_turbo.h>
+#include <applications/main/bad_usb/helpers/ducky_script_i.h>
+
+#define TAG "BadUsbTest"
+
+#define BAD_USB_TEST_LAYOUTS_PATH EXT_PATH("badusb/assets/layouts")
+#define BAD_USB_TEST_LAYOUT_SIZE  (128)
+#define BAD_USB_TEST_DEMOS_PATH   EXT_PATH("badusb")
+#define BAD_USB_TEST_SCRIPT_PATH  EXT_PATH(".tmp/unit_tests/bad_usb.txt")
+
+static const char bad_usb_test_text[] =
+    "The quick brown fox jumps over the lazy dog.\n"
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG!\n"
+    "aaaa bb  ccc Hello, World! Mississippi AbAbAb aBcDeF 1122334455\n"
+    " !\"#$%&'()*+,-./0123456789:;<=>?@"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+    "abcdefghijklmnopqrstuvwxyz{|}~";
+
+typedef struct {
+    size_t reports;
+    size_t keys;
+} BadUsbTestStats;
+
+static char bad_usb_test_decode(const uint16_t* layout, uint16_t keycode) {
+    if(keycode == HID_KEYBOARD_RETURN) return '\n';
+    for(size_t i = ' '; i < BAD_USB_TEST_LAYOUT_SIZE; i++) {
+        if(layout[i] == keycode) return i;
+    }
+    return '\0';
+}
+
+/** Pack text into reports as turbo typing does and replay them as a host would */
+static void bad_usb_test_turbo_layout(
+    const uint16_t* layout,
+    size_t max_keys,
+    const char* name,
+    BadUsbTestStats* stats) {
+    size_t text_len = strlen(bad_usb_test_text);
+    uint16_t* keycodes = malloc(text_len * sizeof(uint16_t));
+    char* expected = malloc(text_len + 1);
+    char* typed = malloc(text_len + 1);
+
+    // Characters missing in the layout are skipped, as the script compiler does
+    size_t count = 0;
+    for(size_t i = 0; i < text_len; i++) {
+        char chr = bad_usb_test_text[i];
+        uint16_t keycode = (chr == '\n') ? HID_KEYBOARD_RETURN : layout[(uint8_t)chr];
+        if(keycode == HID_KEYBOARD_NONE) continue;
+        keycodes[count] = keycode;
+        expected[count] = chr;
+        count++;
+    }
+    expected[count] = '\0';
+
+    // Host sees new keys of a report in the order of its key array
+    size_t typed_len = 0;
+    size_t pos = 0;
+    while(pos < count) {
+        size_t packed = bad_usb_turbo_pack(&keycodes[pos], count - pos, max_keys);
+        mu_check(packed > 0);
+        mu_check(packed <= max_keys);
+        mu_check(pos + packed <= count);
+
+        for(size_t i = 0; i < packed; i++) {
+            uint16_t keycode = keycodes[pos + i];
+            mu_assert_int_eq(keycodes[pos] & 0xFF00, keycode & 0xFF00);
+            for(size_t j = 0; j < i; j++) {
+                mu_check((keycodes[pos + j] & 0xFF) != (keycode & 0xFF));
+            }
+            typed[typed_len++] = bad_usb_test_decode(layout, keycode);
+        }
+
+        pos += packed;
+        stats->reports++;
+    }
+    typed[typed_len] = '\0';
+    stats->keys += count;
+
+    if(strcmp(expected, typed) != 0) {
+        FURI_LOG_E(TAG, "%s: typed \"%s\"", name, typed);
+    }
+    mu_assert_string_eq(expected, typed);
+
+    free(typed);
+    free(expected);
+    free(keycodes);
+}
+
+MU_TEST(test_bad_usb_turbo_pack) {
+    const uint16_t keys[] = {
+        HID_KEYBOARD_A,
+        HID_KEYBOARD_B,
+        HID_KEYBOARD_A,
+        KEY_MOD_LEFT_SHIFT | HID_KEYBOARD_C,
+        KEY_MOD_LEFT_SHIFT | HID_KEYBOARD_D,
+    };
+
+    // Repeated key and modifier change both start a new report
+    mu_assert_int_eq(2, bad_usb_turbo_pack(keys, COUNT_OF(keys), HID_KB_MAX_KEYS));
+    mu_assert_int_eq(1, bad_usb_turbo_pack(&keys[2], 3, HID_KB_MAX_KEYS));
+    mu_assert_int_eq(2, bad_usb_turbo_pack(&keys[3], 2, HID_KB_MAX_KEYS));
+    // Held keys leave one slot or none
+    mu_assert_int_eq(1, bad_usb_turbo_pack(keys, COUNT_OF(keys), 1));
+    mu_assert_int_eq(0, bad_usb_turbo_pack(keys, COUNT_OF(keys), 0));
+    mu_assert_int_eq(1, bad_usb_turbo_pack(keys, 1, HID_KB_MAX_KEYS));
+}
+
+#define BAD_USB_TEST_REPORTS_MAX (64)
+
+typedef struct {
+    bool press;
+    uint8_t mods;
+    uint8_t keys[HID_KB_MAX_KEYS];
+    uint16_t first;
+    size_t count;
+} BadUsbTestReport;
+
+typedef struct {
+    BadUsbTestReport reports[BAD_USB_TEST_REPORTS_MAX];
+    size_t reports_nb;
+} BadUsbTestReports;
+
+static bool bad_usb_test_report(
+    BadUsbTestReports* reports,
+    bool press,
+    const uint16_t* buttons,
+    size_t count) {
+    bool sent = press ? furi_hal_hid_kb_press_multiple(buttons, count) :
+                        furi_hal_hid_kb_release_multiple(buttons, count);
+    if(reports->reports_nb < BAD_USB_TEST_REPORTS_MAX) {
+        BadUsbTestReport* report = &reports->reports[reports->reports_nb];
+        report->press = press;
+        report->mods = furi_hal_hid_kb_get_report(report->keys);
+        report->first = buttons[0];
+        report->count = count;
+    }
+    reports->reports_nb++;
+    return sent;
+}
+
+static bool bad_usb_test_kb_press_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    return bad_usb_test_report(inst, true, buttons, count);
+}
+
+static bool bad_usb_test_kb_release_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    return bad_usb_test_report(inst, false, buttons, count);
+}
+
+static const BadUsbHidApi bad_usb_test_hid = {
+    .kb_press_multiple = bad_usb_test_kb_press_multiple,
+    .kb_release_multiple = bad_usb_test_kb_release_multiple,
+};
+
+static bool bad_usb_test_report_has_key(const uint8_t* keys, size_t keys_nb, uint8_t key) {
+    for(size_t i = 0; i < keys_nb; i++) {
+        if(keys[i] == key) return true;
+    }
+    return false;
+}
+
+/** Type text with keys held as turbo typing does and replay the reports as a host would */
+static void bad_usb_test_turbo_held(const char* text, uint8_t held_mods, size_t held_nb) {
+    static const uint8_t held_keys[] = {
+        HID_KEYBOARD_F1,
+        HID_KEYBOARD_F2,
+        HID_KEYBOARD_F3,
+        HID_KEYBOARD_F4,
+        HID_KEYBOARD_F5,
+        HID_KEYBOARD_F6,
+    };
+
+    furi_hal_hid_kb_release_all();
+    // Held modifiers come without a key, as in HOLD CTRL-ALT
+    if(held_mods) furi_hal_hid_kb_press(held_mods << 8);
+    for(size_t i = 0; i < held_nb; i++) {
+        furi_hal_hid_kb_press(held_keys[i]);
+    }
+
+    size_t count = strlen(text);
+    uint16_t* keycodes = malloc(count * sizeof(uint16_t));
+    for(size_t i = 0; i < count; i++) {
+        keycodes[i] = hid_asciimap[(uint8_t)text[i]];
+    }
+
+    BadUsbTestReports* reports = malloc(sizeof(BadUsbTestReports));
+    reports->reports_nb = 0;
+    bool typed = bad_usb_turbo_type(&bad_usb_test_hid, reports, keycodes, count, held_nb, 0);
+    furi_hal_hid_kb_release_all();
+    free(keycodes);
+
+    char* typed_text = malloc(count + 1);
+    size_t typed_len = 0;
+    bool reports_ok = reports->reports_nb <= BAD_USB_TEST_REPORTS_MAX;
+    for(size_t i = 0; reports_ok && (i < reports->reports_nb); i++) {
+        const BadUsbTestReport* report = &reports->reports[i];
+        // Press and release alternate
+        if(report->press != ((i % 2) == 0)) reports_ok = false;
+
+        // Modifiers of the run are added to the held ones and dropped on release
+        uint8_t mods = held_mods | (report->press ? (report->first >> 8) : 0);
+        if(report->mods != mods) reports_ok = false;
+
+        // Held keys stay in every report, new keys come in slot order
+        size_t key_nb = 0;
+        for(size_t slot = 0; slot < HID_KB_MAX_KEYS; slot++) {
+            uint8_t key = report->keys[slot];
+            if(key == 0) continue;
+            key_nb++;
+            if(bad_usb_test_report_has_key(held_keys, held_nb, key)) continue;
+            if(!report->press || (typed_len == count)) {
+                reports_ok = false;
+                continue;
+            }
+            typed_text[typed_len++] =
+                bad_usb_test_decode(hid_asciimap, (report->first & 0xFF00) | key);
+        }
+        if(key_nb != held_nb + (report->press ? report->count : 0)) reports_ok = false;
+    }
+    typed_text[typed_len] = '\0';
+
+    if(held_nb < HID_KB_MAX_KEYS) {
+        mu_check(typed);
+        mu_check(reports_ok);
+        mu_assert_string_eq(text, typed_text);
+        mu_check(reports->reports_nb <= count * 2);
+        // One free slot leaves one key per report
+        if(held_nb == HID_KB_MAX_KEYS - 1) mu_assert_int_eq(count * 2, reports->reports_nb);
+    } else {
+        // Nothing is dropped silently when held keys take every slot
+        mu_check(!typed);
+        mu_assert_int_eq(0, reports->reports_nb);
+    }
+
+    free(typed_text);
+    free(reports);
+}
+
+MU_TEST(test_bad_usb_turbo_reports) {
+    const char* text = "Hello, World! aBcD xyz ZZ";
+    mu_check(strlen(text) * 2 <= BAD_USB_TEST_REPORTS_MAX);
+    bad_usb_test_turbo_held(text, 0, 0);
+    bad_usb_test_turbo_held(text, KEY_MOD_LEFT_CTRL | KEY_MOD_LEFT_ALT, 2);
+    bad_usb_test_turbo_held(text, KEY_MOD_LEFT_GUI, HID_KB_MAX_KEYS - 1);
+    bad_usb_test_turbo_held(text, 0, HID_KB_MAX_KEYS);
+}
+
+MU_TEST(test_bad_usb_turbo_layouts) {
+    BadUsbTestStats stats = {};
+
+    uint16_t* layout = malloc(BAD_USB_TEST_LAYOUT_SIZE * sizeof(uint16_t));
+    memcpy(
+        layout,
+        hid_asciimap,
+        MIN(sizeof(hid_asciimap), BAD_USB_TEST_LAYOUT_SIZE * sizeof(uint16_t)));
+    bad_usb_test_turbo_layout(layout, HID_KB_MAX_KEYS, "default", &stats);
+    // Two held keys leave four slots
+    bad_usb_test_turbo_layout(layout, HID_KB_MAX_KEYS - 2, "default", &stats);
+    size_t layouts = 1;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    char name[64];
+
+    if(storage_dir_open(dir, BAD_USB_TEST_LAYOUTS_PATH)) {
+        FileInfo info;
+        while(storage_dir_read(dir, &info, name, sizeof(name))) {
+            if(file_info_is_dir(&info)) continue;
+            furi_string_printf(path, "%s/%s", BAD_USB_TEST_LAYOUTS_PATH, name);
+            if(!furi_string_end_with(path, ".kl")) continue;
+
+            mu_check(storage_file_open(
+                file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING));
+            size_t size = BAD_USB_TEST_LAYOUT_SIZE * sizeof(uint16_t);
+            mu_assert_int_eq(size, storage_file_read(file, layout, size));
+            storage_file_close(file);
+
+            bad_usb_test_turbo_layout(layout, HID_KB_MAX_KEYS, name, &stats);
+            layouts++;
+        }
+    }
+    storage_dir_close(dir);
+
+    // Both modes send a press and a release report, per key or per packed report
+    FURI_LOG_I(
+        TAG, "%zu layouts: %zu reports instead of %zu", layouts, stats.reports, stats.keys);
+
+    furi_string_free(path);
+    storage_file_free(file);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+    free(layout);
+}
+
+typedef struct {
+    BadUsbScript* bad_usb;
+    Storage* storage;
+    File* file;
+    size_t segments;
+    size_t segments_repeat; // Segments starting with REPEAT of the previous one's last line
+} BadUsbTestCompiler;
+
+static BadUsbTestCompiler* bad_usb_test_compiler_alloc(void) {
+    BadUsbTestCompiler* compiler = malloc(sizeof(BadUsbTestCompiler));
+    compiler->bad_usb = malloc(sizeof(BadUsbScript));
+    memset(compiler->bad_usb, 0, sizeof(BadUsbScript));
+    memset(compiler->bad_usb->layout, HID_KEYBOARD_NONE, sizeof(compiler->bad_usb->layout));
+    memcpy(
+        compiler->bad_usb->layout,
+        hid_asciimap,
+        MIN(sizeof(hid_asciimap), sizeof(compiler->bad_usb->layout)));
+    compiler->bad_usb->line = furi_string_alloc();
+    compiler->storage = furi_record_open(RECORD_STORAGE);
+    compiler->file = storage_file_alloc(compiler->storage);
+    return compiler;
+}
+
+static void bad_usb_test_compiler_free(BadUsbTestCompiler* compiler) {
+    storage_file_free(compiler->file);
+    storage_common_remove(compiler->storage, BAD_USB_TEST_SCRIPT_PATH);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(compiler->bad_usb->line);
+    free(compiler->bad_usb->program);
+    free(compiler->bad_usb);
+    free(compiler);
+}
+
+static bool bad_usb_test_compile(BadUsbTestCompiler* compiler, const char* path) {
+    storage_file_close(compiler->file);
+    if(!storage_file_open(compiler->file, path, FSAM_READ, FSOM_OPEN_EXISTING)) return false;
+
+    compiler->bad_usb->repeat_cnt = 0;
+    compiler->segments = 1;
+    compiler->segments_repeat = 0;
+    return ducky_script_compile_start(compiler->bad_usb, compiler->file);
+}
+
+static bool bad_usb_test_compile_text(BadUsbTestCompiler* compiler, const char* text) {
+    storage_file_close(compiler->file);
+    if(!storage_file_open(
+           compiler->file, BAD_USB_TEST_SCRIPT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        return false;
+    }
+    size_t size = strlen(text);
+    bool written = storage_file_write(compiler->file, text, size) == size;
+    storage_file_close(compiler->file);
+
+    return written && bad_usb_test_compile(compiler, BAD_USB_TEST_SCRIPT_PATH);
+}
+
+/** Next instruction to execute, stepping through segments and REPEAT as the worker does */
+static const DuckyInstruction* bad_usb_test_compiler_next(BadUsbTestCompiler* compiler) {
+    BadUsbScript* bad_usb = compiler->bad_usb;
+
+    if((bad_usb->repeat_cnt > 0) && (bad_usb->program_prev != SIZE_MAX)) {
+        bad_usb->repeat_cnt--;
+        return (const DuckyInstruction*)&bad_usb->program[bad_usb->program_prev];
+    }
+    bad_usb->repeat_cnt = 0;
+
+    if(bad_usb->program_pos >= bad_usb->program_size) {
+        if(bad_usb->compiler_end) return NULL;
+        if(ducky_script_compile_next(bad_usb, compiler->file) != 0) return NULL;
+        if(bad_usb->program_pos >= bad_usb->program_size) return NULL;
+
+        compiler->segments++;
+        const DuckyInstruction* first =
+            (const DuckyInstruction*)&bad_usb->program[bad_usb->program_pos];
+        if(first->op == DuckyOpRepeat) compiler->segments_repeat++;
+    }
+
+    const DuckyInstruction* instruction =
+        (const DuckyInstruction*)&bad_usb->program[bad_usb->program_pos];
+    if(instruction->op == DuckyOpRepeat) {
+        bad_usb->repeat_cnt = instruction->param;
+    } else {
+        bad_usb->program_prev = bad_usb->program_pos;
+    }
+    bad_usb->program_pos += ducky_instruction_size(instruction);
+    return instruction;
+}
+
+static bool bad_usb_test_string_is(
+    BadUsbScript* bad_usb,
+    const DuckyInstruction* instruction,
+    const char* text) {
+    size_t len = strlen(text);
+    if((instruction->op != DuckyOpString) || (instruction->param != len)) return false;
+
+    const uint16_t* keycodes = (const uint16_t*)&instruction[1];
+    for(size_t i = 0; i < len; i++) {
+        if(keycodes[i] != ducky_get_char_keycode(bad_usb, text[i])) return false;
+    }
+    return true;
+}
+
+MU_TEST(test_bad_usb_compile_demos) {
+    BadUsbTestCompiler* compiler = bad_usb_test_compiler_alloc();
+    BadUsbScript* bad_usb = compiler->bad_usb;
+    File* dir = storage_file_alloc(compiler->storage);
+    FuriString* path = furi_string_alloc();
+    char name[64];
+    size_t demos = 0;
+
+    if(storage_dir_open(dir, BAD_USB_TEST_DEMOS_PATH)) {
+        FileInfo info;
+        while(storage_dir_read(dir, &info, name, sizeof(name))) {
+            if(file_info_is_dir(&info) || (strncmp(name, "demo_", 5) != 0)) continue;
+            furi_string_printf(path, "%s/%s", BAD_USB_TEST_DEMOS_PATH, name);
+
+            bool compiled = bad_usb_test_compile(compiler, furi_string_get_cstr(path));
+            if(!compiled) {
+                FURI_LOG_E(TAG, "%s:%lu: %s", name, bad_usb->st.error_line, bad_usb->st.error);
+            }
+            mu_check(compiled);
+            mu_check(bad_usb->program_size > 0);
+
+            size_t count = 0;
+            uint32_t line = 0;
+            uint32_t repeat_line = 0;
+            size_t held = 0;
+            while(true) {
+                bool repeated = bad_usb->repeat_cnt > 0;
+                const DuckyInstruction* instruction = bad_usb_test_compiler_next(compiler);
+                if(!instruction) break;
+                count++;
+
+                // Lines go forward, REPEAT runs the last line before it again
+                if(repeated) {
+                    mu_assert_int_eq(repeat_line, instruction->line);
+                } else {
+                    mu_check(instruction->line > line);
+                    line = instruction->line;
+                    if(instruction->op != DuckyOpRepeat) repeat_line = line;
+                }
+
+                if(instruction->op == DuckyOpString) {
+                    const uint16_t* keycodes = (const uint16_t*)&instruction[1];
+                    for(size_t i = 0; i < instruction->param; i++) {
+                        mu_check(keycodes[i] != HID_KEYBOARD_NONE);
+                    }
+                } else if(instruction->op == DuckyOpHold) {
+                    held++;
+                    mu_check(held < HID_KB_MAX_KEYS);
+                } else if(instruction->op == DuckyOpRelease) {
+                    mu_check(held > 0);
+                    held--;
+                }
+            }
+            mu_assert_string_eq("", bad_usb->st.error);
+            mu_check(bad_usb->compiler_end);
+
+            FURI_LOG_I(TAG, "%s: %zu instructions, %zu segments", name, count, compiler->segments);
+            demos++;
+        }
+    }
+    storage_dir_close(dir);
+    mu_check(demos > 0);
+
+    furi_string_free(path);
+    storage_file_free(dir);
+    bad_usb_test_compiler_free(compiler);
+}
+
+typedef struct {
+    DuckyOp op;
+    uint32_t line;
+    uint32_t param;
+    const char* text; // Typed by a string
+} BadUsbTestStep;
+
+MU_TEST(test_bad_usb_compile_steps) {
+    // Blank lines are not counted, as in the progress shown on screen
+    const char* script = "REM Steps\n"
+                         "\n"
+                         "STRING Ab\n"
+                         "STRINGLN c\r\n"
+                         "REPEAT 2\n"
+                         "HOLD CTRL\n"
+                         "HOLD a\n"
+                         "RELEASE a\n"
+                         "RELEASE CTRL\n"
+                         "ENTER\n"
+                         "GUI r\n"
+                         "DELAY 100\n"
+                         "  \n"
+                         "TURBO ON";
+    const BadUsbTestStep steps[] = {
+        {DuckyOpNop, 1, 0, NULL},
+        {DuckyOpString, 2, 2, "Ab"},
+        {DuckyOpString, 3, 2, "c\n"},
+        {DuckyOpRepeat, 4, 2, NULL},
+        {DuckyOpString, 3, 2, "c\n"},
+        {DuckyOpString, 3, 2, "c\n"},
+        {DuckyOpHold, 5, KEY_MOD_LEFT_CTRL, NULL},
+        {DuckyOpHold, 6, HID_KEYBOARD_A, NULL},
+        {DuckyOpRelease, 7, HID_KEYBOARD_A, NULL},
+        {DuckyOpRelease, 8, KEY_MOD_LEFT_CTRL, NULL},
+        {DuckyOpKey, 9, HID_KEYBOARD_RETURN, NULL},
+        {DuckyOpKey, 10, KEY_MOD_LEFT_GUI | HID_KEYBOARD_R, NULL},
+        {DuckyOpDelay, 11, 100, NULL},
+        {DuckyOpEmpty, 12, 0, NULL},
+        {DuckyOpTurbo, 13, DuckyTurboOn, NULL},
+    };
+
+    BadUsbTestCompiler* compiler = bad_usb_test_compiler_alloc();
+    mu_check(bad_usb_test_compile_text(compiler, script));
+    mu_check(compiler->bad_usb->compiler_end);
+
+    size_t count = 0;
+    const DuckyInstruction* instruction;
+    while((instruction = bad_usb_test_compiler_next(compiler)) != NULL) {
+        mu_check(count < COUNT_OF(steps));
+        const BadUsbTestStep* step = &steps[count++];
+        mu_assert_int_eq(step->op, instruction->op);
+        mu_assert_int_eq(step->line, instruction->line);
+        mu_assert_int_eq(step->param, instruction->param);
+        if(step->text) {
+            mu_check(bad_usb_test_string_is(compiler->bad_usb, instruction, step->text));
+        }
+    }
+    mu_assert_int_eq(COUNT_OF(steps), count);
+
+    bad_usb_test_compiler_free(compiler);
+}
+
+typedef struct {
+    const char* script;
+    uint32_t line;
+    const char* error;
+} BadUsbTestError;
+
+MU_TEST(test_bad_usb_compile_errors) {
+    const BadUsbTestError errors[] = {
+        {"STRING a\nRELEASE a\n", 2, "No keys are hold"},
+        {"HOLD a\nREPEAT 5\n", 2, "Too many keys are hold"},
+        // REPEAT of HOLD and RELEASE counts as the lines written out
+        {"HOLD a\nREPEAT 4\nRELEASE a\nREPEAT 4\nRELEASE a\n", 5, "No keys are hold"},
+        {"STRING a\n\nFOO bar\n", 2, "No keycode defined for FOO bar"},
+        {"DELAY 100\nDELAY x", 2, "Invalid number x"},
+        {"REPEAT 0", 1, "Invalid number 0"},
+        {"TURBO FAST", 1, "Invalid turbo mode FAST"},
+    };
+
+    BadUsbTestCompiler* compiler = bad_usb_test_compiler_alloc();
+    for(size_t i = 0; i < COUNT_OF(errors); i++) {
+        mu_check(!bad_usb_test_compile_text(compiler, errors[i].script));
+        mu_assert_int_eq(errors[i].line, compiler->bad_usb->st.error_line);
+        mu_assert_string_eq(errors[i].error, compiler->bad_usb->st.error);
+    }
+    bad_usb_test_compiler_free(compiler);
+}
+
+#define BAD_USB_TEST_SEGMENT_LINES (200)
+
+MU_TEST(test_bad_usb_compile_segments) {
+    // Every string is repeated, so some segment starts with REPEAT of the previous one's line
+    FuriString* script = furi_string_alloc();
+    for(size_t i = 0; i < BAD_USB_TEST_SEGMENT_LINES; i++) {
+        furi_string_cat_printf(script, "STRING %04zu abcdefghij\nREPEAT 1\n", i);
+    }
+
+    BadUsbTestCompiler* compiler = bad_usb_test_compiler_alloc();
+    BadUsbScript* bad_usb = compiler->bad_usb;
+    mu_check(bad_usb_test_compile_text(compiler, furi_string_get_cstr(script)));
+    mu_check(!bad_usb->compiler_end);
+    mu_check(bad_usb->program_size >= DUCKY_PROGRAM_SEGMENT_SIZE);
+
+    FuriString* text = furi_string_alloc();
+    size_t strings = 0;
+    size_t repeats = 0;
+    const DuckyInstruction* instruction;
+    while((instruction = bad_usb_test_compiler_next(compiler)) != NULL) {
+        if(instruction->op == DuckyOpRepeat) {
+            mu_assert_int_eq(strings + 1, instruction->line);
+            mu_assert_int_eq(1, instruction->param);
+            repeats++;
+            continue;
+        }
+
+        // Each string runs twice, from its own line
+        size_t index = strings / 2;
+        mu_assert_int_eq(index * 2 + 1, instruction->line);
+        furi_string_printf(text, "%04zu abcdefghij", index);
+        mu_check(bad_usb_test_string_is(bad_usb, instruction, furi_string_get_cstr(text)));
+        strings++;
+    }
+    mu_assert_string_eq("", bad_usb->st.error);
+    mu_assert_int_eq(BAD_USB_TEST_SEGMENT_LINES * 2, strings);
+    mu_assert_int_eq(BAD_USB_TEST_SEGMENT_LINES, repeats);
+    mu_check(compiler->segments > 2);
+    mu_check(compiler->segments_repeat > 0);
+
+    // Errors after the first segment are found before the script runs
+    furi_string_cat_str(script, "RELEASE a\n");
+    mu_check(!bad_usb_test_compile_text(compiler, furi_string_get_cstr(script)));
+    mu_assert_int_eq(BAD_USB_TEST_SEGMENT_LINES * 2 + 1, bad_usb->st.error_line);
+    mu_assert_string_eq("No keys are hold", bad_usb->st.error);
+
+    furi_string_free(text);
+    furi_string_free(script);
+    bad_usb_test_compiler_free(compiler);
+}
+
+MU_TEST_SUITE(test_bad_usb_suite) {
+    MU_RUN_TEST(test_bad_usb_turbo_pack);
+    MU_RUN_TEST(test_bad_usb_turbo_reports);
+    MU_RUN_TEST(test_bad_usb_turbo_layouts);
+    MU_RUN_TEST(test_bad_usb_compile_demos);
+    MU_RUN_TEST(test_bad_usb_compile_steps);
+    MU_RUN_TEST(test_bad_usb_compile_errors);
+    MU_RUN_TEST(test_bad_usb_compile_segments);
+}
+
+int run_minunit_test_bad_usb(void) {
+    MU_RUN_SUITE(test_bad_usb_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_bad_usb)
@@ -0,0 +1,5 @@
+// Plugins can't link app sources, so the script compiler is built into the test from here
+#include <applications/main/bad_usb/helpers/ducky_script_compiler.c>
+#include <applications/main/bad_usb/helpers/ducky_script_commands.c>
+#include <applications/main/bad_usb/helpers/ducky_script_keycodes.c>
+#include <applications/main/bad_usb/helpers/ducky_script_hash.c>
@@ -0,0 +1,148 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/crc.h>
+#include <toolbox/crc32_calc.h>
+
+#define TAG "CrcTest"
+
+#define CRC_TEST_BENCH_SIZE       (4096)
+#define CRC_TEST_BENCH_ITERATIONS (64)
+
+static const char crc_test_check_data[] = "123456789";
+
+// Bitwise references, as the CRCs were calculated before the tables
+static uint16_t crc_test_crc16_lsb_bitwise(uint16_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc_test_crc16_msb_bitwise(uint16_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc_test_crc32_bitwise(uint32_t crc, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for(size_t j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+MU_TEST(test_crc_check_values) {
+    const size_t size = strlen(crc_test_check_data);
+
+    // CRC-16/ISO-IEC-14443-3-A
+    mu_assert_int_eq(0xBF05, crc16_lsb_update(0x6363, crc_test_check_data, size));
+    // CRC-16/IBM-SDLC, ISO14443-3B and ISO13239
+    mu_assert_int_eq(0x906E, (uint16_t)~crc16_lsb_update(0xFFFF, crc_test_check_data, size));
+    // CRC-16/XMODEM, FeliCa before byte swap
+    mu_assert_int_eq(0x31C3, crc16_msb_update(0x0000, crc_test_check_data, size));
+    // CRC-32/ISO-HDLC
+    mu_assert_int_eq(0xCBF43926, ~crc32_update(0xFFFFFFFF, crc_test_check_data, size));
+    mu_assert_int_eq(0xCBF43926, crc32_calc_buffer(0, crc_test_check_data, size));
+}
+
+MU_TEST(test_crc_reference) {
+    uint8_t* data = malloc(CRC_TEST_BENCH_SIZE);
+    furi_hal_random_fill_buf(data, CRC_TEST_BENCH_SIZE);
+
+    for(size_t i = 0; i < 256; i++) {
+        // Unaligned starts and odd sizes take the byte-wise paths
+        size_t offset = furi_hal_random_get() % 8;
+        size_t size = furi_hal_random_get() % (CRC_TEST_BENCH_SIZE - offset);
+        uint32_t init = furi_hal_random_get();
+
+        mu_assert_int_eq(
+            crc_test_crc16_lsb_bitwise(init, data + offset, size),
+            crc16_lsb_update(init, data + offset, size));
+        mu_assert_int_eq(
+            crc_test_crc16_msb_bitwise(init, data + offset, size),
+            crc16_msb_update(init, data + offset, size));
+        mu_assert_int_eq(
+            crc_test_crc32_bitwise(init, data + offset, size),
+            crc32_update(init, data + offset, size));
+
+        // Processing in chunks gives the same result
+        size_t split = size ? furi_hal_random_get() % size : 0;
+        uint32_t crc = crc32_update(init, data + offset, split);
+        crc = crc32_update(crc, data + offset + split, size - split);
+        mu_assert_int_eq(crc32_update(init, data + offset, size), crc);
+    }
+
+    free(data);
+}
+
+MU_TEST(test_crc_benchmark) {
+    uint8_t* data = malloc(CRC_TEST_BENCH_SIZE);
+    furi_hal_random_fill_buf(data, CRC_TEST_BENCH_SIZE);
+
+    const uint32_t bytes = CRC_TEST_BENCH_SIZE * CRC_TEST_BENCH_ITERATIONS;
+    volatile uint32_t crc = 0;
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ITERATIONS; i++) {
+        crc = crc16_lsb_update(crc, data, CRC_TEST_BENCH_SIZE);
+    }
+    uint32_t crc16_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ITERATIONS; i++) {
+        crc = crc_test_crc16_lsb_bitwise(crc, data, CRC_TEST_BENCH_SIZE);
+    }
+    uint32_t crc16_bitwise_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ITERATIONS; i++) {
+        crc = crc32_update(crc, data, CRC_TEST_BENCH_SIZE);
+    }
+    uint32_t crc32_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRC_TEST_BENCH_ITERATIONS; i++) {
+        crc = crc_test_crc32_bitwise(crc, data, CRC_TEST_BENCH_SIZE);
+    }
+    uint32_t crc32_bitwise_time = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "%lu bytes: crc16 %lums (bitwise %lums), crc32 %lums (bitwise %lums)",
+        bytes,
+        crc16_time,
+        crc16_bitwise_time,
+        crc32_time,
+        crc32_bitwise_time);
+
+    mu_assert(crc16_time < crc16_bitwise_time, "Table CRC-16 is slower than bitwise");
+    mu_assert(crc32_time < crc32_bitwise_time, "Table CRC-32 is slower than bitwise");
+
+    free(data);
+}
+
+MU_TEST_SUITE(test_crc_suite) {
+    MU_RUN_TEST(test_crc_check_values);
+    MU_RUN_TEST(test_crc_reference);
+    MU_RUN_TEST(test_crc_benchmark);
+}
+
+int run_minunit_test_crc(void) {
+    MU_RUN_SUITE(test_crc_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_crc)
@@ -0,0 +1,247 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <storage/storage.h>
+#include <flipper_application/flipper_application.h>
+#include <flipper_application/elf/elf.h>
+#include <loader/firmware_api/firmware_api.h>
+
+#define TAG "FlipperApplicationTest"
+
+#define FLIPPER_APPLICATION_TEST_PLUGINS_PATH  "/ext/apps_data/unit_tests/plugins"
+#define FLIPPER_APPLICATION_TEST_SLOW_REL_PATH EXT_PATH(".tmp/unit_tests/test_varint_rel.fal")
+#define FLIPPER_APPLICATION_TEST_ITERATIONS    (3)
+
+// Test plugins that only import firmware API, from small to large
+static const char* const flipper_application_test_samples[] = {
+    "test_varint.fal",
+    "test_crc.fal",
+    "test_stream.fal",
+    "test_lfrfid.fal",
+    "test_infrared.fal",
+};
+
+// Every table entry and relocation read on its own, as before the read windows
+static const FlipperApplicationReadWindows flipper_application_test_direct_reads = {
+    .relocations = 1,
+};
+
+/** Copy a plugin with its fast relocation sections renamed, so that it is relocated from .rel */
+static bool flipper_application_test_drop_fast_rel(
+    Storage* storage,
+    const char* src,
+    const char* dst) {
+    storage_common_remove(storage, dst);
+    if(storage_common_copy(storage, src, dst) != FSE_OK) return false;
+
+    File* file = storage_file_alloc(storage);
+    char* names = NULL;
+    bool renamed = false;
+
+    do {
+        Elf32_Ehdr header;
+        Elf32_Shdr names_header;
+        if(!storage_file_open(file, dst, FSAM_READ_WRITE, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        off_t names_header_offset = header.e_shoff + header.e_shstrndx * sizeof(Elf32_Shdr);
+        if(!storage_file_seek(file, names_header_offset, true)) break;
+        if(storage_file_read(file, &names_header, sizeof(names_header)) != sizeof(names_header)) {
+            break;
+        }
+
+        size_t size = names_header.sh_size;
+        names = malloc(size);
+        if(!storage_file_seek(file, names_header.sh_offset, true)) break;
+        if(storage_file_read(file, names, size) != size) break;
+
+        // ".fast.rel.text" becomes "._ast.rel.text", a ".rel.text" sharing its tail stays
+        const char prefix[] = ".fast.rel";
+        for(size_t i = 0; i + strlen(prefix) <= size; i++) {
+            if(memcmp(&names[i], prefix, strlen(prefix)) == 0) {
+                names[i + 1] = '_';
+                renamed = true;
+            }
+        }
+
+        renamed = renamed && storage_file_seek(file, names_header.sh_offset, true) &&
+                  storage_file_write(file, names, size) == size;
+    } while(false);
+
+    free(names);
+    storage_file_free(file);
+    return renamed;
+}
+
+/** Preload and map a plugin a few times, add up the averages */
+static void flipper_application_test_benchmark_sample(
+    Storage* storage,
+    const char* path,
+    const FlipperApplicationReadWindows* windows,
+    uint32_t* time,
+    FlipperApplicationLoadTimings* timings) {
+    FlipperApplicationLoadTimings total_timings = {};
+    uint32_t total_time = 0;
+
+    for(size_t i = 0; i < FLIPPER_APPLICATION_TEST_ITERATIONS; i++) {
+        FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
+        if(windows) flipper_application_set_read_windows(app, windows);
+
+        uint32_t start = furi_get_tick();
+        mu_assert_int_eq(
+            FlipperApplicationPreloadStatusSuccess, flipper_application_preload(app, path));
+        mu_assert_int_eq(
+            FlipperApplicationLoadStatusSuccess, flipper_application_map_to_memory(app));
+        total_time += furi_get_tick() - start;
+
+        FlipperApplicationLoadTimings app_timings;
+        flipper_application_get_load_timings(app, &app_timings);
+        mu_check(app_timings.read_us > 0);
+        total_timings.read_us += app_timings.read_us;
+        total_timings.resolve_us += app_timings.resolve_us;
+        total_timings.relocate_us += app_timings.relocate_us;
+
+        flipper_application_free(app);
+    }
+
+    *time += total_time / FLIPPER_APPLICATION_TEST_ITERATIONS;
+    timings->read_us += total_timings.read_us / FLIPPER_APPLICATION_TEST_ITERATIONS;
+    timings->resolve_us += total_timings.resolve_us / FLIPPER_APPLICATION_TEST_ITERATIONS;
+    timings->relocate_us += total_timings.relocate_us / FLIPPER_APPLICATION_TEST_ITERATIONS;
+}
+
+MU_TEST(test_flipper_application_load_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+
+    uint32_t total_time = 0;
+    uint32_t total_direct_time = 0;
+    uint32_t total_read_us = 0;
+    uint32_t total_direct_read_us = 0;
+
+    // Samples are fast relocated, the copy without fast relocations goes through elf_relocate
+    mu_check(flipper_application_test_drop_fast_rel(
+        storage,
+        FLIPPER_APPLICATION_TEST_PLUGINS_PATH "/test_varint.fal",
+        FLIPPER_APPLICATION_TEST_SLOW_REL_PATH));
+
+    for(size_t i = 0; i <= COUNT_OF(flipper_application_test_samples); i++) {
+        if(i < COUNT_OF(flipper_application_test_samples)) {
+            furi_string_printf(
+                path,
+                "%s/%s",
+                FLIPPER_APPLICATION_TEST_PLUGINS_PATH,
+                flipper_application_test_samples[i]);
+        } else {
+            furi_string_set(path, FLIPPER_APPLICATION_TEST_SLOW_REL_PATH);
+        }
+
+        uint32_t time = 0;
+        uint32_t direct_time = 0;
+        FlipperApplicationLoadTimings timings = {};
+        FlipperApplicationLoadTimings direct_timings = {};
+        flipper_application_test_benchmark_sample(
+            storage, furi_string_get_cstr(path), NULL, &time, &timings);
+        flipper_application_test_benchmark_sample(
+            storage,
+            furi_string_get_cstr(path),
+            &flipper_application_test_direct_reads,
+            &direct_time,
+            &direct_timings);
+
+        FURI_LOG_I(
+            TAG,
+            "%s: load %lums (direct %lums), read %luus (direct %luus), resolve %luus, "
+            "relocate %luus",
+            furi_string_get_cstr(path),
+            time,
+            direct_time,
+            timings.read_us,
+            direct_timings.read_us,
+            timings.resolve_us,
+            timings.relocate_us);
+
+        total_time += time;
+        total_direct_time += direct_time;
+        total_read_us += timings.read_us;
+        total_direct_read_us += direct_timings.read_us;
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Total %lums, direct reads %lums, read %luus, direct reads %luus",
+        total_time,
+        total_direct_time,
+        total_read_us,
+        total_direct_read_us);
+    // Fewer storage requests, windows must not read slower than entry by entry
+    mu_check(total_read_us < total_direct_read_us);
+
+    storage_common_remove(storage, FLIPPER_APPLICATION_TEST_SLOW_REL_PATH);
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+/** Map a plugin through the given windows and run its test suite */
+static void flipper_application_test_run_plugin(
+    Storage* storage,
+    const char* path,
+    const FlipperApplicationReadWindows* windows) {
+    FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
+    flipper_application_set_read_windows(app, windows);
+
+    mu_assert_int_eq(
+        FlipperApplicationPreloadStatusSuccess, flipper_application_preload(app, path));
+    mu_assert_int_eq(FlipperApplicationLoadStatusSuccess, flipper_application_map_to_memory(app));
+
+    const FlipperAppPluginDescriptor* descriptor = flipper_application_plugin_get_descriptor(app);
+    mu_check(descriptor);
+    mu_assert_string_eq(APPID, descriptor->appid);
+
+    // Suite of the plugin only passes if all of its relocations are right
+    const TestApi* api = descriptor->entry_point;
+    mu_assert_int_eq(0, api->run());
+    mu_check(api->get_minunit_run() > 0);
+
+    flipper_application_free(app);
+}
+
+MU_TEST(test_flipper_application_read_windows) {
+    // Name windows shorter than most names cut them at the window end or can't hold them at all,
+    // table windows are a few entries and not a multiple of the entry size, so entries straddle
+    // the window end. String tables are left on storage, so that every name goes through them.
+    const FlipperApplicationReadWindows windows[] = {
+        {sizeof(Elf32_Shdr) * 2 + 4, 8, sizeof(Elf32_Sym) * 2 + 4, 8, 1, false},
+        {sizeof(Elf32_Shdr) * 3 + 8, 16, sizeof(Elf32_Sym) * 3 + 8, 16, 7, false},
+        {sizeof(Elf32_Shdr) * 5 + 1, 24, sizeof(Elf32_Sym) * 5 + 1, 24, 64, false},
+        {sizeof(Elf32_Shdr) * 8 + 12, 40, sizeof(Elf32_Sym) * 8 + 12, 40, 13, false},
+        {sizeof(Elf32_Shdr) - 1, 1, sizeof(Elf32_Sym) - 1, 1, 3, false},
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(flipper_application_test_drop_fast_rel(
+        storage,
+        FLIPPER_APPLICATION_TEST_PLUGINS_PATH "/test_varint.fal",
+        FLIPPER_APPLICATION_TEST_SLOW_REL_PATH));
+
+    for(size_t i = 0; i < COUNT_OF(windows); i++) {
+        flipper_application_test_run_plugin(
+            storage, FLIPPER_APPLICATION_TEST_SLOW_REL_PATH, &windows[i]);
+    }
+
+    storage_common_remove(storage, FLIPPER_APPLICATION_TEST_SLOW_REL_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_flipper_application_suite) {
+    MU_RUN_TEST(test_flipper_application_load_benchmark);
+    MU_RUN_TEST(test_flipper_application_read_windows);
+}
+
+int run_minunit_test_flipper_application(void) {
+    MU_RUN_SUITE(test_flipper_application_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_flipper_application)
@@ -1,12 +1,17 @@
 #include <furi.h>
 #include <flipper_format.h>
 #include <infrared.h>
+#include <infrared_raw_pack.h>
+#include <infrared_worker.h>
 #include <common/infrared_common_i.h>
 #include "../test.h" // IWYU pragma: keep
 
 #define IR_TEST_FILES_DIR   EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
+#define IR_TEST_PACK_FILE   IR_TEST_FILES_DIR "pack_round_trip.ir"
+
+#define TAG "InfraredTest"
 
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
@@ -523,6 +528,243 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolPioneer, 1);
 }
 
+static const struct {
+    InfraredProtocol protocol;
+    uint32_t test_count;
+} infrared_test_decoder_vectors[] = {
+    {InfraredProtocolNEC, 3},
+    {InfraredProtocolNECext, 1},
+    {InfraredProtocolSamsung32, 1},
+    {InfraredProtocolRC6, 2},
+    {InfraredProtocolRC5, 7},
+    {InfraredProtocolSIRC, 5},
+    {InfraredProtocolKaseikyo, 6},
+    {InfraredProtocolRCA, 6},
+    {InfraredProtocolPioneer, 11},
+};
+
+MU_TEST(infrared_test_decoder_bank_stats) {
+    infrared_reset_decoder(test->decoder_handler);
+    infrared_reset_decoder_stats(test->decoder_handler);
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < COUNT_OF(infrared_test_decoder_vectors); ++i) {
+        for(uint32_t j = 1; j <= infrared_test_decoder_vectors[i].test_count; ++j) {
+            infrared_test_run_decoder(infrared_test_decoder_vectors[i].protocol, j);
+        }
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+
+    uint32_t timings_total = 0;
+    uint32_t fed_total = 0;
+    uint32_t skipped_total = 0;
+
+    for(size_t i = 0; i < infrared_get_decoder_count(); ++i) {
+        InfraredDecoderStats stats;
+        infrared_get_decoder_stats(test->decoder_handler, i, &stats);
+        mu_check(infrared_is_protocol_valid(stats.protocol));
+
+        FURI_LOG_I(
+            TAG,
+            "%-10s fed %6lu skipped %6lu rejected %4lu decoded %4lu",
+            infrared_get_protocol_name(stats.protocol),
+            stats.fed,
+            stats.skipped,
+            stats.rejected,
+            stats.decoded);
+
+        /* every decoder sees every timing, either fed or skipped */
+        if(i == 0) timings_total = stats.fed + stats.skipped;
+        mu_assert_int_eq(timings_total, stats.fed + stats.skipped);
+        mu_check(stats.decoded > 0);
+
+        fed_total += stats.fed;
+        skipped_total += stats.skipped;
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%lu timings, %lu decoder calls, %lu skipped, %lums",
+        timings_total,
+        fed_total,
+        skipped_total,
+        elapsed);
+    mu_check(skipped_total > 0);
+}
+
+static size_t infrared_test_decimal_length(const uint32_t* timings, uint32_t timings_count) {
+    size_t length = 0;
+    for(uint32_t i = 0; i < timings_count; ++i) {
+        /* value and separating space, as written by flipper_format_write_uint32 */
+        length += snprintf(NULL, 0, "%lu", timings[i]) + 1;
+    }
+    return length;
+}
+
+MU_TEST(infrared_test_raw_pack) {
+    FuriString* buf = furi_string_alloc();
+    size_t decimal_total = 0;
+    size_t packed_total = 0;
+    uint32_t signal_count = 0;
+
+    for(size_t i = 0; i < COUNT_OF(infrared_test_decoder_vectors); ++i) {
+        const char* protocol_name =
+            infrared_get_protocol_name(infrared_test_decoder_vectors[i].protocol);
+
+        for(uint32_t j = 1; j <= infrared_test_decoder_vectors[i].test_count; ++j) {
+            uint32_t* timings;
+            uint32_t timings_count;
+
+            mu_assert(infrared_test_prepare_file(protocol_name), "Failed to prepare test file");
+            furi_string_printf(buf, "decoder_input%ld", j);
+            mu_assert(
+                infrared_test_load_raw_signal(
+                    test->ff, furi_string_get_cstr(buf), &timings, &timings_count),
+                "Failed to load raw signal from file");
+            flipper_format_buffered_file_close(test->ff);
+
+            /* stress inputs that no raw signal can hold */
+            if(timings_count > MAX_TIMINGS_AMOUNT) {
+                free(timings);
+                continue;
+            }
+
+            uint8_t* packed = malloc(infrared_raw_pack_get_max_size(timings_count));
+            size_t packed_size = infrared_raw_pack(timings, timings_count, packed);
+            mu_check(packed_size > 0);
+            mu_check(packed_size <= infrared_raw_pack_get_max_size(timings_count));
+
+            size_t unpacked_count = 0;
+            mu_check(infrared_raw_unpack_get_count(packed, packed_size, &unpacked_count));
+            mu_assert_int_eq(timings_count, unpacked_count);
+
+            uint32_t* unpacked = malloc(unpacked_count * sizeof(uint32_t));
+            mu_check(infrared_raw_unpack(packed, packed_size, unpacked, unpacked_count));
+            mu_assert_mem_eq(timings, unpacked, timings_count * sizeof(uint32_t));
+
+            /* truncated data must be rejected, not read past the end */
+            mu_check(!infrared_raw_unpack(packed, packed_size - 1, unpacked, unpacked_count));
+
+            decimal_total += infrared_test_decimal_length(timings, timings_count);
+            /* two hex digits and a space per byte */
+            packed_total += packed_size * 3;
+            ++signal_count;
+
+            free(unpacked);
+            free(packed);
+            free(timings);
+        }
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%lu signals: %zu bytes as decimal, %zu bytes packed",
+        signal_count,
+        decimal_total,
+        packed_total);
+
+    const uint32_t too_long[] = {500, INFRARED_RAW_PACK_MAX_TIMING + 1};
+    uint8_t packed[16];
+    mu_assert_int_eq(0, infrared_raw_pack(too_long, COUNT_OF(too_long), packed));
+
+    furi_string_free(buf);
+}
+
+static void infrared_test_write_raw_header(FlipperFormat* ff, const char* name) {
+    const uint32_t frequency = INFRARED_COMMON_CARRIER_FREQUENCY;
+    const float duty_cycle = INFRARED_COMMON_DUTY_CYCLE;
+    mu_check(flipper_format_write_comment_cstr(ff, ""));
+    mu_check(flipper_format_write_string_cstr(ff, "name", name));
+    mu_check(flipper_format_write_string_cstr(ff, "type", "raw"));
+    mu_check(flipper_format_write_uint32(ff, "frequency", &frequency, 1));
+    mu_check(flipper_format_write_float(ff, "duty_cycle", &duty_cycle, 1));
+}
+
+static void infrared_test_read_raw_header(FlipperFormat* ff, FuriString* buf, const char* name) {
+    uint32_t frequency;
+    float duty_cycle;
+    mu_check(flipper_format_read_string(ff, "name", buf));
+    mu_assert_string_eq(name, furi_string_get_cstr(buf));
+    mu_check(flipper_format_read_string(ff, "type", buf));
+    mu_check(flipper_format_read_uint32(ff, "frequency", &frequency, 1));
+    mu_check(flipper_format_read_float(ff, "duty_cycle", &duty_cycle, 1));
+}
+
+MU_TEST(infrared_test_raw_pack_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    FuriString* buf = furi_string_alloc();
+
+    /* NEC frame, long enough for the packed form to be shorter */
+    uint32_t timings[2 + 32 * 2 + 1];
+    size_t timings_count = 0;
+    timings[timings_count++] = 9000;
+    timings[timings_count++] = 4500;
+    for(size_t i = 0; i < 32; ++i) {
+        timings[timings_count++] = 560;
+        timings[timings_count++] = (0xEE87A05DUL >> i) & 1 ? 1690 : 560;
+    }
+    timings[timings_count++] = 560;
+
+    const uint32_t unpackable[] = {500, INFRARED_RAW_PACK_MAX_TIMING + 1, 500};
+
+    /* packed, plain and packed again, so that a later packed key is present */
+    mu_check(flipper_format_file_open_always(ff, IR_TEST_PACK_FILE));
+    mu_check(flipper_format_write_header_cstr(ff, "IR signals file", 2));
+    infrared_test_write_raw_header(ff, "first");
+    mu_assert_int_eq(InfraredRawPackStatusOk, infrared_raw_pack_write(ff, timings, timings_count));
+    infrared_test_write_raw_header(ff, "second");
+    mu_assert_int_eq(
+        InfraredRawPackStatusNotPacked,
+        infrared_raw_pack_write(ff, unpackable, COUNT_OF(unpackable)));
+    mu_check(flipper_format_write_uint32(ff, "data", unpackable, COUNT_OF(unpackable)));
+    infrared_test_write_raw_header(ff, "third");
+    mu_assert_int_eq(InfraredRawPackStatusOk, infrared_raw_pack_write(ff, timings, timings_count));
+    mu_check(flipper_format_file_close(ff));
+
+    uint32_t version;
+    uint32_t* loaded = NULL;
+    size_t loaded_count = 0;
+
+    mu_check(flipper_format_file_open_existing(ff, IR_TEST_PACK_FILE));
+    mu_check(flipper_format_read_header(ff, buf, &version));
+    mu_assert_int_eq(2, version);
+
+    infrared_test_read_raw_header(ff, buf, "first");
+    mu_assert_int_eq(
+        InfraredRawPackStatusOk,
+        infrared_raw_pack_read(ff, MAX_TIMINGS_AMOUNT, &loaded, &loaded_count));
+    mu_assert_int_eq(timings_count, loaded_count);
+    mu_assert_mem_eq(timings, loaded, timings_count * sizeof(uint32_t));
+    free(loaded);
+
+    /* the packed key of the third signal must not be picked up, strict mode is kept */
+    infrared_test_read_raw_header(ff, buf, "second");
+    flipper_format_set_strict_mode(ff, true);
+    mu_assert_int_eq(
+        InfraredRawPackStatusNotPacked,
+        infrared_raw_pack_read(ff, MAX_TIMINGS_AMOUNT, &loaded, &loaded_count));
+    mu_check(flipper_format_get_strict_mode(ff));
+    flipper_format_set_strict_mode(ff, false);
+
+    uint32_t data[COUNT_OF(unpackable)];
+    mu_check(flipper_format_read_uint32(ff, "data", data, COUNT_OF(data)));
+    mu_assert_mem_eq(unpackable, data, sizeof(unpackable));
+
+    infrared_test_read_raw_header(ff, buf, "third");
+    mu_assert_int_eq(
+        InfraredRawPackStatusTooLong,
+        infrared_raw_pack_read(ff, timings_count - 1, &loaded, &loaded_count));
+    mu_check(!flipper_format_get_strict_mode(ff));
+    mu_check(flipper_format_file_close(ff));
+
+    mu_check(storage_simply_remove(storage, IR_TEST_PACK_FILE));
+
+    furi_string_free(buf);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -543,6 +785,9 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_pioneer);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_decoder_bank_stats);
+    MU_RUN_TEST(infrared_test_raw_pack);
+    MU_RUN_TEST(infrared_test_raw_pack_file);
 }
 
 int run_minunit_test_infrared(void) {
@@ -6,6 +6,10 @@
 
 #include <storage/storage.h>
 #include <applications/system/js_app/js_thread.h>
+#include <mjs_core_public.h>
+#include <mjs_exec_public.h>
+#include <mjs_object_public.h>
+#include <mjs_primitive_public.h>
 
 #include <stdint.h>
 
@@ -73,11 +77,154 @@ MU_TEST(js_test_storage) {
     js_test_run(JS_SCRIPT_PATH("storage"));
 }
 
+static void js_test_bench(const char* name, const char* script_path) {
+    uint32_t start = furi_get_tick();
+    js_test_run(script_path);
+    FURI_LOG_I("js_test", "%s: %lums", name, furi_get_tick() - start);
+}
+
+MU_TEST(js_test_bench_objects) {
+    js_test_bench("objects", JS_SCRIPT_PATH("bench_objects"));
+}
+MU_TEST(js_test_bench_arrays) {
+    js_test_bench("arrays", JS_SCRIPT_PATH("bench_arrays"));
+}
+MU_TEST(js_test_bench_modules) {
+    js_test_bench("modules", JS_SCRIPT_PATH("bench_modules"));
+}
+
+#define JS_DEL_PROPERTIES 32
+
+/** Property name mix of inline (up to 5 chars) and heap strings */
+static void js_test_del_name(char* name, size_t size, int i) {
+    snprintf(name, size, (i % 2) ? "p%d" : "property_%d", i);
+}
+
+MU_TEST(js_test_object_del) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_val_t obj = mjs_mk_object(mjs);
+    mjs_own(mjs, &obj);
+    char name[16];
+
+    // wide enough to get a property index
+    for(int i = 0; i < JS_DEL_PROPERTIES; i++) {
+        js_test_del_name(name, sizeof(name), i);
+        mu_assert_int_eq(MJS_OK, mjs_set(mjs, obj, name, ~0, mjs_mk_number(mjs, i)));
+    }
+
+    // every third property goes, the rest must still be found through the index
+    for(int i = 0; i < JS_DEL_PROPERTIES; i += 3) {
+        js_test_del_name(name, sizeof(name), i);
+        mu_assert_int_eq(0, mjs_del(mjs, obj, name, ~0));
+        mu_assert_int_eq(-1, mjs_del(mjs, obj, name, ~0));
+    }
+    for(int i = 0; i < JS_DEL_PROPERTIES; i++) {
+        js_test_del_name(name, sizeof(name), i);
+        mjs_val_t val = mjs_get(mjs, obj, name, ~0);
+        if(i % 3 == 0) {
+            mu_assert(mjs_is_undefined(val), "deleted property found");
+        } else {
+            mu_assert_int_eq(i, mjs_get_int(mjs, val));
+        }
+    }
+
+    // empty the object, then set every name again
+    for(int i = JS_DEL_PROPERTIES - 1; i >= 0; i--) {
+        if(i % 3 == 0) continue;
+        js_test_del_name(name, sizeof(name), i);
+        mu_assert_int_eq(0, mjs_del(mjs, obj, name, ~0));
+    }
+    for(int i = 0; i < JS_DEL_PROPERTIES; i++) {
+        js_test_del_name(name, sizeof(name), i);
+        mu_assert(mjs_is_undefined(mjs_get(mjs, obj, name, ~0)), "deleted property found");
+        mu_assert_int_eq(MJS_OK, mjs_set(mjs, obj, name, ~0, mjs_mk_number(mjs, i * 2)));
+    }
+    for(int i = 0; i < JS_DEL_PROPERTIES; i++) {
+        js_test_del_name(name, sizeof(name), i);
+        mu_assert_int_eq(i * 2, mjs_get_int(mjs, mjs_get(mjs, obj, name, ~0)));
+    }
+
+    mjs_disown(mjs, &obj);
+    mjs_destroy(mjs);
+}
+
+#define JS_BCODE_CACHE_DIR    EXT_PATH("unit_tests/js/cache")
+#define JS_BCODE_CACHE_SCRIPT EXT_PATH("unit_tests/js/cache_test.js")
+
+static void js_test_write_script(Storage* storage, const char* source) {
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, JS_BCODE_CACHE_SCRIPT, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_check(storage_file_write(file, source, strlen(source)) == strlen(source));
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
+/** Runs the cache test script, returns its result and whether it came from the cache */
+static bool js_test_cached_run(uint32_t build_id, int* result, bool* cached) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_set_jsc_cache(mjs, JS_BCODE_CACHE_DIR, build_id);
+
+    mjs_val_t res = MJS_UNDEFINED;
+    bool success = mjs_exec_file(mjs, JS_BCODE_CACHE_SCRIPT, &res) == MJS_OK;
+    *result = mjs_get_int(mjs, res);
+    *cached = mjs_get_jsc_cache_hits(mjs) == 1;
+
+    mjs_destroy(mjs);
+    return success;
+}
+
+MU_TEST(js_test_bytecode_cache) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, JS_BCODE_CACHE_DIR);
+    mu_check(storage_simply_mkdir(storage, JS_BCODE_CACHE_DIR));
+    js_test_write_script(storage, "let a = 0; for(let i = 0; i < 10; i++) { a = a + i; } a;");
+
+    int result;
+    bool cached;
+
+    // first run parses the script and stores its bytecode
+    uint32_t start = furi_get_tick();
+    mu_check(js_test_cached_run(1, &result, &cached));
+    uint32_t parse_time = furi_get_tick() - start;
+    mu_assert_int_eq(45, result);
+    mu_check(!cached);
+
+    // second run executes cached bytecode
+    start = furi_get_tick();
+    mu_check(js_test_cached_run(1, &result, &cached));
+    uint32_t cached_time = furi_get_tick() - start;
+    mu_assert_int_eq(45, result);
+    mu_assert(cached, "bytecode cache not used");
+    FURI_LOG_I("js_test", "bytecode cache: %lums parsed, %lums cached", parse_time, cached_time);
+
+    // another build must not use the cache, and replaces it
+    mu_check(js_test_cached_run(2, &result, &cached));
+    mu_assert_int_eq(45, result);
+    mu_assert(!cached, "bytecode cache of another build used");
+    mu_check(js_test_cached_run(2, &result, &cached));
+    mu_assert(cached, "bytecode cache not replaced");
+
+    // changed source must not use the cache
+    js_test_write_script(storage, "let a = 0; for(let i = 0; i < 5; i++) { a = a + i; } a;");
+    mu_check(js_test_cached_run(2, &result, &cached));
+    mu_assert_int_eq(10, result);
+    mu_assert(!cached, "stale bytecode cache used");
+
+    storage_simply_remove(storage, JS_BCODE_CACHE_SCRIPT);
+    storage_simply_remove_recursive(storage, JS_BCODE_CACHE_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_js) {
     MU_RUN_TEST(js_test_basic);
     MU_RUN_TEST(js_test_math);
     MU_RUN_TEST(js_test_event_loop);
     MU_RUN_TEST(js_test_storage);
+    MU_RUN_TEST(js_test_bench_objects);
+    MU_RUN_TEST(js_test_bench_arrays);
+    MU_RUN_TEST(js_test_bench_modules);
+    MU_RUN_TEST(js_test_object_del);
+    MU_RUN_TEST(js_test_bytecode_cache);
 }
 
 int run_minunit_test_js(void) {
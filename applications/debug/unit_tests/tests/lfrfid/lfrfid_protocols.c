@@ -2,6 +2,7 @@
 #include "../test.h" // IWYU pragma: keep
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/lfrfid_raw_analyzer.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
@@ -526,6 +527,141 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+typedef struct {
+    size_t em_hits;
+    size_t em_validated;
+    size_t other_hits;
+    uint64_t last_timestamp;
+    bool data_valid;
+} LfRfidRawAnalyzerTestContext;
+
+static void test_lfrfid_raw_analyzer_callback(const LFRFIDRawAnalyzerHit* hit, void* context) {
+    LfRfidRawAnalyzerTestContext* ctx = context;
+    const uint8_t data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+
+    if(hit->protocol == LFRFIDProtocolEM4100) {
+        ctx->em_hits++;
+        if(hit->validated) ctx->em_validated++;
+        if(hit->data_size != EM_TEST_DATA_SIZE || memcmp(hit->data, data, EM_TEST_DATA_SIZE)) {
+            ctx->data_valid = false;
+        }
+    } else {
+        ctx->other_hits++;
+    }
+
+    if(hit->timestamp < ctx->last_timestamp) ctx->data_valid = false;
+    ctx->last_timestamp = hit->timestamp;
+}
+
+// Clock advancing by one microsecond per reading
+#define LF_RFID_RAW_ANALYZER_TEST_TICKS_PER_US (10)
+
+static uint32_t test_lfrfid_raw_analyzer_clock(void* context) {
+    uint32_t* ticks = context;
+    *ticks += LF_RFID_RAW_ANALYZER_TEST_TICKS_PER_US;
+    return *ticks;
+}
+
+static void test_lfrfid_raw_analyzer_feed_em(
+    LFRFIDRawAnalyzer* analyzer,
+    size_t frames,
+    uint64_t* capture_time,
+    size_t* pair_count) {
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0; i < EM_TEST_EMULATION_TIMINGS_COUNT * frames; i++) {
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT] >= 0,
+            abs(em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT]) *
+                LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+            lfrfid_raw_analyzer_feed(analyzer, period, length);
+            *capture_time += length;
+            (*pair_count)++;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+}
+
+MU_TEST(test_lfrfid_raw_analyzer_em) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(dict);
+    LfRfidRawAnalyzerTestContext ctx = {.data_valid = true};
+    lfrfid_raw_analyzer_set_callback(analyzer, test_lfrfid_raw_analyzer_callback, &ctx);
+
+    uint32_t ticks = UINT32_MAX - LF_RFID_RAW_ANALYZER_TEST_TICKS_PER_US * 100;
+    lfrfid_raw_analyzer_set_clock(
+        analyzer, test_lfrfid_raw_analyzer_clock, LF_RFID_RAW_ANALYZER_TEST_TICKS_PER_US, &ticks);
+
+    uint64_t capture_time = 0;
+    size_t pair_count = 0;
+    test_lfrfid_raw_analyzer_feed_em(analyzer, 10, &capture_time, &pair_count);
+
+    const LFRFIDRawAnalyzerStats* stats = lfrfid_raw_analyzer_get_stats(analyzer);
+    mu_assert_int_eq(pair_count, stats->pair_count);
+    mu_assert_int_eq(0, stats->warn_count);
+    mu_check(capture_time == stats->capture_time);
+    mu_assert_int_eq(ctx.em_hits + ctx.other_hits, stats->hit_count);
+    // Clock is read before and after every pair and wraps around during the capture
+    mu_check(stats->process_time == pair_count);
+
+    // EM4100 needs 3 identical repeats to validate, capture has 10 frames
+    mu_check(ctx.em_hits > 3);
+    mu_check(ctx.em_validated > 0);
+    mu_check(ctx.data_valid);
+
+    lfrfid_raw_analyzer_reset(analyzer);
+    mu_assert_int_eq(0, lfrfid_raw_analyzer_get_stats(analyzer)->pair_count);
+
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(dict);
+}
+
+MU_TEST(test_lfrfid_raw_analyzer_malformed) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(dict);
+    LfRfidRawAnalyzerTestContext ctx = {.data_valid = true};
+    lfrfid_raw_analyzer_set_callback(analyzer, test_lfrfid_raw_analyzer_callback, &ctx);
+
+    uint32_t ticks = 0;
+    lfrfid_raw_analyzer_set_clock(
+        analyzer, test_lfrfid_raw_analyzer_clock, LF_RFID_RAW_ANALYZER_TEST_TICKS_PER_US, &ticks);
+
+    // Inverted pulse and zero pulse, then a glitch in the middle of the capture
+    mu_assert_int_eq(PROTOCOL_NO, lfrfid_raw_analyzer_feed(analyzer, 500, 200));
+    mu_assert_int_eq(PROTOCOL_NO, lfrfid_raw_analyzer_feed(analyzer, 0, 300));
+    uint64_t capture_time = 500;
+    size_t pair_count = 2;
+    test_lfrfid_raw_analyzer_feed_em(analyzer, 5, &capture_time, &pair_count);
+    mu_assert_int_eq(PROTOCOL_NO, lfrfid_raw_analyzer_feed(analyzer, UINT32_MAX, 1));
+    capture_time += 1;
+    pair_count++;
+    test_lfrfid_raw_analyzer_feed_em(analyzer, 5, &capture_time, &pair_count);
+
+    const LFRFIDRawAnalyzerStats* stats = lfrfid_raw_analyzer_get_stats(analyzer);
+    mu_assert_int_eq(pair_count, stats->pair_count);
+    mu_assert_int_eq(3, stats->warn_count);
+    mu_check(capture_time == stats->capture_time);
+    // Malformed pairs don't reach the decoders, so they aren't timed either
+    mu_check(stats->process_time == pair_count - 3);
+
+    mu_check(ctx.em_validated > 0);
+    mu_check(ctx.data_valid);
+
+    // Without a clock decoder time isn't measured
+    lfrfid_raw_analyzer_set_clock(analyzer, NULL, 0, NULL);
+    lfrfid_raw_analyzer_feed(analyzer, 256, 512);
+    mu_check(lfrfid_raw_analyzer_get_stats(analyzer)->process_time == 0);
+
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -540,6 +676,9 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_raw_analyzer_em);
+    MU_RUN_TEST(test_lfrfid_raw_analyzer_malformed);
 }
 
 int run_minunit_test_lfrfid_protocols(void) {
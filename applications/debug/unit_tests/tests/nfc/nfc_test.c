@@ -6,6 +6,8 @@
 #include <nfc/helpers/nfc_data_generator.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
+#include <nfc/nfc_scanner.h>
+#include <nfc/nfc_mock.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
@@ -20,6 +22,10 @@
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/slix/slix_poller.h>
 #include <nfc/protocols/slix/slix_poller_i.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/mfkey32.h>
+#include <nfc/helpers/mfkey32_worker.h>
 
 #include <nfc/nfc_poller.h>
 
@@ -222,9 +228,13 @@ MU_TEST(iso14443_3a_reader) {
     nfc_listener_start(iso3_listener, NULL, NULL);
 
     Iso14443_3aData iso14443_3a_poller_data = {};
+    nfc_mock_stats_reset();
     mu_assert(
         iso14443_3a_poller_sync_read(poller, &iso14443_3a_poller_data) == Iso14443_3aErrorNone,
         "iso14443_3a_poller_sync_read() failed");
+    NfcMockStats stats = {};
+    nfc_mock_stats_get(&stats);
+    mu_assert(stats.allocations == 0, "Heap allocations while reading");
 
     nfc_listener_stop(iso3_listener);
     mu_assert(
@@ -387,6 +397,139 @@ static void mf_ultralight_write(void) {
     nfc_free(poller);
 }
 
+#define NFC_TEST_MF_ULTRALIGHT_FWT_FC (60000)
+
+typedef struct {
+    FuriThreadId thread_id;
+    MfUltralightData* data;
+    BitBuffer* tx_buf;
+    BitBuffer* rx_buf;
+    bool success;
+} NfcTestMfUltralightReadCache;
+
+static bool mf_ultralight_read_cache_test_read_all(
+    Iso14443_3aPoller* poller,
+    NfcTestMfUltralightReadCache* test) {
+    const MfUltralightData* data = test->data;
+    bool success = true;
+
+    for(uint16_t start_page = 0; start_page < data->pages_total; start_page++) {
+        const uint8_t read_cmd[] = {MF_ULTRALIGHT_CMD_READ_PAGE, start_page};
+        bit_buffer_copy_bytes(test->tx_buf, read_cmd, sizeof(read_cmd));
+        Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+            poller, test->tx_buf, test->rx_buf, NFC_TEST_MF_ULTRALIGHT_FWT_FC);
+        if(error != Iso14443_3aErrorNone) {
+            FURI_LOG_E(TAG, "READ %u failed: %d", start_page, error);
+            success = false;
+            break;
+        }
+
+        // READ wraps around the last page, PWD and PACK always read as zeroes
+        uint8_t expected[4 * sizeof(MfUltralightPage)] = {};
+        for(uint16_t i = 0; i < 4; i++) {
+            uint16_t page = start_page + i;
+            if(mf_ultralight_is_page_pwd_or_pack(data->type, page)) continue;
+            memcpy(
+                &expected[i * sizeof(MfUltralightPage)],
+                data->page[page % data->pages_total].data,
+                sizeof(MfUltralightPage));
+        }
+
+        if(bit_buffer_get_size_bytes(test->rx_buf) != sizeof(expected) ||
+           memcmp(bit_buffer_get_data(test->rx_buf), expected, sizeof(expected)) != 0) {
+            FURI_LOG_E(TAG, "READ %u response mismatch", start_page);
+            success = false;
+            break;
+        }
+    }
+
+    return success;
+}
+
+static bool mf_ultralight_read_cache_test_write(
+    Iso14443_3aPoller* poller,
+    NfcTestMfUltralightReadCache* test,
+    uint8_t page) {
+    MfUltralightPage* data = &test->data->page[page];
+    furi_hal_random_fill_buf(data->data, sizeof(MfUltralightPage));
+
+    uint8_t write_cmd[sizeof(MfUltralightPage) + 2] = {MF_ULTRALIGHT_CMD_WRITE_PAGE, page};
+    memcpy(&write_cmd[2], data->data, sizeof(MfUltralightPage));
+    bit_buffer_copy_bytes(test->tx_buf, write_cmd, sizeof(write_cmd));
+    Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+        poller, test->tx_buf, test->rx_buf, NFC_TEST_MF_ULTRALIGHT_FWT_FC);
+
+    // ACK is a 4 bit frame without CRC
+    return (error == Iso14443_3aErrorWrongCrc) && (bit_buffer_get_size(test->rx_buf) == 4) &&
+           bit_buffer_starts_with_byte(test->rx_buf, MF_ULTRALIGHT_CMD_ACK);
+}
+
+static NfcCommand mf_ultralight_read_cache_test_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.event_data);
+    furi_check(context);
+
+    NfcTestMfUltralightReadCache* test = context;
+    Iso14443_3aPoller* poller = event.instance;
+    Iso14443_3aPollerEvent* iso3_event = event.event_data;
+
+    if(iso3_event->type == Iso14443_3aPollerEventTypeReady) {
+        // Precomputed responses, then the windows around both written pages, including the wrap
+        uint8_t last_user_page = test->data->pages_total - 6;
+        test->success = mf_ultralight_read_cache_test_read_all(poller, test) &&
+                        mf_ultralight_read_cache_test_write(poller, test, 4) &&
+                        mf_ultralight_read_cache_test_write(poller, test, last_user_page) &&
+                        mf_ultralight_read_cache_test_read_all(poller, test);
+    }
+
+    furi_thread_flags_set(test->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+MU_TEST(mf_ultralight_read_cache_test) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG215, nfc_device);
+    const MfUltralightData* mfu_ref_data =
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight);
+
+    NfcListener* mfu_listener =
+        nfc_listener_alloc(listener, NfcProtocolMfUltralight, mfu_ref_data);
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    NfcTestMfUltralightReadCache test = {
+        .thread_id = furi_thread_get_current_id(),
+        .data = mf_ultralight_alloc(),
+        .tx_buf = bit_buffer_alloc(32),
+        .rx_buf = bit_buffer_alloc(32),
+    };
+    mf_ultralight_copy(test.data, mfu_ref_data);
+
+    NfcPoller* iso3_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_3a);
+    nfc_poller_start(iso3_poller, mf_ultralight_read_cache_test_callback, &test);
+    uint32_t flag =
+        furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    mu_assert(flag == NFC_TEST_FLAG_WORKER_DONE, "Wrong thread flag");
+    nfc_poller_stop(iso3_poller);
+    nfc_poller_free(iso3_poller);
+
+    nfc_listener_stop(mfu_listener);
+    mu_assert(test.success, "READ responses don't match the card data");
+    mu_assert(
+        mf_ultralight_is_equal(
+            test.data, nfc_listener_get_data(mfu_listener, NfcProtocolMfUltralight)),
+        "Data not matches");
+
+    nfc_listener_free(mfu_listener);
+    bit_buffer_free(test.tx_buf);
+    bit_buffer_free(test.rx_buf);
+    mf_ultralight_free(test.data);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
 static void mf_classic_reader(void) {
     Nfc* poller = nfc_alloc();
     Nfc* listener = nfc_alloc();
@@ -823,6 +966,506 @@ MU_TEST(slix_set_password_access_all_passwords_cap) {
         EXT_PATH("unit_tests/nfc/Slix_cap_accept_all_pass.nfc"), 0x12341234, false);
 }
 
+#define NFC_TEST_SCANNER_TIMEOUT_MS (10000)
+
+typedef struct {
+    FuriThreadId thread_id;
+    size_t protocols_num;
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcTestScannerContext;
+
+static void nfc_test_scanner_callback(NfcScannerEvent event, void* context) {
+    NfcTestScannerContext* scanner_context = context;
+
+    // Detection event is repeated until the scanner is stopped, keep the first one
+    if((event.type == NfcScannerEventTypeDetected) && (scanner_context->protocols_num == 0)) {
+        memcpy(
+            scanner_context->protocols,
+            event.data.protocols,
+            event.data.protocol_num * sizeof(NfcProtocol));
+        scanner_context->protocols_num = event.data.protocol_num;
+        furi_thread_flags_set(scanner_context->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    }
+}
+
+static void nfc_test_scanner_detect(
+    NfcScanner* scanner,
+    NfcScannerMode mode,
+    NfcProtocol protocol,
+    uint32_t* detect_time) {
+    NfcTestScannerContext context = {.thread_id = furi_thread_get_current_id()};
+
+    nfc_scanner_set_mode(scanner, mode);
+
+    uint32_t start = furi_get_tick();
+    nfc_scanner_start(scanner, nfc_test_scanner_callback, &context);
+    uint32_t flags = furi_thread_flags_wait(
+        NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, NFC_TEST_SCANNER_TIMEOUT_MS);
+    *detect_time = furi_get_tick() - start;
+
+    nfc_scanner_stop(scanner);
+
+    mu_assert(flags == NFC_TEST_FLAG_WORKER_DONE, "Scanner timed out");
+
+    bool protocol_detected = false;
+    for(size_t i = 0; i < context.protocols_num; i++) {
+        if(context.protocols[i] == protocol) {
+            protocol_detected = true;
+            break;
+        }
+    }
+    mu_assert(protocol_detected, "Protocol not detected");
+}
+
+static void nfc_scanner_test(NfcDevice* nfc_device, NfcProtocol protocol) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* nfc_listener =
+        nfc_listener_alloc(listener, protocol, nfc_device_get_data(nfc_device, protocol));
+    nfc_listener_start(nfc_listener, NULL, NULL);
+
+    uint32_t default_time = 0;
+    uint32_t adaptive_time = 0;
+    NfcScanner* scanner = nfc_scanner_alloc(poller);
+    nfc_test_scanner_detect(scanner, NfcScannerModeDefault, protocol, &default_time);
+    // Adaptive run already has the detection history of the default one
+    nfc_test_scanner_detect(scanner, NfcScannerModeAdaptive, protocol, &adaptive_time);
+    nfc_scanner_free(scanner);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    FURI_LOG_I(
+        TAG,
+        "%s detected in %lums, adaptive %lums",
+        nfc_device_get_protocol_name(protocol),
+        default_time,
+        adaptive_time);
+}
+
+MU_TEST(nfc_scanner_mf_ultralight_test) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG215, nfc_device);
+
+    nfc_scanner_test(nfc_device, NfcProtocolMfUltralight);
+
+    nfc_device_free(nfc_device);
+}
+
+MU_TEST(nfc_scanner_mf_classic_test) {
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+
+    nfc_scanner_test(nfc_device, NfcProtocolMfClassic);
+
+    nfc_device_free(nfc_device);
+}
+
+// Exchange budgets, reading data one page or block per round-trip exceeds them
+#define NFC_BENCH_NTAG215_READ_EXCHANGES_MAX       (96)
+#define NFC_BENCH_MF_CLASSIC_1K_READ_EXCHANGES_MAX (384)
+#define NFC_BENCH_MF_CLASSIC_4K_READ_EXCHANGES_MAX (1280)
+
+static void nfc_bench_report(const char* name, uint32_t exchanges_max) {
+    NfcMockStats stats = {};
+    nfc_mock_stats_get(&stats);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu exchanges, %lu timeouts, %lu.%03lu ms, %lu allocations",
+        name,
+        stats.exchanges,
+        stats.timeouts,
+        stats.time_us / 1000,
+        stats.time_us % 1000,
+        stats.allocations);
+
+    mu_assert(stats.exchanges <= exchanges_max, "Exchange budget exceeded");
+    mu_assert(stats.allocations == 0, "Heap allocations while reading");
+}
+
+MU_TEST(nfc_bench_ntag215_read) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Ntag215.nfc")),
+        "nfc_device_load() failed\r\n");
+
+    NfcListener* mfu_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolMfUltralight,
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    MfUltralightData* mfu_data = mf_ultralight_alloc();
+    nfc_mock_stats_reset();
+    MfUltralightError error = mf_ultralight_poller_sync_read_card(poller, mfu_data);
+
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+
+    mu_assert(error == MfUltralightErrorNone, "mf_ultralight_poller_sync_read_card() failed");
+    nfc_bench_report("NTAG215 read", NFC_BENCH_NTAG215_READ_EXCHANGES_MAX);
+
+    mf_ultralight_free(mfu_data);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+static void nfc_bench_mf_classic_read(
+    NfcDataGeneratorType generator_type,
+    const char* name,
+    uint32_t exchanges_max) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(generator_type, nfc_device);
+    const MfClassicData* mfc_listener_data =
+        nfc_device_get_data(nfc_device, NfcProtocolMfClassic);
+
+    NfcListener* mfc_listener =
+        nfc_listener_alloc(listener, NfcProtocolMfClassic, mfc_listener_data);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    MfClassicDeviceKeys keys = {};
+    uint8_t sectors_num = mf_classic_get_total_sectors_num(mfc_listener_data->type);
+    for(uint8_t i = 0; i < sectors_num; i++) {
+        memset(keys.key_a[i].data, 0xff, sizeof(MfClassicKey));
+        memset(keys.key_b[i].data, 0xff, sizeof(MfClassicKey));
+        FURI_BIT_SET(keys.key_a_mask, i);
+        FURI_BIT_SET(keys.key_b_mask, i);
+    }
+
+    MfClassicData* mfc_data = mf_classic_alloc();
+    nfc_mock_stats_reset();
+    MfClassicError error = mf_classic_poller_sync_read(poller, &keys, mfc_data);
+
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    mu_assert(error == MfClassicErrorNone, "mf_classic_poller_sync_read() failed");
+    nfc_bench_report(name, exchanges_max);
+
+    mf_classic_free(mfc_data);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+}
+
+MU_TEST(nfc_bench_mf_classic_1k_read) {
+    nfc_bench_mf_classic_read(
+        NfcDataGeneratorTypeMfClassic1k_7b,
+        "MIFARE Classic 1K read",
+        NFC_BENCH_MF_CLASSIC_1K_READ_EXCHANGES_MAX);
+}
+
+MU_TEST(nfc_bench_mf_classic_4k_read) {
+    nfc_bench_mf_classic_read(
+        NfcDataGeneratorTypeMfClassic4k_7b,
+        "MIFARE Classic 4K read",
+        NFC_BENCH_MF_CLASSIC_4K_READ_EXCHANGES_MAX);
+}
+
+MU_TEST(nfc_buffer_pool_test) {
+    Nfc* nfc = nfc_alloc();
+
+    BitBuffer* buffers[NFC_BUFFER_POOL_SIZE] = {};
+    for(size_t i = 0; i < NFC_BUFFER_POOL_SIZE; i++) {
+        buffers[i] = nfc_buffer_borrow(nfc);
+        mu_assert(
+            bit_buffer_get_capacity_bytes(buffers[i]) == NFC_BUFFER_POOL_BUFFER_SIZE,
+            "Wrong buffer capacity");
+        mu_assert(bit_buffer_get_size(buffers[i]) == 0, "Borrowed buffer not empty");
+        for(size_t j = 0; j < i; j++) {
+            mu_assert(buffers[i] != buffers[j], "Buffer lent out twice");
+        }
+        bit_buffer_append_byte(buffers[i], i);
+    }
+    for(size_t i = 0; i < NFC_BUFFER_POOL_SIZE; i++) {
+        nfc_buffer_return(nfc, buffers[i]);
+    }
+
+    // Returned buffers can be borrowed again, the whole pool is free again
+    for(size_t i = 0; i < NFC_BUFFER_POOL_SIZE * 2; i++) {
+        BitBuffer* first = nfc_buffer_borrow(nfc);
+        BitBuffer* second = nfc_buffer_borrow(nfc);
+        mu_assert(first != second, "Buffer lent out twice");
+        mu_assert(bit_buffer_get_size(first) == 0, "Borrowed buffer not empty");
+        nfc_buffer_return(nfc, second);
+        nfc_buffer_return(nfc, first);
+    }
+    for(size_t i = 0; i < NFC_BUFFER_POOL_SIZE; i++) {
+        buffers[i] = nfc_buffer_borrow(nfc);
+    }
+    for(size_t i = 0; i < NFC_BUFFER_POOL_SIZE; i++) {
+        nfc_buffer_return(nfc, buffers[i]);
+    }
+
+    nfc_free(nfc);
+}
+
+#define CRYPTO1_TEST_SECTOR_BLOCKS    (4)
+#define CRYPTO1_TEST_BENCH_ITERATIONS (1000)
+
+// Reference keystream, one crypto1_bit() per bit
+static uint8_t crypto1_test_byte_bitwise(Crypto1* crypto, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_bit(crypto, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t crypto1_test_word_bitwise(Crypto1* crypto, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)crypto1_bit(crypto, FURI_BIT(in, i ^ 24), is_encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+static void crypto1_test_encrypt_bitwise(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
+    size_t size = bit_buffer_get_size_bytes(buff);
+    bit_buffer_set_size_bytes(out, size);
+    for(size_t i = 0; i < size; i++) {
+        uint8_t plain = bit_buffer_get_byte(buff, i);
+        uint8_t encrypted = crypto1_test_byte_bitwise(crypto, 0, 0) ^ plain;
+        // Parity is encrypted with the next keystream bit, which is not consumed
+        Crypto1 next = *crypto;
+        bool parity = crypto1_bit(&next, 0, 0) ^ !__builtin_parity(plain);
+        bit_buffer_set_byte_with_parity(out, i, encrypted, parity);
+    }
+}
+
+static void crypto1_test_decrypt_bitwise(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
+    size_t size = bit_buffer_get_size_bytes(buff);
+    bit_buffer_set_size_bytes(out, size);
+    for(size_t i = 0; i < size; i++) {
+        bit_buffer_set_byte(
+            out, i, crypto1_test_byte_bitwise(crypto, 0, 0) ^ bit_buffer_get_byte(buff, i));
+    }
+}
+
+MU_TEST(crypto1_keystream_test) {
+    for(size_t i = 0; i < 100; i++) {
+        uint64_t key = 0;
+        furi_hal_random_fill_buf((uint8_t*)&key, sizeof(MfClassicKey));
+
+        Crypto1 crypto;
+        Crypto1 reference;
+        crypto1_init(&crypto, key);
+        crypto1_init(&reference, key);
+
+        uint32_t word = furi_hal_random_get();
+        int is_encrypted = word & 1;
+        mu_assert(
+            crypto1_word(&crypto, word, is_encrypted) ==
+                crypto1_test_word_bitwise(&reference, word, is_encrypted),
+            "Word keystream mismatch");
+
+        for(size_t j = 0; j < 64; j++) {
+            uint8_t byte = furi_hal_random_get();
+            is_encrypted = j & 1;
+            mu_assert(
+                crypto1_byte(&crypto, byte, is_encrypted) ==
+                    crypto1_test_byte_bitwise(&reference, byte, is_encrypted),
+                "Byte keystream mismatch");
+        }
+
+        mu_assert(
+            crypto.odd == reference.odd && crypto.even == reference.even, "LFSR state mismatch");
+    }
+}
+
+MU_TEST(crypto1_sector_test) {
+    const uint64_t key = 0xa0a1a2a3a4a5;
+    const size_t block_frame_size = MF_CLASSIC_BLOCK_SIZE + 2;
+
+    BitBuffer* plain = bit_buffer_alloc(block_frame_size);
+    BitBuffer* encrypted = bit_buffer_alloc(block_frame_size);
+    BitBuffer* encrypted_reference = bit_buffer_alloc(block_frame_size);
+    BitBuffer* decrypted = bit_buffer_alloc(block_frame_size);
+
+    uint8_t block[MF_CLASSIC_BLOCK_SIZE];
+    Crypto1 listener;
+    Crypto1 listener_reference;
+    Crypto1 poller;
+    crypto1_init(&listener, key);
+    crypto1_init(&listener_reference, key);
+    crypto1_init(&poller, key);
+
+    // Read responses of a whole sector, as sent by the emulated card
+    for(size_t i = 0; i < CRYPTO1_TEST_SECTOR_BLOCKS; i++) {
+        furi_hal_random_fill_buf(block, sizeof(block));
+        bit_buffer_copy_bytes(plain, block, sizeof(block));
+        iso14443_crc_append(Iso14443CrcTypeA, plain);
+
+        crypto1_encrypt(&listener, NULL, plain, encrypted);
+        crypto1_test_encrypt_bitwise(&listener_reference, plain, encrypted_reference);
+        mu_assert(
+            memcmp(
+                bit_buffer_get_data(encrypted),
+                bit_buffer_get_data(encrypted_reference),
+                block_frame_size) == 0,
+            "Encrypted data mismatch");
+        mu_assert(
+            memcmp(
+                bit_buffer_get_parity(encrypted),
+                bit_buffer_get_parity(encrypted_reference),
+                (block_frame_size + 7) / 8) == 0,
+            "Encrypted parity mismatch");
+
+        crypto1_decrypt(&poller, encrypted, decrypted);
+        mu_assert(bit_buffer_get_size(decrypted) == bit_buffer_get_size(plain), "Wrong size");
+        mu_assert(
+            memcmp(bit_buffer_get_data(decrypted), bit_buffer_get_data(plain), block_frame_size) ==
+                0,
+            "Decrypted data mismatch");
+    }
+
+    // Benchmark: encrypt and decrypt a sector, table driven vs bitwise reference
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCH_ITERATIONS; i++) {
+        for(size_t j = 0; j < CRYPTO1_TEST_SECTOR_BLOCKS; j++) {
+            crypto1_encrypt(&listener, NULL, plain, encrypted);
+            crypto1_decrypt(&poller, encrypted, decrypted);
+        }
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < CRYPTO1_TEST_BENCH_ITERATIONS; i++) {
+        for(size_t j = 0; j < CRYPTO1_TEST_SECTOR_BLOCKS; j++) {
+            crypto1_test_encrypt_bitwise(&listener_reference, plain, encrypted_reference);
+            crypto1_test_decrypt_bitwise(&poller, encrypted_reference, decrypted);
+        }
+    }
+    uint32_t elapsed_reference = furi_get_tick() - start;
+
+    const uint32_t bytes = CRYPTO1_TEST_BENCH_ITERATIONS * CRYPTO1_TEST_SECTOR_BLOCKS *
+                           block_frame_size * 2;
+    const uint32_t cycles_per_ms = furi_hal_cortex_instructions_per_microsecond() * 1000;
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 sector: %lu cycles/byte, bitwise %lu cycles/byte",
+        elapsed * cycles_per_ms / bytes,
+        elapsed_reference * cycles_per_ms / bytes);
+
+    bit_buffer_free(decrypted);
+    bit_buffer_free(encrypted_reference);
+    bit_buffer_free(encrypted);
+    bit_buffer_free(plain);
+}
+
+static const Mfkey32Nonces mfkey32_test_nonces = {
+    .cuid = 0x4e704c78,
+    .nt0 = 0xa489c3b4,
+    .nr0 = 0x669b56ea,
+    .ar0 = 0xf4c4da5e,
+    .nt1 = 0xa239781b,
+    .nr1 = 0x9b1fb3a5,
+    .ar1 = 0x7b8429b7,
+};
+
+static const MfClassicKey mfkey32_test_key = {
+    .data = {0x3a, 0x79, 0x70, 0x9a, 0x02, 0xc1},
+};
+
+typedef struct {
+    FuriThreadId thread_id;
+    Mfkey32Error error;
+    MfClassicKey key;
+} NfcTestMfkey32Context;
+
+static void mfkey32_test_worker_callback(const Mfkey32WorkerEvent* event, void* context) {
+    NfcTestMfkey32Context* ctx = context;
+
+    if(event->type == Mfkey32WorkerEventTypeFinished) {
+        ctx->error = event->error;
+        ctx->key = event->key;
+        furi_thread_flags_set(ctx->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    }
+}
+
+MU_TEST(mfkey32_recover_test) {
+    NfcTestMfkey32Context context = {
+        .thread_id = furi_thread_get_current_id(),
+        .error = Mfkey32ErrorNotFound,
+    };
+
+    Mfkey32Worker* worker = mfkey32_worker_alloc(MFKEY32_DEFAULT_RAM_BUDGET);
+    mfkey32_worker_start(worker, &mfkey32_test_nonces, mfkey32_test_worker_callback, &context);
+    uint32_t flags =
+        furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    mu_assert(flags == NFC_TEST_FLAG_WORKER_DONE, "Wrong thread flags");
+    mfkey32_worker_stop(worker);
+    mfkey32_worker_free(worker);
+
+    mu_assert(context.error == Mfkey32ErrorNone, "Key not recovered");
+    mu_assert(
+        memcmp(context.key.data, mfkey32_test_key.data, sizeof(MfClassicKey)) == 0,
+        "Wrong key recovered");
+}
+
+MU_TEST(mfkey32_cancel_test) {
+    NfcTestMfkey32Context context = {
+        .thread_id = furi_thread_get_current_id(),
+        .error = Mfkey32ErrorNone,
+    };
+
+    // No key matches both authentications, the worker runs until stopped
+    Mfkey32Nonces nonces = mfkey32_test_nonces;
+    nonces.ar1 ^= 1;
+
+    Mfkey32Worker* worker = mfkey32_worker_alloc(MFKEY32_DEFAULT_RAM_BUDGET);
+    mfkey32_worker_start(worker, &nonces, mfkey32_test_worker_callback, &context);
+    mfkey32_worker_stop(worker);
+    mfkey32_worker_free(worker);
+
+    mu_assert(context.error == Mfkey32ErrorCancelled, "Recovery not cancelled");
+}
+
+MU_TEST(mfkey32_memory_test) {
+    MfClassicKey key = {};
+    Mfkey32Error error = mfkey32_recover(&mfkey32_test_nonces, 1024, &key, NULL, NULL);
+    mu_assert(error == Mfkey32ErrorMemory, "Recovery must not fit in 1KB");
+
+    // Budget above the free heap is cut down instead of failing in malloc
+    size_t heap_before = memmgr_get_free_heap();
+    uint32_t start = furi_get_tick();
+    error = mfkey32_recover(&mfkey32_test_nonces, SIZE_MAX, &key, NULL, NULL);
+    FURI_LOG_I(
+        TAG, "mfkey32 with %zu bytes of free heap: %lums", heap_before, furi_get_tick() - start);
+    mu_assert(error == Mfkey32ErrorNone, "Key not recovered with the whole heap");
+    mu_assert(
+        memcmp(key.data, mfkey32_test_key.data, sizeof(MfClassicKey)) == 0,
+        "Wrong key recovered");
+}
+
+MU_TEST(mfkey32_parse_log_line_test) {
+    const char* line = "Sec 5 key B cuid 4e704c78 nt0 a489c3b4 nr0 669b56ea ar0 f4c4da5e nt1 "
+                       "a239781b nr1 9b1fb3a5 ar1 7b8429b7\n";
+
+    Mfkey32Nonces nonces = {};
+    uint8_t sector_num = 0;
+    MfClassicKeyType key_type = MfClassicKeyTypeA;
+    mu_assert(mfkey32_parse_log_line(line, &nonces, &sector_num, &key_type), "Parse failed");
+    mu_assert(memcmp(&nonces, &mfkey32_test_nonces, sizeof(Mfkey32Nonces)) == 0, "Wrong nonces");
+    mu_assert(sector_num == 5, "Wrong sector number");
+    mu_assert(key_type == MfClassicKeyTypeB, "Wrong key type");
+
+    mu_assert(
+        !mfkey32_parse_log_line("Sec 5 key B cuid 4e704c78 nt0 a489c3b4", &nonces, NULL, NULL),
+        "Truncated line must not be parsed");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -835,6 +1478,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_ultralight_c_reader);
 
     MU_RUN_TEST(mf_ultralight_write);
+    MU_RUN_TEST(mf_ultralight_read_cache_test);
 
     MU_RUN_TEST(iso14443_3a_4b_file_test);
     MU_RUN_TEST(iso14443_3a_7b_file_test);
@@ -872,6 +1516,22 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(slix_set_password_default_cap_incorrect_pass);
     MU_RUN_TEST(slix_set_password_access_all_passwords_cap);
 
+    MU_RUN_TEST(nfc_scanner_mf_ultralight_test);
+    MU_RUN_TEST(nfc_scanner_mf_classic_test);
+
+    MU_RUN_TEST(nfc_bench_ntag215_read);
+    MU_RUN_TEST(nfc_bench_mf_classic_1k_read);
+    MU_RUN_TEST(nfc_bench_mf_classic_4k_read);
+    MU_RUN_TEST(nfc_buffer_pool_test);
+
+    MU_RUN_TEST(crypto1_keystream_test);
+    MU_RUN_TEST(crypto1_sector_test);
+
+    MU_RUN_TEST(mfkey32_parse_log_line_test);
+    MU_RUN_TEST(mfkey32_recover_test);
+    MU_RUN_TEST(mfkey32_cancel_test);
+    MU_RUN_TEST(mfkey32_memory_test);
+
     nfc_test_free();
 }
 
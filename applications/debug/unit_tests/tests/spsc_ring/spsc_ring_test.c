@@ -0,0 +1,187 @@
+#include <furi.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/spsc_ring.h>
+
+#define TAG "SpscRingTest"
+
+#define SPSC_RING_TEST_CAPACITY   (256U)
+#define SPSC_RING_TEST_WATERMARK  (32U)
+#define SPSC_RING_TEST_BATCH      (48U)
+#define SPSC_RING_TEST_COUNT      (200000U)
+#define SPSC_RING_TEST_EVENT_DATA (1U << 0)
+
+typedef struct {
+    SpscRing* ring;
+    uint32_t count;
+    uint32_t dropped;
+} SpscRingTestProducer;
+
+MU_TEST(test_spsc_ring_basic) {
+    SpscRing* ring = spsc_ring_alloc(sizeof(uint32_t), 8);
+
+    uint32_t value = 0;
+    mu_assert_int_eq(0, spsc_ring_pop(ring, &value, 1));
+
+    // Fill up, the ninth element is dropped
+    for(uint32_t i = 0; i < 8; i++) {
+        mu_check(spsc_ring_push(ring, &i));
+    }
+    value = 8;
+    mu_check(!spsc_ring_push(ring, &value));
+    mu_assert_int_eq(8, spsc_ring_get_count(ring));
+    mu_assert_int_eq(1, spsc_ring_get_overrun_count(ring));
+
+    // Move the read position, so that the next pop wraps around the storage end
+    uint32_t values[8] = {};
+    mu_assert_int_eq(5, spsc_ring_pop(ring, values, 5));
+    for(uint32_t i = 0; i < 5; i++) {
+        mu_assert_int_eq(i, values[i]);
+    }
+    for(uint32_t i = 8; i < 13; i++) {
+        mu_check(spsc_ring_push(ring, &i));
+    }
+    mu_assert_int_eq(8, spsc_ring_pop(ring, values, COUNT_OF(values)));
+    for(uint32_t i = 0; i < 8; i++) {
+        mu_assert_int_eq(i + 5, values[i]);
+    }
+    mu_assert_int_eq(0, spsc_ring_get_count(ring));
+
+    // Flush drops everything pending
+    for(uint32_t i = 0; i < 3; i++) {
+        mu_check(spsc_ring_push(ring, &i));
+    }
+    spsc_ring_flush(ring);
+    mu_assert_int_eq(0, spsc_ring_get_count(ring));
+    mu_assert_int_eq(0, spsc_ring_pop(ring, values, COUNT_OF(values)));
+    mu_assert_int_eq(1, spsc_ring_get_overrun_count(ring));
+
+    spsc_ring_free(ring);
+}
+
+MU_TEST(test_spsc_ring_watermark) {
+    SpscRing* ring = spsc_ring_alloc(sizeof(uint32_t), 16);
+    spsc_ring_set_wakeup(ring, furi_thread_get_current_id(), SPSC_RING_TEST_EVENT_DATA, 4);
+    furi_thread_flags_clear(SPSC_RING_TEST_EVENT_DATA);
+
+    for(uint32_t i = 0; i < 3; i++) {
+        spsc_ring_push(ring, &i);
+    }
+    mu_assert_int_eq(0, furi_thread_flags_get() & SPSC_RING_TEST_EVENT_DATA);
+
+    uint32_t value = 3;
+    spsc_ring_push(ring, &value);
+    mu_assert_int_eq(
+        SPSC_RING_TEST_EVENT_DATA,
+        furi_thread_flags_wait(SPSC_RING_TEST_EVENT_DATA, FuriFlagWaitAny, 0));
+
+    // No new wakeup above the watermark until the ring is drained
+    value = 4;
+    spsc_ring_push(ring, &value);
+    mu_assert_int_eq(0, furi_thread_flags_get() & SPSC_RING_TEST_EVENT_DATA);
+
+    spsc_ring_set_wakeup(ring, NULL, 0, 1);
+    spsc_ring_free(ring);
+}
+
+static int32_t spsc_ring_test_producer(void* context) {
+    SpscRingTestProducer* producer = context;
+
+    for(uint32_t i = 0; i < producer->count; i++) {
+        if(!spsc_ring_push(producer->ring, &i)) producer->dropped++;
+        // Bursts with short gaps, like a capture interrupt
+        if((i % 64) == 63) furi_delay_us(100);
+    }
+
+    return 0;
+}
+
+MU_TEST(test_spsc_ring_stress) {
+    SpscRingTestProducer producer = {
+        .ring = spsc_ring_alloc(sizeof(uint32_t), SPSC_RING_TEST_CAPACITY),
+        .count = SPSC_RING_TEST_COUNT,
+    };
+    spsc_ring_set_wakeup(
+        producer.ring,
+        furi_thread_get_current_id(),
+        SPSC_RING_TEST_EVENT_DATA,
+        SPSC_RING_TEST_WATERMARK);
+    furi_thread_flags_clear(SPSC_RING_TEST_EVENT_DATA);
+
+    // Runs on the device, the firmware has no host test build. The producer preempts the
+    // consumer, as an interrupt would.
+    FuriThread* thread =
+        furi_thread_alloc_ex("SpscRingProducer", 1024, spsc_ring_test_producer, &producer);
+    furi_thread_set_priority(thread, FuriThreadPriorityHighest);
+
+    uint32_t* values = malloc(sizeof(uint32_t) * SPSC_RING_TEST_BATCH);
+    uint32_t received = 0;
+    uint32_t expected = 0;
+    uint32_t gaps = 0;
+    bool ordered = true;
+
+    uint32_t rounds = 0;
+
+    uint32_t start = furi_get_tick();
+    furi_thread_start(thread);
+
+    while(true) {
+        bool done = furi_thread_get_state(thread) == FuriThreadStateStopped;
+        size_t count;
+        while((count = spsc_ring_pop(producer.ring, values, SPSC_RING_TEST_BATCH))) {
+            for(size_t i = 0; i < count; i++) {
+                // Values only ever increase, a jump is a run of dropped elements
+                if(values[i] < expected) ordered = false;
+                gaps += values[i] - expected;
+                expected = values[i] + 1;
+            }
+            received += count;
+        }
+        if(done) break;
+
+        // Wakeup is changed under the running producer, the timeout covers a missed one
+        rounds++;
+        spsc_ring_set_wakeup(
+            producer.ring,
+            (rounds % 4) ? furi_thread_get_current_id() : NULL,
+            SPSC_RING_TEST_EVENT_DATA,
+            (rounds % 2) ? SPSC_RING_TEST_WATERMARK : SPSC_RING_TEST_WATERMARK / 2);
+        furi_thread_flags_wait(SPSC_RING_TEST_EVENT_DATA, FuriFlagWaitAny, 1);
+    }
+
+    uint32_t time = furi_get_tick() - start;
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    FURI_LOG_I(
+        TAG,
+        "%lu elements in %lums, %lu dropped",
+        received,
+        time,
+        spsc_ring_get_overrun_count(producer.ring));
+
+    mu_check(ordered);
+    mu_assert_int_eq(SPSC_RING_TEST_COUNT, received + producer.dropped);
+    mu_assert_int_eq(producer.dropped, spsc_ring_get_overrun_count(producer.ring));
+    // Dropped elements at the very end don't leave a gap behind them
+    mu_check(gaps <= producer.dropped);
+    mu_assert_int_eq(0, spsc_ring_get_count(producer.ring));
+
+    free(values);
+    spsc_ring_set_wakeup(producer.ring, NULL, 0, 1);
+    spsc_ring_free(producer.ring);
+}
+
+MU_TEST_SUITE(test_spsc_ring_suite) {
+    MU_RUN_TEST(test_spsc_ring_basic);
+    MU_RUN_TEST(test_spsc_ring_watermark);
+    MU_RUN_TEST(test_spsc_ring_stress);
+}
+
+int run_minunit_test_spsc_ring(void) {
+    MU_RUN_SUITE(test_spsc_ring_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_spsc_ring)
@@ -5,8 +5,11 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_codec.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
 #include <flipper_format/flipper_format_i.h>
+#include <toolbox/compress.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
@@ -20,6 +23,13 @@
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT            10000
 
+#define TEST_KEELOQ_BENCH_KEYS 1024
+
+#define TEST_RAW_DIR_NAME    EXT_PATH(".tmp/unit_tests/subghz")
+#define TEST_RAW_PACKED_FILE TEST_RAW_DIR_NAME "/packed_raw.sub"
+#define TEST_RAW_TEXT_FILE   TEST_RAW_DIR_NAME "/text_raw.sub"
+#define TEST_RAW_BLOCK_FILE  TEST_RAW_DIR_NAME "/block_raw.sub"
+
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
 //static SubGhzTransmitter* transmitter_handler;
@@ -217,6 +227,36 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+MU_TEST(subghz_rainbow_table_test) {
+    const char* file_names[] = {CAME_ATOMO_DIR_NAME, NICE_FLOR_S_DIR_NAME, ALUTECH_AT_4N_DIR_NAME};
+
+    for(size_t i = 0; i < COUNT_OF(file_names); i++) {
+        // Cached reads must match the paged reads straight from the file
+        for(size_t offset = 0; offset < 32; offset += sizeof(uint32_t)) {
+            uint8_t cached[sizeof(uint32_t)] = {0};
+            uint8_t paged[sizeof(uint32_t)] = {0};
+            mu_assert(
+                subghz_environment_get_rainbow_table_data(
+                    environment_handler, file_names[i], offset, cached, sizeof(cached)),
+                "Cached rainbow table read error");
+            mu_assert(
+                subghz_keystore_raw_get_data(file_names[i], offset, paged, sizeof(paged)),
+                "Paged rainbow table read error");
+            mu_assert_mem_eq(paged, cached, sizeof(paged));
+        }
+
+        uint8_t byte = 0;
+        mu_assert(
+            !subghz_environment_get_rainbow_table_data(
+                environment_handler,
+                file_names[i],
+                SUBGHZ_ENVIRONMENT_RAINBOW_TABLE_SIZE_MAX,
+                &byte,
+                sizeof(byte)),
+            "Rainbow table read past the end");
+    }
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -372,6 +412,192 @@ MU_TEST(subghz_hal_async_tx_test) {
 }
 
 //test decoders
+static bool subghz_raw_codec_test_open(
+    FlipperFormat* flipper_format,
+    SubGhzRawCodec* codec,
+    const char* path,
+    FuriString* temp_str) {
+    return flipper_format_file_open_existing(flipper_format, path) &&
+           flipper_format_read_string(flipper_format, "Protocol", temp_str) &&
+           subghz_raw_codec_read_start(codec, flipper_format);
+}
+
+static bool subghz_raw_codec_test_compare(const char* path_a, const char* path_b) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file_a = flipper_format_file_alloc(storage);
+    FlipperFormat* file_b = flipper_format_file_alloc(storage);
+    SubGhzRawCodec* codec_a = subghz_raw_codec_alloc(SubGhzRawEncodingText);
+    SubGhzRawCodec* codec_b = subghz_raw_codec_alloc(SubGhzRawEncodingText);
+    int32_t* samples_a = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+    int32_t* samples_b = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+    FuriString* temp_str = furi_string_alloc();
+    bool equal = false;
+
+    if(subghz_raw_codec_test_open(file_a, codec_a, path_a, temp_str) &&
+       subghz_raw_codec_test_open(file_b, codec_b, path_b, temp_str)) {
+        // Block boundaries differ between encodings, compare duration by duration
+        size_t total = 0;
+        size_t count_a = 0, pos_a = 0;
+        size_t count_b = 0, pos_b = 0;
+        while(true) {
+            if(pos_a == count_a) {
+                count_a = subghz_raw_codec_read(
+                    codec_a, file_a, samples_a, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+                pos_a = 0;
+            }
+            if(pos_b == count_b) {
+                count_b = subghz_raw_codec_read(
+                    codec_b, file_b, samples_b, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+                pos_b = 0;
+            }
+            if(!count_a || !count_b) {
+                equal = (count_a == count_b) && total;
+                break;
+            }
+            if(samples_a[pos_a++] != samples_b[pos_b++]) break;
+            total++;
+        }
+    }
+
+    furi_string_free(temp_str);
+    free(samples_b);
+    free(samples_a);
+    subghz_raw_codec_free(codec_b);
+    subghz_raw_codec_free(codec_a);
+    flipper_format_free(file_b);
+    flipper_format_free(file_a);
+    furi_record_close(RECORD_STORAGE);
+
+    return equal;
+}
+
+static uint32_t subghz_raw_codec_test_version(const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version = 0;
+
+    if(!flipper_format_file_open_existing(file, path) ||
+       !flipper_format_read_header(file, temp_str, &version)) {
+        version = 0;
+    }
+
+    furi_string_free(temp_str);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return version;
+}
+
+MU_TEST(subghz_raw_codec_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create dir");
+
+    FileInfo source_info;
+    mu_assert(
+        storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &source_info) == FSE_OK,
+        "Cannot stat RAW file");
+
+    const SubGhzRawEncoding encodings[] = {SubGhzRawEncodingVarint, SubGhzRawEncodingHeatshrink};
+    for(size_t i = 0; i < COUNT_OF(encodings); i++) {
+        mu_assert(
+            subghz_raw_codec_convert(TEST_RANDOM_DIR_NAME, TEST_RAW_PACKED_FILE, encodings[i]),
+            "Convert to binary error");
+        mu_assert(
+            subghz_raw_codec_test_compare(TEST_RANDOM_DIR_NAME, TEST_RAW_PACKED_FILE),
+            "Binary RAW data mismatch");
+        mu_assert(
+            subghz_raw_codec_test_version(TEST_RAW_PACKED_FILE) == SUBGHZ_RAW_FILE_VERSION_BINARY,
+            "Binary RAW file version mismatch");
+
+        FileInfo packed_info;
+        mu_assert(
+            storage_common_stat(storage, TEST_RAW_PACKED_FILE, &packed_info) == FSE_OK,
+            "Cannot stat binary RAW file");
+        mu_assert(packed_info.size < source_info.size / 2, "Binary RAW file is too big");
+
+        mu_assert(
+            subghz_raw_codec_convert(
+                TEST_RAW_PACKED_FILE, TEST_RAW_TEXT_FILE, SubGhzRawEncodingText),
+            "Convert to text error");
+        mu_assert(
+            subghz_raw_codec_test_compare(TEST_RANDOM_DIR_NAME, TEST_RAW_TEXT_FILE),
+            "Text RAW data mismatch");
+        mu_assert(
+            subghz_raw_codec_test_version(TEST_RAW_TEXT_FILE) == SUBGHZ_RAW_FILE_VERSION,
+            "Text RAW file version mismatch");
+    }
+
+    // Playback of a binary file
+    mu_assert(
+        subghz_raw_codec_convert(
+            EXT_PATH("unit_tests/subghz/princeton_raw.sub"),
+            TEST_RAW_PACKED_FILE,
+            SubGhzRawEncodingHeatshrink),
+        "Convert to binary error");
+    mu_assert(
+        subghz_decoder_test(TEST_RAW_PACKED_FILE, SUBGHZ_PROTOCOL_PRINCETON_NAME),
+        "Test decoder " SUBGHZ_PROTOCOL_PRINCETON_NAME " binary RAW error\r\n");
+
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+/** Write a Heatshrink RAW file with a single block, then convert it to text */
+static bool subghz_raw_codec_test_block(Storage* storage, const uint8_t* payload, size_t size) {
+    File* file = storage_file_alloc(storage);
+    FuriString* header = furi_string_alloc_printf(
+        "Filetype: %s\nVersion: %d\nFrequency: 433920000\n"
+        "Preset: FuriHalSubGhzPresetOok650Async\nProtocol: RAW\nRAW_Encoding: Heatshrink\n",
+        SUBGHZ_RAW_FILE_TYPE,
+        SUBGHZ_RAW_FILE_VERSION_BINARY);
+    const uint8_t block_size[] = {size & 0xFF, size >> 8};
+
+    bool written =
+        storage_file_open(file, TEST_RAW_BLOCK_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+        storage_file_write(file, furi_string_get_cstr(header), furi_string_size(header)) ==
+            furi_string_size(header) &&
+        storage_file_write(file, block_size, sizeof(block_size)) == sizeof(block_size) &&
+        storage_file_write(file, payload, size) == size;
+
+    furi_string_free(header);
+    storage_file_free(file);
+
+    if(!written) return false;
+    return subghz_raw_codec_convert(
+        TEST_RAW_BLOCK_FILE, TEST_RAW_TEXT_FILE, SubGhzRawEncodingText);
+}
+
+MU_TEST(subghz_raw_codec_malformed_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create dir");
+
+    // Stored block of a single duration is shorter than a compress header, and valid
+    const uint8_t stored[] = {0x00, 0x02};
+    mu_assert(subghz_raw_codec_test_block(storage, stored, sizeof(stored)), "Stored block error");
+
+    // Compressed flag without the rest of the header
+    const uint8_t truncated[] = {0x01, 0x00};
+    mu_assert(
+        !subghz_raw_codec_test_block(storage, truncated, sizeof(truncated)),
+        "Truncated compress header accepted");
+
+    // Header claiming more, then less data than the block holds
+    uint8_t payload[sizeof(CompressHeader) + 4] = {0};
+    CompressHeader compress_header = {.is_compressed = 0x01};
+    const uint16_t sizes[] = {UINT16_MAX, sizeof(payload) - sizeof(CompressHeader) + 1, 1};
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        compress_header.compressed_buff_size = sizes[i];
+        memcpy(payload, &compress_header, sizeof(compress_header));
+        mu_assert(
+            !subghz_raw_codec_test_block(storage, payload, sizeof(payload)),
+            "Compress header size mismatch accepted");
+    }
+
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(subghz_decoder_came_atomo_test) {
     mu_assert(
         subghz_decoder_test(
@@ -427,6 +653,157 @@ MU_TEST(subghz_decoder_keeloq_test) {
         "Test decoder " SUBGHZ_PROTOCOL_KEELOQ_NAME " error\r\n");
 }
 
+static bool subghz_keeloq_bench_check(uint32_t decrypt, uint32_t fix) {
+    uint8_t end_serial = (decrypt >> 16) & 0xFF;
+    return (decrypt >> 28 == fix >> 28) && (end_serial == (fix & 0xFF) || end_serial == 0);
+}
+
+// One manufacture key at a time, as the decoder did before batching
+static const char*
+    subghz_keeloq_bench_scalar(SubGhzKeystore* keystore, uint32_t fix, uint32_t hop) {
+    for
+        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
+            uint64_t man = manufacture_code->key;
+            if(manufacture_code->type == KEELOQ_LEARNING_NORMAL) {
+                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+            }
+            if(subghz_keeloq_bench_check(subghz_protocol_keeloq_common_decrypt(hop, man), fix)) {
+                return furi_string_get_cstr(manufacture_code->name);
+            }
+        }
+    return NULL;
+}
+
+MU_TEST(subghz_keeloq_keystore_bench) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+
+    // Synthetic keystore, the remote belongs to the last manufacture
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    for(size_t i = 0; i < TEST_KEELOQ_BENCH_KEYS; i++) {
+        SubGhzKey* key = SubGhzKeyArray_push_raw(*keys);
+        key->name = furi_string_alloc_printf("Bench %zu", i);
+        key->key = (i + 1) * 0x9E3779B97F4A7C15ULL;
+        key->type = (i % 4) ? KEELOQ_LEARNING_NORMAL : KEELOQ_LEARNING_SIMPLE;
+    }
+    const SubGhzKey* manufacture_code = SubGhzKeyArray_back(*keys);
+
+    // No other synthetic key passes the decrypt check for this serial
+    const uint32_t serial = 0x0123458;
+    const uint8_t btn = 0x2;
+    const uint16_t cnt = 0x1234;
+    uint32_t fix = (uint32_t)btn << 28 | serial;
+    uint64_t man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+    uint32_t hop = subghz_protocol_keeloq_common_encrypt(
+        (uint32_t)btn << 28 | (serial & 0xFF) << 16 | cnt, man);
+
+    // Parcel is sent LSB first
+    uint64_t parcel = (uint64_t)fix << 32 | hop;
+    uint64_t data = 0;
+    for(size_t i = 0; i < 64; i++) {
+        data = data << 1 | ((parcel >> i) & 1);
+    }
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        key_data[i] = data >> (56 - i * 8);
+    }
+
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    uint32_t bits = 64;
+    flipper_format_write_uint32(flipper_format, "Bit", &bits, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(key_data));
+
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    mu_assert(decoder, "KeeLoq decoder not found");
+    mu_assert(
+        subghz_protocol_decoder_base_deserialize(decoder, flipper_format) ==
+            SubGhzProtocolStatusOk,
+        "Deserialize failed");
+
+    FuriString* text = furi_string_alloc();
+    FuriString* expected = furi_string_alloc_printf(
+        "Cnt:%04X\r\nHop:0x%08lX    Btn:%01X\r\nMF:%s\r\n",
+        cnt,
+        hop,
+        btn,
+        furi_string_get_cstr(manufacture_code->name));
+
+    uint32_t start = furi_get_tick();
+    const char* scalar_name = subghz_keeloq_bench_scalar(keystore, fix, hop);
+    uint32_t scalar_time = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    subghz_protocol_decoder_base_get_string(decoder, text);
+    uint32_t batch_time = furi_get_tick() - start;
+    bool batch_found = furi_string_search(text, expected) != FURI_STRING_FAILURE;
+
+    // Repeat parcel of the same remote is served by the learned-serial cache
+    furi_string_reset(text);
+    start = furi_get_tick();
+    subghz_protocol_decoder_base_get_string(decoder, text);
+    uint32_t cached_time = furi_get_tick() - start;
+    bool cached_found = furi_string_search(text, expected) != FURI_STRING_FAILURE;
+
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq %u keys: scalar %lums, batched %lums, cached %lums",
+        TEST_KEELOQ_BENCH_KEYS,
+        scalar_time,
+        batch_time,
+        cached_time);
+
+    furi_string_free(expected);
+    furi_string_free(text);
+    flipper_format_free(flipper_format);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+
+    mu_assert(
+        scalar_name && strcmp(scalar_name, furi_string_get_cstr(manufacture_code->name)) == 0,
+        "Scalar search failed");
+    mu_assert(batch_found, "Batched search failed");
+    mu_assert(cached_found, "Cached search failed");
+}
+
+MU_TEST(subghz_receiver_lazy_decoders_test) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+
+    // Nothing is allocated until the filter asks for it
+    mu_assert_int_eq(0, subghz_receiver_get_memory(receiver));
+
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable | SubGhzProtocolFlag_BinRAW);
+    size_t all_memory = subghz_receiver_get_memory(receiver);
+    mu_check(subghz_receiver_get_decoder_memory(receiver, SUBGHZ_PROTOCOL_BIN_RAW_NAME) > 0);
+
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_RAW);
+    size_t raw_memory = subghz_receiver_get_memory(receiver);
+    mu_check(subghz_receiver_get_decoder_memory(receiver, SUBGHZ_PROTOCOL_RAW_NAME) > 0);
+    mu_assert_int_eq(
+        0, subghz_receiver_get_decoder_memory(receiver, SUBGHZ_PROTOCOL_BIN_RAW_NAME));
+    mu_check(raw_memory < all_memory);
+
+    // Decoder found by name outlives filter changes
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_BIN_RAW_NAME);
+    mu_check(decoder);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_RAW);
+    mu_check(subghz_receiver_get_decoder_memory(receiver, SUBGHZ_PROTOCOL_BIN_RAW_NAME) > 0);
+    mu_check(
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_BIN_RAW_NAME) ==
+        decoder);
+
+    FURI_LOG_I(TAG, "Decoders: all %zu bytes, RAW only %zu bytes", all_memory, raw_memory);
+
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+}
+
 MU_TEST(subghz_decoder_kia_seed_test) {
     mu_assert(
         subghz_decoder_test(
@@ -842,6 +1219,7 @@ MU_TEST(subghz_random_test) {
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_rainbow_table_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -853,6 +1231,10 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_hormann_hsm_test);
     MU_RUN_TEST(subghz_decoder_ido_test);
     MU_RUN_TEST(subghz_decoder_keeloq_test);
+    MU_RUN_TEST(subghz_keeloq_keystore_bench);
+    MU_RUN_TEST(subghz_receiver_lazy_decoders_test);
+    MU_RUN_TEST(subghz_raw_codec_test);
+    MU_RUN_TEST(subghz_raw_codec_malformed_test);
     MU_RUN_TEST(subghz_decoder_kia_seed_test);
     MU_RUN_TEST(subghz_decoder_nero_radio_test);
     MU_RUN_TEST(subghz_decoder_nero_sketch_test);
@@ -1,6 +1,9 @@
 #include <update_util/resources/manifest.h>
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller_i.h>
+#include <nfc/nfc_mock.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/keeloq_common.h>
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/queue.h>
 #include <task.h>
@@ -17,6 +20,15 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_previous, ResourceManifestEntry*, (ResourceManifestReader*)),
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
+    API_METHOD(nfc_mock_stats_reset, void, ()),
+    API_METHOD(nfc_mock_stats_get, void, (NfcMockStats*)),
+    API_METHOD(subghz_keystore_get_data, SubGhzKeyArray_t*, (SubGhzKeystore*)),
+    API_METHOD(subghz_protocol_keeloq_common_encrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(subghz_protocol_keeloq_common_decrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_normal_learning,
+        uint64_t,
+        (uint32_t, const uint64_t)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
@@ -37,6 +37,16 @@ bool hid_usb_kb_release(void* inst, uint16_t button) {
     return furi_hal_hid_kb_release(button);
 }
 
+bool hid_usb_kb_press_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    UNUSED(inst);
+    return furi_hal_hid_kb_press_multiple(buttons, count);
+}
+
+bool hid_usb_kb_release_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    UNUSED(inst);
+    return furi_hal_hid_kb_release_multiple(buttons, count);
+}
+
 bool hid_usb_consumer_press(void* inst, uint16_t button) {
     UNUSED(inst);
     return furi_hal_hid_consumer_key_press(button);
@@ -67,6 +77,8 @@ static const BadUsbHidApi hid_api_usb = {
 
     .kb_press = hid_usb_kb_press,
     .kb_release = hid_usb_kb_release,
+    .kb_press_multiple = hid_usb_kb_press_multiple,
+    .kb_release_multiple = hid_usb_kb_release_multiple,
     .consumer_press = hid_usb_consumer_press,
     .consumer_release = hid_usb_consumer_release,
     .release_all = hid_usb_release_all,
@@ -157,6 +169,27 @@ bool hid_ble_kb_release(void* inst, uint16_t button) {
     return ble_profile_hid_kb_release(ble_hid->profile, button);
 }
 
+// BLE profile has no multi-key reports, keys are sent one by one
+bool hid_ble_kb_press_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    BleHidInstance* ble_hid = inst;
+    furi_assert(ble_hid);
+    bool state = true;
+    for(size_t i = 0; i < count; i++) {
+        state &= ble_profile_hid_kb_press(ble_hid->profile, buttons[i]);
+    }
+    return state;
+}
+
+bool hid_ble_kb_release_multiple(void* inst, const uint16_t* buttons, size_t count) {
+    BleHidInstance* ble_hid = inst;
+    furi_assert(ble_hid);
+    bool state = true;
+    for(size_t i = 0; i < count; i++) {
+        state &= ble_profile_hid_kb_release(ble_hid->profile, buttons[i]);
+    }
+    return state;
+}
+
 bool hid_ble_consumer_press(void* inst, uint16_t button) {
     BleHidInstance* ble_hid = inst;
     furi_assert(ble_hid);
@@ -191,6 +224,8 @@ static const BadUsbHidApi hid_api_ble = {
 
     .kb_press = hid_ble_kb_press,
     .kb_release = hid_ble_kb_release,
+    .kb_press_multiple = hid_ble_kb_press_multiple,
+    .kb_release_multiple = hid_ble_kb_release_multiple,
     .consumer_press = hid_ble_consumer_press,
     .consumer_release = hid_ble_consumer_release,
     .release_all = hid_ble_release_all,
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "bad_usb_hid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Count keys from the start of a keycode run that can be sent in one report
+ *
+ * All keys of a report share its modifier byte, so the run stops at the first
+ * modifier change. A key can't be pressed twice in one report, so the run also
+ * stops at a repeated key.
+ *
+ * @param      keycodes  keycodes with modifiers in the upper byte
+ * @param      count     keycodes count, non zero
+ * @param      max_keys  free key slots in the report
+ *
+ * @return     keys to send in one report, 0 if the report has no free slot
+ */
+static inline size_t
+    bad_usb_turbo_pack(const uint16_t* keycodes, size_t count, size_t max_keys) {
+    if(max_keys == 0) return 0;
+
+    const uint16_t mods = keycodes[0] & 0xFF00;
+
+    size_t packed = 1;
+    while((packed < count) && (packed < max_keys)) {
+        uint16_t keycode = keycodes[packed];
+        if((keycode & 0xFF00) != mods) break;
+
+        bool repeated = false;
+        for(size_t i = 0; i < packed; i++) {
+            if((keycodes[i] & 0xFF) == (keycode & 0xFF)) repeated = true;
+        }
+        if(repeated) break;
+
+        packed++;
+    }
+
+    return packed;
+}
+
+/** Type a keycode run with several keys per report
+ *
+ * Every report is pressed and released as a whole, held keys stay pressed.
+ *
+ * @param      hid       HID interface
+ * @param      hid_inst  HID interface instance
+ * @param      keycodes  keycodes with modifiers in the upper byte
+ * @param      count     keycodes count
+ * @param      held      keys held by the script, they take report slots
+ * @param      gap       delay between reports in ms
+ *
+ * @return     false if held keys leave no free slot, nothing is typed then
+ */
+static inline bool bad_usb_turbo_type(
+    const BadUsbHidApi* hid,
+    void* hid_inst,
+    const uint16_t* keycodes,
+    size_t count,
+    size_t held,
+    uint32_t gap) {
+    if(held >= HID_KB_MAX_KEYS) return false;
+
+    size_t max_keys = HID_KB_MAX_KEYS - held;
+    size_t i = 0;
+    while(i < count) {
+        size_t packed = bad_usb_turbo_pack(&keycodes[i], count - i, max_keys);
+        hid->kb_press_multiple(hid_inst, &keycodes[i], packed);
+        hid->kb_release_multiple(hid_inst, &keycodes[i], packed);
+        if(gap) furi_delay_ms(gap);
+        i += packed;
+    }
+
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,18 +3,19 @@
 #include <gui/gui.h>
 #include <input/input.h>
 #include <lib/toolbox/args.h>
-#include <lib/toolbox/strint.h>
 #include <storage/storage.h>
 #include "ducky_script.h"
 #include "ducky_script_i.h"
+#include "bad_usb_turbo.h"
 #include <dolphin/dolphin.h>
 
 #define TAG "BadUsb"
 
 #define WORKER_TAG TAG "Worker"
 
-#define BADUSB_ASCII_TO_KEY(script, x) \
-    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
+#define DUCKY_TURBO_LED_TIMEOUT 250
+#define DUCKY_TURBO_LED_SETTLE  50
+#define DUCKY_TURBO_PROBE_COUNT 5 // Odd, so that a single dropped toggle is seen
 
 typedef enum {
     WorkerEvtStartStop = (1 << 0),
@@ -39,47 +40,14 @@ static const uint8_t numpad_keys[10] = {
     HID_KEYPAD_9,
 };
 
-uint32_t ducky_get_command_len(const char* line) {
-    uint32_t len = strlen(line);
-    for(uint32_t i = 0; i < len; i++) {
-        if(line[i] == ' ') return i;
-    }
-    return 0;
-}
-
-bool ducky_is_line_end(const char chr) {
-    return (chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n');
-}
-
-uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars) {
-    uint16_t keycode = ducky_get_keycode_by_name(param);
-    if(keycode != HID_KEYBOARD_NONE) {
-        return keycode;
-    }
-
-    if((accept_chars) && (strlen(param) > 0)) {
-        return BADUSB_ASCII_TO_KEY(bad_usb, param[0]) & 0xFF;
-    }
-    return 0;
-}
-
-bool ducky_get_number(const char* param, uint32_t* val) {
-    uint32_t value = 0;
-    if(strint_to_uint32(param, NULL, &value, 10) == StrintParseNoError) {
-        *val = value;
-        return true;
-    }
-    return false;
-}
-
-void ducky_numlock_on(BadUsbScript* bad_usb) {
+static void ducky_numlock_on(BadUsbScript* bad_usb) {
     if((bad_usb->hid->get_led_state(bad_usb->hid_inst) & HID_KB_LED_NUM) == 0) {
         bad_usb->hid->kb_press(bad_usb->hid_inst, HID_KEYBOARD_LOCK_NUM_LOCK);
         bad_usb->hid->kb_release(bad_usb->hid_inst, HID_KEYBOARD_LOCK_NUM_LOCK);
     }
 }
 
-bool ducky_numpad_press(BadUsbScript* bad_usb, const char num) {
+static bool ducky_numpad_press(BadUsbScript* bad_usb, const char num) {
     if((num < '0') || (num > '9')) return false;
 
     uint16_t key = numpad_keys[num - '0'];
@@ -89,7 +57,7 @@ bool ducky_numpad_press(BadUsbScript* bad_usb, const char num) {
     return true;
 }
 
-bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode) {
+static bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode) {
     uint8_t i = 0;
     bool state = false;
 
@@ -105,7 +73,7 @@ bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode) {
     return state;
 }
 
-bool ducky_altstring(BadUsbScript* bad_usb, const char* param) {
+static bool ducky_altstring(BadUsbScript* bad_usb, const char* param) {
     uint32_t i = 0;
     bool state = false;
 
@@ -125,87 +93,196 @@ bool ducky_altstring(BadUsbScript* bad_usb, const char* param) {
     return state;
 }
 
-int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
-    va_list args;
-    va_start(args, text);
-
-    vsnprintf(bad_usb->st.error, sizeof(bad_usb->st.error), text, args);
-
-    va_end(args);
-    return SCRIPT_STATE_ERROR;
+static void ducky_key_press_release(BadUsbScript* bad_usb, uint16_t keycode) {
+    bad_usb->hid->kb_press(bad_usb->hid_inst, keycode);
+    bad_usb->hid->kb_release(bad_usb->hid_inst, keycode);
 }
 
-bool ducky_string(BadUsbScript* bad_usb, const char* param) {
-    uint32_t i = 0;
-
-    while(param[i] != '\0') {
-        if(param[i] != '\n') {
-            uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, param[i]);
-            if(keycode != HID_KEYBOARD_NONE) {
-                bad_usb->hid->kb_press(bad_usb->hid_inst, keycode);
-                bad_usb->hid->kb_release(bad_usb->hid_inst, keycode);
-            }
-        } else {
-            bad_usb->hid->kb_press(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-            bad_usb->hid->kb_release(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
+static int32_t ducky_string(BadUsbScript* bad_usb, const uint16_t* keycodes, size_t count) {
+    bad_usb->stringdelay = 0;
+    if(bad_usb->turbo) {
+        if(!bad_usb_turbo_type(
+               bad_usb->hid,
+               bad_usb->hid_inst,
+               keycodes,
+               count,
+               bad_usb->key_hold_nb,
+               bad_usb->turbo_gap)) {
+            return ducky_error(bad_usb, "No free key slot for turbo");
+        }
+    } else {
+        for(size_t i = 0; i < count; i++) {
+            ducky_key_press_release(bad_usb, keycodes[i]);
         }
-        i++;
     }
-    bad_usb->stringdelay = 0;
-    return true;
+    return 0;
 }
 
-static bool ducky_string_next(BadUsbScript* bad_usb) {
-    if(bad_usb->string_print_pos >= furi_string_size(bad_usb->string_print)) {
-        return true;
+static bool ducky_turbo_wait_led(BadUsbScript* bad_usb, uint8_t led_num) {
+    uint32_t start = furi_get_tick();
+    while((bad_usb->hid->get_led_state(bad_usb->hid_inst) & HID_KB_LED_NUM) != led_num) {
+        if(furi_get_tick() - start > DUCKY_TURBO_LED_TIMEOUT) return false;
+        furi_delay_ms(1);
     }
+    return true;
+}
 
-    char print_char = furi_string_get_char(bad_usb->string_print, bad_usb->string_print_pos);
+static bool ducky_turbo_probe(BadUsbScript* bad_usb, uint8_t led_num, uint32_t gap) {
+    const uint16_t key = HID_KEYBOARD_LOCK_NUM_LOCK;
+    for(size_t i = 0; i < DUCKY_TURBO_PROBE_COUNT; i++) {
+        bad_usb->hid->kb_press_multiple(bad_usb->hid_inst, &key, 1);
+        bad_usb->hid->kb_release_multiple(bad_usb->hid_inst, &key, 1);
+        if(gap) furi_delay_ms(gap);
+    }
 
-    if(print_char != '\n') {
-        uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, print_char);
-        if(keycode != HID_KEYBOARD_NONE) {
-            bad_usb->hid->kb_press(bad_usb->hid_inst, keycode);
-            bad_usb->hid->kb_release(bad_usb->hid_inst, keycode);
-        }
-    } else {
-        bad_usb->hid->kb_press(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
-        bad_usb->hid->kb_release(bad_usb->hid_inst, HID_KEYBOARD_RETURN);
+    // LED passes through the expected state on the way, so check it once more later
+    bool passed = ducky_turbo_wait_led(bad_usb, led_num ^ HID_KB_LED_NUM);
+    if(passed) {
+        furi_delay_ms(DUCKY_TURBO_LED_SETTLE);
+        passed = (bad_usb->hid->get_led_state(bad_usb->hid_inst) & HID_KB_LED_NUM) !=
+                 led_num;
     }
 
-    bad_usb->string_print_pos++;
+    // Restore the host NumLock state
+    if((bad_usb->hid->get_led_state(bad_usb->hid_inst) & HID_KB_LED_NUM) != led_num) {
+        ducky_key_press_release(bad_usb, key);
+        ducky_turbo_wait_led(bad_usb, led_num);
+    }
 
-    return false;
+    return passed;
 }
 
-static int32_t ducky_parse_line(BadUsbScript* bad_usb, FuriString* line) {
-    uint32_t line_len = furi_string_size(line);
-    const char* line_tmp = furi_string_get_cstr(line);
+/** Find the shortest gap between reports that the host doesn't drop keys at
+ *
+ * Host echoes NumLock with the keyboard LED report, so a burst of NumLock
+ * toggles with a dropped one leaves the LED in a wrong state.
+ */
+static void ducky_turbo_calibrate(BadUsbScript* bad_usb) {
+    static const uint32_t gaps[] = {0, 1, 2, 4, 8};
+
+    bad_usb->turbo = false;
+    bad_usb->turbo_gap = 0;
 
-    if(line_len == 0) {
-        return SCRIPT_STATE_NEXT_LINE; // Skip empty lines
+    if(bad_usb->interface != BadUsbHidInterfaceUsb) {
+        FURI_LOG_W(WORKER_TAG, "Turbo calibration needs USB LED reports");
+        return;
     }
-    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
 
-    // Ducky Lang Functions
-    int32_t cmd_result = ducky_execute_cmd(bad_usb, line_tmp);
-    if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
-        return cmd_result;
+    uint8_t led_num = bad_usb->hid->get_led_state(bad_usb->hid_inst) & HID_KB_LED_NUM;
+    ducky_key_press_release(bad_usb, HID_KEYBOARD_LOCK_NUM_LOCK);
+    bool echo = ducky_turbo_wait_led(bad_usb, led_num ^ HID_KB_LED_NUM);
+    ducky_key_press_release(bad_usb, HID_KEYBOARD_LOCK_NUM_LOCK);
+    if(!echo || !ducky_turbo_wait_led(bad_usb, led_num)) {
+        FURI_LOG_W(WORKER_TAG, "No LED echo from host, turbo is off");
+        return;
+    }
+
+    for(size_t i = 0; i < COUNT_OF(gaps); i++) {
+        if(ducky_turbo_probe(bad_usb, led_num, gaps[i])) {
+            bad_usb->turbo = true;
+            bad_usb->turbo_gap = gaps[i];
+            FURI_LOG_I(WORKER_TAG, "Turbo on, %lums between reports", gaps[i]);
+            return;
+        }
     }
 
-    // Special keys + modifiers
-    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
-    if(key == HID_KEYBOARD_NONE) {
-        return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
+    FURI_LOG_W(WORKER_TAG, "Host drops keys, turbo is off");
+}
+
+static bool ducky_string_next(BadUsbScript* bad_usb) {
+    const DuckyInstruction* instruction =
+        (const DuckyInstruction*)&bad_usb->program[bad_usb->string_print];
+    if(bad_usb->string_print_pos >= instruction->param) {
+        return true;
     }
-    if((key & 0xFF00) != 0) {
-        // It's a modifier key
-        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
-        key |= ducky_get_keycode(bad_usb, line_tmp, true);
+
+    const uint16_t* keycodes = (const uint16_t*)&instruction[1];
+    ducky_key_press_release(bad_usb, keycodes[bad_usb->string_print_pos]);
+
+    bad_usb->string_print_pos++;
+
+    return false;
+}
+
+static int32_t
+    ducky_execute_instruction(BadUsbScript* bad_usb, const DuckyInstruction* instruction) {
+    const void* data = &instruction[1];
+    uint16_t key = instruction->param;
+
+    switch((DuckyOp)instruction->op) {
+    case DuckyOpEmpty:
+        return SCRIPT_STATE_NEXT_LINE;
+    case DuckyOpNop:
+        return 0;
+    case DuckyOpDelay:
+        return (int32_t)instruction->param;
+    case DuckyOpDefaultDelay:
+        bad_usb->defdelay = instruction->param;
+        return 0;
+    case DuckyOpStringDelay:
+        bad_usb->stringdelay = instruction->param;
+        return 0;
+    case DuckyOpDefaultStringDelay:
+        bad_usb->defstringdelay = instruction->param;
+        return 0;
+    case DuckyOpString:
+        if(bad_usb->stringdelay == 0 &&
+           bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
+            return ducky_string(bad_usb, data, instruction->param);
+        }
+        // stringdelay is set - run command in thread to keep handling external events
+        bad_usb->string_print = (const uint8_t*)instruction - bad_usb->program;
+        bad_usb->string_print_pos = 0;
+        return SCRIPT_STATE_STRING_START;
+    case DuckyOpRepeat:
+        bad_usb->repeat_cnt = instruction->param;
+        return 0;
+    case DuckyOpSysrq:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->hid->release_all(bad_usb->hid_inst);
+        return 0;
+    case DuckyOpAltchar:
+        ducky_numlock_on(bad_usb);
+        ducky_altchar(bad_usb, data);
+        return 0;
+    case DuckyOpAltstring:
+        ducky_numlock_on(bad_usb);
+        ducky_altstring(bad_usb, data);
+        return 0;
+    case DuckyOpHold:
+        bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+        bad_usb->key_hold_nb++;
+        return 0;
+    case DuckyOpRelease:
+        bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+        bad_usb->key_hold_nb--;
+        return 0;
+    case DuckyOpMedia:
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, key);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, key);
+        return 0;
+    case DuckyOpGlobe:
+        bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        ducky_key_press_release(bad_usb, key);
+        bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+        return 0;
+    case DuckyOpWaitForButton:
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    case DuckyOpKey:
+        ducky_key_press_release(bad_usb, key);
+        return 0;
+    case DuckyOpTurbo:
+        if(instruction->param == DuckyTurboAuto) {
+            ducky_turbo_calibrate(bad_usb);
+        } else {
+            bad_usb->turbo = (instruction->param == DuckyTurboOn);
+            bad_usb->turbo_gap = 0;
+        }
+        return 0;
     }
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
-    return 0;
+
+    return ducky_error(bad_usb, "Invalid instruction %u", instruction->op);
 }
 
 static bool ducky_set_usb_id(BadUsbScript* bad_usb, const char* line) {
@@ -245,7 +322,7 @@ static void bad_usb_hid_state_callback(bool state, void* context) {
 }
 
 static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
-    uint8_t ret = 0;
+    uint16_t ret = 0;
     uint32_t line_len = 0;
 
     furi_string_reset(bad_usb->line);
@@ -291,72 +368,52 @@ static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
 }
 
 static int32_t ducky_script_execute_next(BadUsbScript* bad_usb, File* script_file) {
-    int32_t delay_val = 0;
+    const DuckyInstruction* instruction = NULL;
 
     if(bad_usb->repeat_cnt > 0) {
         bad_usb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_usb, bad_usb->line_prev);
-        if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-            return 0;
-        } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-            return delay_val;
-        } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-            return delay_val;
-        } else if(delay_val < 0) { // Script error
-            bad_usb->st.error_line = bad_usb->st.line_cur - 1;
-            FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur - 1U);
-            return SCRIPT_STATE_ERROR;
-        } else {
-            return delay_val + bad_usb->defdelay;
+        if(bad_usb->program_prev == SIZE_MAX) return 0; // Nothing to repeat
+        instruction = (const DuckyInstruction*)&bad_usb->program[bad_usb->program_prev];
+    } else {
+        if(bad_usb->program_pos >= bad_usb->program_size) {
+            if(bad_usb->compiler_end) return SCRIPT_STATE_END;
+            if(ducky_script_compile_next(bad_usb, script_file) != 0) return SCRIPT_STATE_ERROR;
+            if(bad_usb->program_pos >= bad_usb->program_size) return SCRIPT_STATE_END;
         }
-    }
-
-    furi_string_set(bad_usb->line_prev, bad_usb->line);
-    furi_string_reset(bad_usb->line);
 
-    while(1) {
-        if(bad_usb->buf_len == 0) {
-            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
-            if(storage_file_eof(script_file)) {
-                if((bad_usb->buf_len < FILE_BUFFER_LEN) && (bad_usb->file_end == false)) {
-                    bad_usb->file_buf[bad_usb->buf_len] = '\n';
-                    bad_usb->buf_len++;
-                    bad_usb->file_end = true;
-                }
-            }
-
-            bad_usb->buf_start = 0;
-            if(bad_usb->buf_len == 0) return SCRIPT_STATE_END;
-        }
-        for(uint8_t i = bad_usb->buf_start; i < (bad_usb->buf_start + bad_usb->buf_len); i++) {
-            if(bad_usb->file_buf[i] == '\n' && furi_string_size(bad_usb->line) > 0) {
-                bad_usb->st.line_cur++;
-                bad_usb->buf_len = bad_usb->buf_len + bad_usb->buf_start - (i + 1);
-                bad_usb->buf_start = i + 1;
-                furi_string_trim(bad_usb->line);
-                delay_val = ducky_parse_line(bad_usb, bad_usb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_usb->st.error_line = bad_usb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return delay_val + bad_usb->defdelay;
-                }
-            } else {
-                furi_string_push_back(bad_usb->line, bad_usb->file_buf[i]);
-            }
+        instruction = (const DuckyInstruction*)&bad_usb->program[bad_usb->program_pos];
+        if(instruction->op != DuckyOpRepeat) {
+            bad_usb->program_prev = bad_usb->program_pos;
         }
-        bad_usb->buf_len = 0;
-        if(bad_usb->file_end) return SCRIPT_STATE_END;
+        bad_usb->program_pos += ducky_instruction_size(instruction);
+        bad_usb->st.line_cur = instruction->line;
     }
 
-    return 0;
+    int32_t delay_val = ducky_execute_instruction(bad_usb, instruction);
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) { // Script error
+        bad_usb->st.error_line = bad_usb->st.line_cur;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_usb->st.line_cur);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return delay_val + bad_usb->defdelay;
+    }
+}
+
+static void ducky_script_reset(BadUsbScript* bad_usb) {
+    bad_usb->st.line_cur = 0;
+    bad_usb->defdelay = 0;
+    bad_usb->stringdelay = 0;
+    bad_usb->defstringdelay = 0;
+    bad_usb->repeat_cnt = 0;
+    bad_usb->key_hold_nb = 0;
+    bad_usb->turbo = false;
+    bad_usb->turbo_gap = 0;
 }
 
 static uint32_t bad_usb_flags_get(uint32_t flags_mask, uint32_t timeout) {
@@ -382,8 +439,6 @@ static int32_t bad_usb_worker(void* context) {
     FURI_LOG_I(WORKER_TAG, "Init");
     File* script_file = storage_file_alloc(furi_record_open(RECORD_STORAGE));
     bad_usb->line = furi_string_alloc();
-    bad_usb->line_prev = furi_string_alloc();
-    bad_usb->string_print = furi_string_alloc();
 
     while(1) {
         if(worker_state == BadUsbStateInit) { // State: initialization
@@ -430,16 +485,12 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtStartStop) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
-                bad_usb->st.line_cur = 0;
-                bad_usb->defdelay = 0;
-                bad_usb->stringdelay = 0;
-                bad_usb->defstringdelay = 0;
-                bad_usb->repeat_cnt = 0;
-                bad_usb->key_hold_nb = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
-                worker_state = BadUsbStateRunning;
+                ducky_script_reset(bad_usb);
+                if(ducky_script_compile_start(bad_usb, script_file)) {
+                    worker_state = BadUsbStateRunning;
+                } else {
+                    worker_state = BadUsbStateScriptError;
+                }
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
             }
@@ -454,14 +505,12 @@ static int32_t bad_usb_worker(void* context) {
             } else if(flags & WorkerEvtConnect) { // Start executing script
                 dolphin_deed(DolphinDeedBadUsbPlayScript);
                 delay_val = 0;
-                bad_usb->buf_len = 0;
-                bad_usb->st.line_cur = 0;
-                bad_usb->defdelay = 0;
-                bad_usb->stringdelay = 0;
-                bad_usb->defstringdelay = 0;
-                bad_usb->repeat_cnt = 0;
-                bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                ducky_script_reset(bad_usb);
+                if(!ducky_script_compile_start(bad_usb, script_file)) {
+                    worker_state = BadUsbStateScriptError;
+                    bad_usb->st.state = worker_state;
+                    continue;
+                }
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -636,8 +685,7 @@ static int32_t bad_usb_worker(void* context) {
     storage_file_close(script_file);
     storage_file_free(script_file);
     furi_string_free(bad_usb->line);
-    furi_string_free(bad_usb->line_prev);
-    furi_string_free(bad_usb->string_print);
+    free(bad_usb->program);
 
     FURI_LOG_I(WORKER_TAG, "End");
 
@@ -660,6 +708,7 @@ BadUsbScript* bad_usb_script_open(FuriString* file_path, BadUsbHidInterface inte
 
     bad_usb->st.state = BadUsbStateInit;
     bad_usb->st.error[0] = '\0';
+    bad_usb->interface = interface;
     bad_usb->hid = bad_usb_hid_get_interface(interface);
 
     bad_usb->thread = furi_thread_alloc_ex("BadUsbWorker", 2048, bad_usb_worker, bad_usb);
@@ -13,64 +13,47 @@ typedef struct {
 static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint32_t delay_val = 0;
     bool state = ducky_get_number(line, &delay_val);
-    if((state) && (delay_val > 0)) {
-        return (int32_t)delay_val;
+    if((state) && (delay_val > 0) && (delay_val <= INT32_MAX)) {
+        ducky_emit(bad_usb, DuckyOpDelay, delay_val, 0);
+        return 0;
     }
 
     return ducky_error(bad_usb, "Invalid number %s", line);
 }
 
 static int32_t ducky_fnc_defdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
-
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defdelay);
+    line = ducky_get_param(line);
+    uint32_t delay_val = 0;
+    bool state = ducky_get_number(line, &delay_val);
     if(!state) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
+    ducky_emit(bad_usb, (DuckyOp)param, delay_val, 0);
     return 0;
 }
 
-static int32_t ducky_fnc_strdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
+static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param) {
+    line = ducky_get_param(line);
 
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->stringdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
+    // Keycodes are resolved here, characters missing in the layout are skipped
+    size_t len = strlen(line);
+    uint32_t count = (param == 1) ? 1 : 0;
+    for(size_t i = 0; i < len; i++) {
+        if(ducky_get_char_keycode(bad_usb, line[i]) != HID_KEYBOARD_NONE) count++;
     }
-    return 0;
-}
-
-static int32_t ducky_fnc_defstrdelay(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->defstringdelay);
-    if(!state) {
-        return ducky_error(bad_usb, "Invalid number %s", line);
+    DuckyInstruction* instruction =
+        ducky_emit(bad_usb, DuckyOpString, count, count * sizeof(uint16_t));
+    uint16_t* keycodes = (uint16_t*)&instruction[1];
+    for(size_t i = 0; i < len; i++) {
+        uint16_t keycode = ducky_get_char_keycode(bad_usb, line[i]);
+        if(keycode != HID_KEYBOARD_NONE) *keycodes++ = keycode;
     }
-    return 0;
-}
-
-static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t param) {
-    line = &line[ducky_get_command_len(line) + 1];
-    furi_string_set_str(bad_usb->string_print, line);
     if(param == 1) {
-        furi_string_cat(bad_usb->string_print, "\n");
-    }
-
-    if(bad_usb->stringdelay == 0 &&
-       bad_usb->defstringdelay == 0) { // stringdelay not set - run command immediately
-        bool state = ducky_string(bad_usb, furi_string_get_cstr(bad_usb->string_print));
-        if(!state) {
-            return ducky_error(bad_usb, "Invalid string %s", line);
-        }
-    } else { // stringdelay is set - run command in thread to keep handling external events
-        return SCRIPT_STATE_STRING_START;
+        *keycodes = HID_KEYBOARD_RETURN;
     }
 
     return 0;
@@ -79,116 +62,158 @@ static int32_t ducky_fnc_string(BadUsbScript* bad_usb, const char* line, int32_t
 static int32_t ducky_fnc_repeat(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
-    bool state = ducky_get_number(line, &bad_usb->repeat_cnt);
-    if((!state) || (bad_usb->repeat_cnt == 0)) {
+    line = ducky_get_param(line);
+    uint32_t repeat_cnt = 0;
+    bool state = ducky_get_number(line, &repeat_cnt);
+    if((!state) || (repeat_cnt == 0)) {
         return ducky_error(bad_usb, "Invalid number %s", line);
     }
+
+    // Repeated HOLD and RELEASE are checked as if they were written out
+    DuckyCompilerState* compiler = &bad_usb->compiler;
+    if(compiler->last_op == DuckyOpHold) {
+        if(repeat_cnt > (HID_KB_MAX_KEYS - 1) - compiler->key_hold_nb) {
+            return ducky_error(bad_usb, "Too many keys are hold");
+        }
+        compiler->key_hold_nb += repeat_cnt;
+    } else if(compiler->last_op == DuckyOpRelease) {
+        if(repeat_cnt > compiler->key_hold_nb) {
+            return ducky_error(bad_usb, "No keys are hold");
+        }
+        compiler->key_hold_nb -= repeat_cnt;
+    }
+
+    ducky_emit(bad_usb, DuckyOpRepeat, repeat_cnt, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_sysrq(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint16_t key = ducky_get_keycode(bad_usb, line, true);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->release_all(bad_usb->hid_inst);
+    ducky_emit(bad_usb, DuckyOpSysrq, key, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_altchar(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altchar(bad_usb, line);
-    if(!state) {
+    line = ducky_get_param(line);
+    size_t len = 0;
+    while(!ducky_is_line_end(line[len])) {
+        if((line[len] < '0') || (line[len] > '9')) break;
+        len++;
+    }
+    if((len == 0) || !ducky_is_line_end(line[len])) {
         return ducky_error(bad_usb, "Invalid altchar %s", line);
     }
+
+    DuckyInstruction* instruction = ducky_emit(bad_usb, DuckyOpAltchar, len, len + 1);
+    char* digits = (char*)&instruction[1];
+    memcpy(digits, line, len);
+    digits[len] = '\0';
     return 0;
 }
 
 static int32_t ducky_fnc_altstring(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
-    ducky_numlock_on(bad_usb);
-    bool state = ducky_altstring(bad_usb, line);
-    if(!state) {
+    line = ducky_get_param(line);
+    size_t len = strlen(line);
+    bool printable = false;
+    for(size_t i = 0; i < len; i++) {
+        if((line[i] >= ' ') && (line[i] <= '~')) printable = true;
+    }
+    if(!printable) {
         return ducky_error(bad_usb, "Invalid altstring %s", line);
     }
+
+    DuckyInstruction* instruction = ducky_emit(bad_usb, DuckyOpAltstring, len, len + 1);
+    memcpy(&instruction[1], line, len + 1);
     return 0;
 }
 
 static int32_t ducky_fnc_hold(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint16_t key = ducky_get_keycode(bad_usb, line, true);
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    bad_usb->key_hold_nb++;
-    if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+    bad_usb->compiler.key_hold_nb++;
+    if(bad_usb->compiler.key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
         return ducky_error(bad_usb, "Too many keys are hold");
     }
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
+    ducky_emit(bad_usb, DuckyOpHold, key, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_release(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint16_t key = ducky_get_keycode(bad_usb, line, true);
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    if(bad_usb->key_hold_nb == 0) {
+    if(bad_usb->compiler.key_hold_nb == 0) {
         return ducky_error(bad_usb, "No keys are hold");
     }
-    bad_usb->key_hold_nb--;
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
+    bad_usb->compiler.key_hold_nb--;
+    ducky_emit(bad_usb, DuckyOpRelease, key, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_media(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint16_t key = ducky_get_media_keycode_by_name(line);
     if(key == HID_CONSUMER_UNASSIGNED) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, key);
+    ducky_emit(bad_usb, DuckyOpMedia, key, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_globe(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
 
-    line = &line[ducky_get_command_len(line) + 1];
+    line = ducky_get_param(line);
     uint16_t key = ducky_get_keycode(bad_usb, line, true);
     if(key == HID_KEYBOARD_NONE) {
         return ducky_error(bad_usb, "No keycode defined for %s", line);
     }
-
-    bad_usb->hid->consumer_press(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
-    bad_usb->hid->kb_press(bad_usb->hid_inst, key);
-    bad_usb->hid->kb_release(bad_usb->hid_inst, key);
-    bad_usb->hid->consumer_release(bad_usb->hid_inst, HID_CONSUMER_FN_GLOBE);
+    ducky_emit(bad_usb, DuckyOpGlobe, key, 0);
     return 0;
 }
 
 static int32_t ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line, int32_t param) {
     UNUSED(param);
-    UNUSED(bad_usb);
     UNUSED(line);
 
-    return SCRIPT_STATE_WAIT_FOR_BTN;
+    ducky_emit(bad_usb, DuckyOpWaitForButton, 0, 0);
+    return 0;
+}
+
+static int32_t ducky_fnc_turbo(BadUsbScript* bad_usb, const char* line, int32_t param) {
+    UNUSED(param);
+
+    line = ducky_get_param(line);
+    DuckyTurboMode mode;
+    if(strcmp(line, "ON") == 0) {
+        mode = DuckyTurboOn;
+    } else if(strcmp(line, "OFF") == 0) {
+        mode = DuckyTurboOff;
+    } else if(strcmp(line, "AUTO") == 0) {
+        mode = DuckyTurboAuto;
+    } else {
+        return ducky_error(bad_usb, "Invalid turbo mode %s", line);
+    }
+    ducky_emit(bad_usb, DuckyOpTurbo, mode, 0);
+    return 0;
 }
 
 static const DuckyCmd ducky_commands[] = {
@@ -197,12 +222,12 @@ static const DuckyCmd ducky_commands[] = {
     {"DELAY", ducky_fnc_delay, -1},
     {"STRING", ducky_fnc_string, 0},
     {"STRINGLN", ducky_fnc_string, 1},
-    {"DEFAULT_DELAY", ducky_fnc_defdelay, -1},
-    {"DEFAULTDELAY", ducky_fnc_defdelay, -1},
-    {"STRINGDELAY", ducky_fnc_strdelay, -1},
-    {"STRING_DELAY", ducky_fnc_strdelay, -1},
-    {"DEFAULT_STRING_DELAY", ducky_fnc_defstrdelay, -1},
-    {"DEFAULTSTRINGDELAY", ducky_fnc_defstrdelay, -1},
+    {"DEFAULT_DELAY", ducky_fnc_defdelay, DuckyOpDefaultDelay},
+    {"DEFAULTDELAY", ducky_fnc_defdelay, DuckyOpDefaultDelay},
+    {"STRINGDELAY", ducky_fnc_defdelay, DuckyOpStringDelay},
+    {"STRING_DELAY", ducky_fnc_defdelay, DuckyOpStringDelay},
+    {"DEFAULT_STRING_DELAY", ducky_fnc_defdelay, DuckyOpDefaultStringDelay},
+    {"DEFAULTSTRINGDELAY", ducky_fnc_defdelay, DuckyOpDefaultStringDelay},
     {"REPEAT", ducky_fnc_repeat, -1},
     {"SYSRQ", ducky_fnc_sysrq, -1},
     {"ALTCHAR", ducky_fnc_altchar, -1},
@@ -213,29 +238,32 @@ static const DuckyCmd ducky_commands[] = {
     {"WAIT_FOR_BUTTON_PRESS", ducky_fnc_waitforbutton, -1},
     {"MEDIA", ducky_fnc_media, -1},
     {"GLOBE", ducky_fnc_globe, -1},
+    {"TURBO", ducky_fnc_turbo, -1},
 };
 
-#define TAG "BadUsb"
+static const char* ducky_commands_get_name(size_t index) {
+    return ducky_commands[index].name;
+}
 
-#define WORKER_TAG TAG "Worker"
+static uint8_t ducky_commands_slots[64];
+static DuckyHashIndex ducky_commands_index = {
+    .get_name = ducky_commands_get_name,
+    .count = COUNT_OF(ducky_commands),
+    .slots = ducky_commands_slots,
+    .slots_count = COUNT_OF(ducky_commands_slots),
+};
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line) {
     size_t cmd_word_len = strcspn(line, " ");
-    for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
-        size_t cmd_compare_len = strlen(ducky_commands[i].name);
-
-        if(cmd_compare_len != cmd_word_len) {
-            continue;
-        }
-
-        if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
-            if(ducky_commands[i].callback == NULL) {
-                return 0;
-            } else {
-                return (ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param);
-            }
-        }
+    size_t index = ducky_hash_index_find(&ducky_commands_index, line, cmd_word_len);
+    if(index == SIZE_MAX) {
+        return SCRIPT_STATE_CMD_UNKNOWN;
     }
 
-    return SCRIPT_STATE_CMD_UNKNOWN;
+    if(ducky_commands[index].callback == NULL) {
+        ducky_emit(bad_usb, DuckyOpNop, 0, 0);
+        return 0;
+    } else {
+        return (ducky_commands[index].callback)(bad_usb, line, ducky_commands[index].param);
+    }
 }
@@ -0,0 +1,237 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/toolbox/strint.h>
+#include <storage/storage.h>
+#include "ducky_script.h"
+#include "ducky_script_i.h"
+
+#define TAG "BadUsb"
+
+#define WORKER_TAG TAG "Worker"
+
+#define BADUSB_ASCII_TO_KEY(script, x) \
+    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
+
+#define DUCKY_DATA_SIZE_ALIGN(size) (((size) + 3U) & ~3U)
+
+uint32_t ducky_get_command_len(const char* line) {
+    uint32_t len = strlen(line);
+    for(uint32_t i = 0; i < len; i++) {
+        if(line[i] == ' ') return i;
+    }
+    return 0;
+}
+
+const char* ducky_get_param(const char* line) {
+    const char* param = strchr(line, ' ');
+    return param ? (param + 1) : &line[strlen(line)];
+}
+
+bool ducky_is_line_end(const char chr) {
+    return (chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n');
+}
+
+uint16_t ducky_get_char_keycode(BadUsbScript* bad_usb, char chr) {
+    if(chr == '\n') return HID_KEYBOARD_RETURN;
+    return BADUSB_ASCII_TO_KEY(bad_usb, chr);
+}
+
+uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars) {
+    uint16_t keycode = ducky_get_keycode_by_name(param);
+    if(keycode != HID_KEYBOARD_NONE) {
+        return keycode;
+    }
+
+    if((accept_chars) && (strlen(param) > 0)) {
+        return BADUSB_ASCII_TO_KEY(bad_usb, param[0]) & 0xFF;
+    }
+    return 0;
+}
+
+bool ducky_get_number(const char* param, uint32_t* val) {
+    uint32_t value = 0;
+    if(strint_to_uint32(param, NULL, &value, 10) == StrintParseNoError) {
+        *val = value;
+        return true;
+    }
+    return false;
+}
+
+int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...) {
+    va_list args;
+    va_start(args, text);
+
+    vsnprintf(bad_usb->st.error, sizeof(bad_usb->st.error), text, args);
+
+    va_end(args);
+    return SCRIPT_STATE_ERROR;
+}
+
+size_t ducky_instruction_size(const DuckyInstruction* instruction) {
+    size_t data_size = 0;
+    if(instruction->op == DuckyOpString) {
+        data_size = instruction->param * sizeof(uint16_t);
+    } else if((instruction->op == DuckyOpAltchar) || (instruction->op == DuckyOpAltstring)) {
+        data_size = instruction->param + 1;
+    }
+    return sizeof(DuckyInstruction) + DUCKY_DATA_SIZE_ALIGN(data_size);
+}
+
+DuckyInstruction* ducky_emit(BadUsbScript* bad_usb, DuckyOp op, uint32_t param, size_t data_size) {
+    size_t size = sizeof(DuckyInstruction) + DUCKY_DATA_SIZE_ALIGN(data_size);
+
+    // Segment size is a soft limit, a single long line still fits in whole
+    if(bad_usb->program_size + size > bad_usb->program_capacity) {
+        size_t capacity = MAX(bad_usb->program_size + size, (size_t)DUCKY_PROGRAM_SEGMENT_SIZE);
+        bad_usb->program = realloc(bad_usb->program, capacity); //-V701
+        bad_usb->program_capacity = capacity;
+    }
+
+    DuckyInstruction* instruction = (DuckyInstruction*)&bad_usb->program[bad_usb->program_size];
+    instruction->op = op;
+    instruction->line = bad_usb->compiler.line;
+    instruction->param = param;
+    bad_usb->program_size += size;
+
+    if(op != DuckyOpRepeat) {
+        bad_usb->compiler.last_op = op;
+    }
+
+    return instruction;
+}
+
+static int32_t ducky_compile_line(BadUsbScript* bad_usb, const char* line_tmp) {
+    if(strlen(line_tmp) == 0) {
+        ducky_emit(bad_usb, DuckyOpEmpty, 0, 0);
+        return 0;
+    }
+    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
+
+    // Ducky Lang Functions
+    int32_t cmd_result = ducky_compile_cmd(bad_usb, line_tmp);
+    if(cmd_result != SCRIPT_STATE_CMD_UNKNOWN) {
+        return cmd_result;
+    }
+
+    // Special keys + modifiers
+    uint16_t key = ducky_get_keycode(bad_usb, line_tmp, false);
+    if(key == HID_KEYBOARD_NONE) {
+        return ducky_error(bad_usb, "No keycode defined for %s", line_tmp);
+    }
+    if((key & 0xFF00) != 0) {
+        // It's a modifier key
+        line_tmp = ducky_get_param(line_tmp);
+        key |= ducky_get_keycode(bad_usb, line_tmp, true);
+    }
+    ducky_emit(bad_usb, DuckyOpKey, key, 0);
+    return 0;
+}
+
+static bool ducky_script_read_line(BadUsbScript* bad_usb, File* script_file) {
+    furi_string_reset(bad_usb->line);
+
+    while(true) {
+        if(bad_usb->buf_len == 0) {
+            if(bad_usb->file_end) break;
+            bad_usb->buf_start = 0;
+            bad_usb->buf_len = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
+            if(bad_usb->buf_len == 0) {
+                bad_usb->file_end = true;
+                break;
+            }
+        }
+
+        char chr = bad_usb->file_buf[bad_usb->buf_start++];
+        bad_usb->buf_len--;
+        if(chr != '\n') {
+            furi_string_push_back(bad_usb->line, chr);
+        } else if(furi_string_size(bad_usb->line) > 0) {
+            return true;
+        }
+    }
+
+    return furi_string_size(bad_usb->line) > 0;
+}
+
+/** Compile script lines from the current file position into the program
+ *
+ * Stops once the program grows past DUCKY_PROGRAM_SEGMENT_SIZE. With validate
+ * set, the rest of the script is still compiled to find errors, but not kept.
+ */
+static int32_t ducky_script_compile(BadUsbScript* bad_usb, File* script_file, bool validate) {
+    bool segment_end = false;
+    size_t segment_size = 0;
+    DuckyCompilerState segment_state = {};
+    uint64_t segment_file_pos = 0;
+
+    while(ducky_script_read_line(bad_usb, script_file)) {
+        bad_usb->compiler.line++;
+        furi_string_trim(bad_usb->line);
+        if(ducky_compile_line(bad_usb, furi_string_get_cstr(bad_usb->line)) != 0) {
+            bad_usb->st.error_line = bad_usb->compiler.line;
+            FURI_LOG_E(WORKER_TAG, "Unknown command at line %lu", bad_usb->compiler.line);
+            return SCRIPT_STATE_ERROR;
+        }
+
+        if(segment_end) {
+            bad_usb->program_size = segment_size;
+        } else if(bad_usb->program_size >= DUCKY_PROGRAM_SEGMENT_SIZE) {
+            segment_end = true;
+            segment_size = bad_usb->program_size;
+            segment_state = bad_usb->compiler;
+            segment_file_pos = storage_file_tell(script_file) - bad_usb->buf_len;
+            if(!validate) break;
+        }
+    }
+
+    bad_usb->compiler_end = !segment_end;
+    if(segment_end) {
+        bad_usb->compiler = segment_state;
+        bad_usb->compiler_file_pos = segment_file_pos;
+    }
+
+    return 0;
+}
+
+bool ducky_script_compile_start(BadUsbScript* bad_usb, File* script_file) {
+    storage_file_seek(script_file, 0, true);
+    bad_usb->buf_len = 0;
+    bad_usb->file_end = false;
+
+    memset(&bad_usb->compiler, 0, sizeof(bad_usb->compiler));
+    bad_usb->program_size = 0;
+    bad_usb->program_pos = 0;
+    bad_usb->program_prev = SIZE_MAX;
+    bad_usb->st.error[0] = '\0';
+
+    uint32_t start = furi_get_tick();
+    if(ducky_script_compile(bad_usb, script_file, true) != 0) {
+        return false;
+    }
+
+    FURI_LOG_I(
+        WORKER_TAG,
+        "Compiled in %lums, first segment %zu bytes",
+        furi_get_tick() - start,
+        bad_usb->program_size);
+    return true;
+}
+
+int32_t ducky_script_compile_next(BadUsbScript* bad_usb, File* script_file) {
+    // Previous instruction is kept in front of the new segment for REPEAT
+    size_t kept_size = 0;
+    if(bad_usb->program_prev != SIZE_MAX) {
+        uint8_t* prev = &bad_usb->program[bad_usb->program_prev];
+        kept_size = ducky_instruction_size((const DuckyInstruction*)prev);
+        memmove(bad_usb->program, prev, kept_size);
+        bad_usb->program_prev = 0;
+    }
+    bad_usb->program_size = kept_size;
+    bad_usb->program_pos = kept_size;
+
+    storage_file_seek(script_file, bad_usb->compiler_file_pos, true);
+    bad_usb->buf_len = 0;
+    bad_usb->file_end = false;
+
+    return ducky_script_compile(bad_usb, script_file, false);
+}
@@ -0,0 +1,58 @@
+#include <furi.h>
+#include "ducky_script_i.h"
+
+#define DUCKY_HASH_SLOT_EMPTY    (0xFF)
+#define DUCKY_HASH_SEED_ATTEMPTS (0x10000)
+
+static uint32_t ducky_hash(uint32_t seed, const char* name, size_t len) {
+    // FNV-1a, upper bits folded in as the slot is taken from the lower ones
+    uint32_t hash = 2166136261UL ^ seed;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619UL;
+    }
+    return hash ^ (hash >> 16);
+}
+
+static bool ducky_hash_index_try_seed(DuckyHashIndex* index, uint32_t seed) {
+    memset(index->slots, DUCKY_HASH_SLOT_EMPTY, index->slots_count);
+
+    for(size_t i = 0; i < index->count; i++) {
+        const char* name = index->get_name(i);
+        size_t slot = ducky_hash(seed, name, strlen(name)) & (index->slots_count - 1);
+        if(index->slots[slot] != DUCKY_HASH_SLOT_EMPTY) return false;
+        index->slots[slot] = i;
+    }
+
+    return true;
+}
+
+static void ducky_hash_index_build(DuckyHashIndex* index) {
+    furi_check(index->count < DUCKY_HASH_SLOT_EMPTY);
+    furi_check((index->slots_count & (index->slots_count - 1)) == 0);
+
+    // Slots are sized so that a collision free seed is found in a few dozen attempts
+    for(uint32_t attempt = 0; attempt < DUCKY_HASH_SEED_ATTEMPTS; attempt++) {
+        uint32_t seed = attempt * 0x9E3779B9UL;
+        if(ducky_hash_index_try_seed(index, seed)) {
+            index->seed = seed;
+            index->ready = true;
+            return;
+        }
+    }
+
+    furi_crash("No perfect hash seed");
+}
+
+size_t ducky_hash_index_find(DuckyHashIndex* index, const char* name, size_t len) {
+    if(!index->ready) ducky_hash_index_build(index);
+
+    size_t slot = ducky_hash(index->seed, name, len) & (index->slots_count - 1);
+    uint8_t item = index->slots[slot];
+    if(item == DUCKY_HASH_SLOT_EMPTY) return SIZE_MAX;
+
+    const char* item_name = index->get_name(item);
+    if((strlen(item_name) != len) || (strncmp(item_name, name, len) != 0)) return SIZE_MAX;
+
+    return item;
+}
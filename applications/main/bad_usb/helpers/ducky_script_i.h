@@ -6,6 +6,7 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <storage/storage.h>
 #include "ducky_script.h"
 #include "bad_usb_hid.h"
 
@@ -16,10 +17,65 @@ extern "C" {
 #define SCRIPT_STATE_STRING_START (-5)
 #define SCRIPT_STATE_WAIT_FOR_BTN (-6)
 
-#define FILE_BUFFER_LEN 16
+#define FILE_BUFFER_LEN 512
+
+#define DUCKY_PROGRAM_SEGMENT_SIZE 4096
+
+typedef enum {
+    DuckyOpEmpty, // Blank line, no default delay
+    DuckyOpNop, // REM and ID
+    DuckyOpDelay,
+    DuckyOpDefaultDelay,
+    DuckyOpStringDelay,
+    DuckyOpDefaultStringDelay,
+    DuckyOpString, // param: keycodes count, followed by uint16_t keycodes
+    DuckyOpRepeat,
+    DuckyOpSysrq,
+    DuckyOpAltchar, // followed by null-terminated digits
+    DuckyOpAltstring, // followed by null-terminated chars
+    DuckyOpHold,
+    DuckyOpRelease,
+    DuckyOpMedia,
+    DuckyOpGlobe,
+    DuckyOpWaitForButton,
+    DuckyOpKey,
+    DuckyOpTurbo, // param: DuckyTurboMode
+} DuckyOp;
+
+typedef enum {
+    DuckyTurboOff,
+    DuckyTurboOn,
+    DuckyTurboAuto, // On with a gap between reports tuned on the host, off if that fails
+} DuckyTurboMode;
+
+// Instructions are kept 4-byte aligned, data follows the header
+typedef struct {
+    uint8_t op;
+    uint32_t line;
+    uint32_t param;
+} DuckyInstruction;
+
+typedef struct {
+    uint32_t line;
+    uint32_t key_hold_nb;
+    DuckyOp last_op;
+} DuckyCompilerState;
+
+typedef const char* (*DuckyHashGetName)(size_t index);
+
+/** Perfect hash over a static name table, built on first lookup */
+typedef struct {
+    DuckyHashGetName get_name;
+    size_t count;
+    uint8_t* slots;
+    size_t slots_count;
+    uint32_t seed;
+    bool ready;
+} DuckyHashIndex;
 
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
+    BadUsbHidInterface interface;
     const BadUsbHidApi* hid;
     void* hid_inst;
     FuriThread* thread;
@@ -27,8 +83,8 @@ struct BadUsbScript {
 
     FuriString* file_path;
     uint8_t file_buf[FILE_BUFFER_LEN + 1];
-    uint8_t buf_start;
-    uint8_t buf_len;
+    uint16_t buf_start;
+    uint16_t buf_len;
     bool file_end;
 
     uint32_t defdelay;
@@ -37,18 +93,37 @@ struct BadUsbScript {
     uint16_t layout[128];
 
     FuriString* line;
-    FuriString* line_prev;
     uint32_t repeat_cnt;
-    uint8_t key_hold_nb;
-
-    FuriString* string_print;
+    uint32_t key_hold_nb;
+
+    // Several keys per report, turbo_gap ms between reports
+    bool turbo;
+    uint32_t turbo_gap;
+
+    // Compiled segment of the script and the compiler position after it
+    uint8_t* program;
+    size_t program_size;
+    size_t program_capacity;
+    size_t program_pos;
+    size_t program_prev;
+    DuckyCompilerState compiler;
+    uint64_t compiler_file_pos;
+    bool compiler_end;
+
+    size_t string_print;
     size_t string_print_pos;
 };
 
+size_t ducky_hash_index_find(DuckyHashIndex* index, const char* name, size_t len);
+
 uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars);
 
+uint16_t ducky_get_char_keycode(BadUsbScript* bad_usb, char chr);
+
 uint32_t ducky_get_command_len(const char* line);
 
+const char* ducky_get_param(const char* line);
+
 bool ducky_is_line_end(const char chr);
 
 uint16_t ducky_get_keycode_by_name(const char* param);
@@ -57,19 +132,19 @@ uint16_t ducky_get_media_keycode_by_name(const char* param);
 
 bool ducky_get_number(const char* param, uint32_t* val);
 
-void ducky_numlock_on(BadUsbScript* bad_usb);
+DuckyInstruction* ducky_emit(BadUsbScript* bad_usb, DuckyOp op, uint32_t param, size_t data_size);
 
-bool ducky_numpad_press(BadUsbScript* bad_usb, const char num);
+size_t ducky_instruction_size(const DuckyInstruction* instruction);
 
-bool ducky_altchar(BadUsbScript* bad_usb, const char* charcode);
+int32_t ducky_compile_cmd(BadUsbScript* bad_usb, const char* line);
 
-bool ducky_altstring(BadUsbScript* bad_usb, const char* param);
-
-bool ducky_string(BadUsbScript* bad_usb, const char* param);
+int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
+/** Check the whole script and compile its first segment, rewinds the file */
+bool ducky_script_compile_start(BadUsbScript* bad_usb, File* script_file);
 
-int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
+/** Compile the segment after the current one, 0 on success */
+int32_t ducky_script_compile_next(BadUsbScript* bad_usb, File* script_file);
 
 #ifdef __cplusplus
 }
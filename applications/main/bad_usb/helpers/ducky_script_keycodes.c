@@ -108,26 +108,49 @@ static const DuckyKey ducky_media_keys[] = {
     {"BRIGHT_DOWN", HID_CONSUMER_BRIGHTNESS_DECREMENT},
 };
 
-uint16_t ducky_get_keycode_by_name(const char* param) {
-    for(size_t i = 0; i < COUNT_OF(ducky_keys); i++) {
-        size_t key_cmd_len = strlen(ducky_keys[i].name);
-        if((strncmp(param, ducky_keys[i].name, key_cmd_len) == 0) &&
-           (ducky_is_line_end(param[key_cmd_len]))) {
-            return ducky_keys[i].keycode;
-        }
+static const char* ducky_keys_get_name(size_t index) {
+    return ducky_keys[index].name;
+}
+
+static const char* ducky_media_keys_get_name(size_t index) {
+    return ducky_media_keys[index].name;
+}
+
+static uint8_t ducky_keys_slots[512];
+static DuckyHashIndex ducky_keys_index = {
+    .get_name = ducky_keys_get_name,
+    .count = COUNT_OF(ducky_keys),
+    .slots = ducky_keys_slots,
+    .slots_count = COUNT_OF(ducky_keys_slots),
+};
+
+static uint8_t ducky_media_keys_slots[128];
+static DuckyHashIndex ducky_media_keys_index = {
+    .get_name = ducky_media_keys_get_name,
+    .count = COUNT_OF(ducky_media_keys),
+    .slots = ducky_media_keys_slots,
+    .slots_count = COUNT_OF(ducky_media_keys_slots),
+};
+
+static size_t ducky_get_name_len(const char* param) {
+    size_t len = 0;
+    while(!ducky_is_line_end(param[len])) {
+        len++;
     }
+    return len;
+}
 
-    return HID_KEYBOARD_NONE;
+uint16_t ducky_get_keycode_by_name(const char* param) {
+    size_t index = ducky_hash_index_find(&ducky_keys_index, param, ducky_get_name_len(param));
+    if(index == SIZE_MAX) return HID_KEYBOARD_NONE;
+
+    return ducky_keys[index].keycode;
 }
 
 uint16_t ducky_get_media_keycode_by_name(const char* param) {
-    for(size_t i = 0; i < COUNT_OF(ducky_media_keys); i++) {
-        size_t key_cmd_len = strlen(ducky_media_keys[i].name);
-        if((strncmp(param, ducky_media_keys[i].name, key_cmd_len) == 0) &&
-           (ducky_is_line_end(param[key_cmd_len]))) {
-            return ducky_media_keys[i].keycode;
-        }
-    }
+    size_t index =
+        ducky_hash_index_find(&ducky_media_keys_index, param, ducky_get_name_len(param));
+    if(index == SIZE_MAX) return HID_CONSUMER_UNASSIGNED;
 
-    return HID_CONSUMER_UNASSIGNED;
+    return ducky_media_keys[index].keycode;
 }
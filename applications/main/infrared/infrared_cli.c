@@ -22,6 +22,7 @@ DICT_DEF2(dict_signals, FuriString*, FURI_STRING_OPLIST, int, M_DEFAULT_OPLIST)
 static void infrared_cli_start_ir_rx(Cli* cli, FuriString* args);
 static void infrared_cli_start_ir_tx(Cli* cli, FuriString* args);
 static void infrared_cli_process_decode(Cli* cli, FuriString* args);
+static void infrared_cli_process_pack(Cli* cli, FuriString* args);
 static void infrared_cli_process_universal(Cli* cli, FuriString* args);
 
 static const struct {
@@ -31,6 +32,7 @@ static const struct {
     {.cmd = "rx", .process_function = infrared_cli_start_ir_rx},
     {.cmd = "tx", .process_function = infrared_cli_start_ir_tx},
     {.cmd = "decode", .process_function = infrared_cli_process_decode},
+    {.cmd = "pack", .process_function = infrared_cli_process_pack},
     {.cmd = "universal", .process_function = infrared_cli_process_universal},
 };
 
@@ -117,6 +119,7 @@ static void infrared_cli_print_usage(void) {
         INFRARED_MIN_FREQUENCY,
         INFRARED_MAX_FREQUENCY);
     printf("\tir decode <input_file> [<output_file>]\r\n");
+    printf("\tir pack <input_file> <output_file>\r\n");
     printf("\tir universal <remote_name> <signal_name>\r\n");
     printf("\tir universal list <remote_name>\r\n");
     printf("\tAvailable universal remotes: ");
@@ -362,7 +365,8 @@ static void infrared_cli_process_decode(Cli* cli, FuriString* args) {
             break;
         }
         if(!flipper_format_read_header(input_file, header, &version) ||
-           (!furi_string_start_with_str(header, "IR")) || version != 1) {
+           (!furi_string_start_with_str(header, "IR")) ||
+           (version != 1 && version != INFRARED_SIGNAL_PACKED_FILE_VERSION)) {
             printf(
                 "Invalid or corrupted input file: \"%s\"\r\n", furi_string_get_cstr(input_path));
             break;
@@ -399,6 +403,100 @@ static void infrared_cli_process_decode(Cli* cli, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool infrared_cli_pack_file(FlipperFormat* input_file, FlipperFormat* output_file) {
+    bool ret = true;
+
+    InfraredSignal* signal = infrared_signal_alloc();
+    FuriString* name = furi_string_alloc();
+
+    InfraredErrorCode error;
+    while((error = infrared_signal_read(signal, input_file, name)) == InfraredErrorCodeNone) {
+        error = infrared_signal_save_packed(signal, output_file, furi_string_get_cstr(name));
+        if(INFRARED_ERROR_PRESENT(error)) {
+            printf(
+                "Failed to save signal: \"%s\" code: 0x%X\r\n",
+                furi_string_get_cstr(name),
+                INFRARED_ERROR_GET_CODE(error));
+            ret = false;
+            break;
+        }
+    }
+
+    // Reading stops at the end of the file with a missing name
+    if(ret && !INFRARED_ERROR_CHECK(error, InfraredErrorCodeSignalNameNotFound)) {
+        printf(
+            "Failed to read signal: \"%s\" code: 0x%X\r\n",
+            furi_string_get_cstr(name),
+            INFRARED_ERROR_GET_CODE(error));
+        ret = false;
+    }
+
+    furi_string_free(name);
+    infrared_signal_free(signal);
+
+    return ret;
+}
+
+static void infrared_cli_process_pack(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* input_file = flipper_format_buffered_file_alloc(storage);
+    FlipperFormat* output_file = flipper_format_file_alloc(storage);
+
+    uint32_t version;
+    FuriString *header, *input_path, *output_path;
+    header = furi_string_alloc();
+    input_path = furi_string_alloc();
+    output_path = furi_string_alloc();
+
+    do {
+        if(!args_read_probably_quoted_string_and_trim(args, input_path) ||
+           !args_read_probably_quoted_string_and_trim(args, output_path)) {
+            printf("Wrong arguments.\r\n");
+            infrared_cli_print_usage();
+            break;
+        }
+        if(!flipper_format_buffered_file_open_existing(
+               input_file, furi_string_get_cstr(input_path))) {
+            printf(
+                "Failed to open file for reading: \"%s\"\r\n", furi_string_get_cstr(input_path));
+            break;
+        }
+        if(!flipper_format_read_header(input_file, header, &version) ||
+           (!furi_string_start_with_str(header, "IR")) ||
+           (version != 1 && version != INFRARED_SIGNAL_PACKED_FILE_VERSION)) {
+            printf(
+                "Invalid or corrupted input file: \"%s\"\r\n", furi_string_get_cstr(input_path));
+            break;
+        }
+        if(!flipper_format_file_open_always(output_file, furi_string_get_cstr(output_path))) {
+            printf(
+                "Failed to open file for writing: \"%s\"\r\n", furi_string_get_cstr(output_path));
+            break;
+        }
+        // Older firmware can't read packed signals, the version tells it so
+        if(!flipper_format_write_header(
+               output_file, header, INFRARED_SIGNAL_PACKED_FILE_VERSION)) {
+            printf(
+                "Failed to write to the output file: \"%s\"\r\n",
+                furi_string_get_cstr(output_path));
+            break;
+        }
+        if(!infrared_cli_pack_file(input_file, output_file)) {
+            break;
+        }
+        printf("File successfully packed.\r\n");
+    } while(false);
+
+    furi_string_free(header);
+    furi_string_free(input_path);
+    furi_string_free(output_path);
+
+    flipper_format_free(output_file);
+    flipper_format_free(input_file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 static void infrared_cli_list_remote_signals(FuriString* remote_name) {
     if(furi_string_empty(remote_name)) {
         printf("Missing remote name.\r\n");
@@ -433,7 +433,7 @@ InfraredErrorCode infrared_remote_load(InfraredRemote* remote, const char* path)
             break;
         }
 
-        if(version != INFRARED_FILE_VERSION) {
+        if(version != INFRARED_FILE_VERSION && version != INFRARED_SIGNAL_PACKED_FILE_VERSION) {
             error = InfraredErrorCodeWrongFileVersion;
             FURI_LOG_E(TAG, "Wrong file version");
             break;
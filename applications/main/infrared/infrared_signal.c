@@ -5,6 +5,7 @@
 #include <core/check.h>
 #include <infrared_worker.h>
 #include <infrared_transmit.h>
+#include <infrared_raw_pack.h>
 
 #define TAG "InfraredSignal"
 
@@ -135,7 +136,7 @@ static inline InfraredErrorCode
 }
 
 static inline InfraredErrorCode
-    infrared_signal_save_raw(const InfraredRawSignal* raw, FlipperFormat* ff) {
+    infrared_signal_save_raw(const InfraredRawSignal* raw, FlipperFormat* ff, bool packed) {
     furi_assert(raw->timings_size <= MAX_TIMINGS_AMOUNT);
 
     InfraredErrorCode error = InfraredErrorCodeNone;
@@ -156,8 +157,15 @@ static inline InfraredErrorCode
             break;
         }
 
-        if(!flipper_format_write_uint32(
-               ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, raw->timings_size)) {
+        // Falls back to the plain list if it is shorter or the timings can't be packed
+        const InfraredRawPackStatus status =
+            packed ? infrared_raw_pack_write(ff, raw->timings, raw->timings_size) :
+                     InfraredRawPackStatusNotPacked;
+
+        if(status == InfraredRawPackStatusError ||
+           (status == InfraredRawPackStatusNotPacked &&
+            !flipper_format_write_uint32(
+                ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, raw->timings_size))) {
             error = InfraredErrorCodeSignalRawUnableToWriteData;
             break;
         }
@@ -203,47 +211,65 @@ static inline InfraredErrorCode
     return error;
 }
 
+static InfraredErrorCode infrared_signal_read_timings(InfraredRawSignal* raw, FlipperFormat* ff) {
+    // Packed timings are only looked for right after the duty cycle
+    const InfraredRawPackStatus status =
+        infrared_raw_pack_read(ff, MAX_TIMINGS_AMOUNT, &raw->timings, &raw->timings_size);
+
+    if(status == InfraredRawPackStatusOk) {
+        return InfraredErrorCodeNone;
+    } else if(status == InfraredRawPackStatusTooLong) {
+        return InfraredErrorCodeSignalRawUnableToReadTooLongData;
+    } else if(status == InfraredRawPackStatusError) {
+        return InfraredErrorCodeSignalRawUnableToReadData;
+    }
+
+    uint32_t size;
+    if(!flipper_format_get_value_count(ff, INFRARED_SIGNAL_DATA_KEY, &size)) {
+        return InfraredErrorCodeSignalRawUnableToReadTimingsSize;
+    }
+
+    if(size > MAX_TIMINGS_AMOUNT) {
+        return InfraredErrorCodeSignalRawUnableToReadTooLongData;
+    }
+
+    raw->timings = malloc(sizeof(uint32_t) * size);
+    raw->timings_size = size;
+
+    if(!flipper_format_read_uint32(ff, INFRARED_SIGNAL_DATA_KEY, raw->timings, size)) {
+        return InfraredErrorCodeSignalRawUnableToReadData;
+    }
+
+    return InfraredErrorCodeNone;
+}
+
 static inline InfraredErrorCode
     infrared_signal_read_raw(InfraredSignal* signal, FlipperFormat* ff) {
     InfraredErrorCode error = InfraredErrorCodeNone;
+    InfraredRawSignal raw = {0};
 
     do {
-        uint32_t frequency;
-        if(!flipper_format_read_uint32(ff, INFRARED_SIGNAL_FREQUENCY_KEY, &frequency, 1)) {
+        if(!flipper_format_read_uint32(ff, INFRARED_SIGNAL_FREQUENCY_KEY, &raw.frequency, 1)) {
             error = InfraredErrorCodeSignalRawUnableToReadFrequency;
             break;
         }
 
-        float duty_cycle;
-        if(!flipper_format_read_float(ff, INFRARED_SIGNAL_DUTY_CYCLE_KEY, &duty_cycle, 1)) {
+        if(!flipper_format_read_float(ff, INFRARED_SIGNAL_DUTY_CYCLE_KEY, &raw.duty_cycle, 1)) {
             error = InfraredErrorCodeSignalRawUnableToReadDutyCycle;
             break;
         }
 
-        uint32_t timings_size;
-        if(!flipper_format_get_value_count(ff, INFRARED_SIGNAL_DATA_KEY, &timings_size)) {
-            error = InfraredErrorCodeSignalRawUnableToReadTimingsSize;
-            break;
-        }
-
-        if(timings_size > MAX_TIMINGS_AMOUNT) {
-            error = InfraredErrorCodeSignalRawUnableToReadTooLongData;
-            break;
-        }
-
-        uint32_t* timings = malloc(sizeof(uint32_t) * timings_size);
-        if(!flipper_format_read_uint32(ff, INFRARED_SIGNAL_DATA_KEY, timings, timings_size)) {
-            error = InfraredErrorCodeSignalRawUnableToReadData;
-            free(timings);
-            break;
-        }
-
-        infrared_signal_set_raw_signal(signal, timings, timings_size, frequency, duty_cycle);
-        free(timings);
+        error = infrared_signal_read_timings(&raw, ff);
+        if(INFRARED_ERROR_PRESENT(error)) break;
 
-        error = InfraredErrorCodeNone;
+        // Timings are handed over as is, without an intermediate copy
+        infrared_signal_clear_timings(signal);
+        signal->is_raw = true;
+        signal->payload.raw = raw;
+        raw.timings = NULL;
     } while(false);
 
+    free(raw.timings);
     return error;
 }
 
@@ -343,15 +369,18 @@ const InfraredMessage* infrared_signal_get_message(const InfraredSignal* signal)
     return &signal->payload.message;
 }
 
-InfraredErrorCode
-    infrared_signal_save(const InfraredSignal* signal, FlipperFormat* ff, const char* name) {
+static InfraredErrorCode infrared_signal_save_ext(
+    const InfraredSignal* signal,
+    FlipperFormat* ff,
+    const char* name,
+    bool packed) {
     InfraredErrorCode error = InfraredErrorCodeNone;
 
     if(!flipper_format_write_comment_cstr(ff, "") ||
        !flipper_format_write_string_cstr(ff, INFRARED_SIGNAL_NAME_KEY, name)) {
         error = InfraredErrorCodeFileOperationFailed;
     } else if(signal->is_raw) {
-        error = infrared_signal_save_raw(&signal->payload.raw, ff);
+        error = infrared_signal_save_raw(&signal->payload.raw, ff, packed);
     } else {
         error = infrared_signal_save_message(&signal->payload.message, ff);
     }
@@ -359,6 +388,18 @@ InfraredErrorCode
     return error;
 }
 
+InfraredErrorCode
+    infrared_signal_save(const InfraredSignal* signal, FlipperFormat* ff, const char* name) {
+    return infrared_signal_save_ext(signal, ff, name, false);
+}
+
+InfraredErrorCode infrared_signal_save_packed(
+    const InfraredSignal* signal,
+    FlipperFormat* ff,
+    const char* name) {
+    return infrared_signal_save_ext(signal, ff, name, true);
+}
+
 InfraredErrorCode
     infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString* name) {
     InfraredErrorCode error = InfraredErrorCodeNone;
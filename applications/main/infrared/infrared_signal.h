@@ -12,6 +12,13 @@
 #include <flipper_format/flipper_format.h>
 #include <infrared/encoder_decoder/infrared.h>
 
+/**
+ * @brief Version of the infrared files that may contain packed raw timings.
+ *
+ * Files without packed timings keep version 1, so that older firmware can read them.
+ */
+#define INFRARED_SIGNAL_PACKED_FILE_VERSION (2)
+
 /**
  * @brief InfraredSignal opaque type declaration.
  */
@@ -210,6 +217,23 @@ InfraredErrorCode infrared_signal_search_by_index_and_read(
 InfraredErrorCode
     infrared_signal_save(const InfraredSignal* signal, FlipperFormat* ff, const char* name);
 
+/**
+ * @brief Save a signal contained in an InfraredSignal instance, packing raw timings.
+ *
+ * Same as infrared_signal_save(), but raw timings are written under the `packed` key
+ * whenever it is shorter than the decimal list. Firmware before packed timings support
+ * can't read such signals, so the file header must carry INFRARED_SIGNAL_PACKED_FILE_VERSION.
+ *
+ * @param[in] signal pointer to the instance holding the signal to be saved.
+ * @param[in,out] ff pointer to the FlipperFormat file instance to write to.
+ * @param[in] name pointer to a zero-terminated string contating the name of the signal.
+ * @returns InfraredErrorCodeNone if a signal was successfully saved, otherwise error code
+ */
+InfraredErrorCode infrared_signal_save_packed(
+    const InfraredSignal* signal,
+    FlipperFormat* ff,
+    const char* name);
+
 /**
  * @brief Transmit a signal contained in an InfraredSignal instance.
  *
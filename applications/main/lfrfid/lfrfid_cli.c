@@ -12,6 +12,7 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/lfrfid_raw_analyzer.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
 
 static void lfrfid_cli(Cli* cli, FuriString* args, void* context);
@@ -32,6 +33,8 @@ static void lfrfid_cli_print_usage(void) {
         "rfid raw_emulate <filename>                   - emulate raw data (not very useful, but helps debug protocols)\r\n");
     printf(
         "rfid raw_analyze <filename>                   - outputs raw data to the cli and tries to decode it (useful for protocol development)\r\n");
+    printf(
+        "rfid raw_scan <filename>                      - decodes whole raw file at full speed, lists every protocol hit\r\n");
 }
 
 typedef struct {
@@ -386,6 +389,82 @@ static void lfrfid_cli_raw_analyze(Cli* cli, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void lfrfid_cli_raw_scan_callback(const LFRFIDRawAnalyzerHit* hit, void* context) {
+    ProtocolDict* dict = context;
+
+    printf(
+        "%10lu.%03lu ms  #%-8zu %-12s [",
+        (uint32_t)(hit->timestamp / 1000),
+        (uint32_t)(hit->timestamp % 1000),
+        hit->pair_index,
+        protocol_dict_get_name(dict, hit->protocol));
+    for(size_t i = 0; i < hit->data_size; i++) {
+        printf("%02X", hit->data[i]);
+    }
+    printf("] %lu/%lu%s\r\n", hit->repeat_count, hit->validate_count, hit->validated ? " OK" : "");
+}
+
+static void lfrfid_cli_raw_scan(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+    FuriString* filepath = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(dict);
+
+    do {
+        float frequency = 0;
+        float duty_cycle = 0;
+
+        if(!args_read_probably_quoted_string_and_trim(args, filepath)) {
+            lfrfid_cli_print_usage();
+            break;
+        }
+
+        if(!lfrfid_raw_file_open_read(file, furi_string_get_cstr(filepath))) {
+            printf("Failed to open file\r\n");
+            break;
+        }
+
+        if(!lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) {
+            printf("Invalid header\r\n");
+            break;
+        }
+
+        lfrfid_raw_analyzer_set_callback(analyzer, lfrfid_cli_raw_scan_callback, dict);
+
+        uint32_t start_tick = furi_get_tick();
+        bool file_valid = lfrfid_raw_analyzer_process_file(analyzer, file);
+        uint32_t total_time = furi_get_tick() - start_tick;
+
+        if(!file_valid) {
+            printf("Failed to read pair, results are partial\r\n");
+        }
+
+        const LFRFIDRawAnalyzerStats* stats = lfrfid_raw_analyzer_get_stats(analyzer);
+        uint32_t decode_time = stats->process_time ? (uint32_t)stats->process_time : 1;
+
+        printf("   Frequency: %f\r\n", (double)frequency);
+        printf("  Duty Cycle: %f\r\n", (double)duty_cycle);
+        printf("       Pairs: %zu\r\n", stats->pair_count);
+        printf("       Warns: %zu\r\n", stats->warn_count);
+        printf("        Hits: %zu (%zu validated)\r\n", stats->hit_count, stats->validated_count);
+        printf("Capture time: %lu ms\r\n", (uint32_t)(stats->capture_time / 1000));
+        printf(" Decode time: %lu ms\r\n", decode_time / 1000);
+        printf("  Total time: %lu ms\r\n", total_time);
+        printf(
+            "  Throughput: %lu pairs/s, x%lu real time\r\n",
+            (uint32_t)((uint64_t)stats->pair_count * 1000000 / decode_time),
+            (uint32_t)(stats->capture_time / decode_time));
+    } while(false);
+
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(dict);
+    lfrfid_raw_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(filepath);
+}
+
 static void lfrfid_cli_raw_read_callback(LFRFIDWorkerReadRawResult result, void* context) {
     furi_assert(context);
     FuriEventFlag* event = context;
@@ -571,6 +650,8 @@ static void lfrfid_cli(Cli* cli, FuriString* args, void* context) {
         lfrfid_cli_raw_emulate(cli, args);
     } else if(furi_string_cmp_str(cmd, "raw_analyze") == 0) {
         lfrfid_cli_raw_analyze(cli, args);
+    } else if(furi_string_cmp_str(cmd, "raw_scan") == 0) {
+        lfrfid_cli_raw_scan(cli, args);
     } else {
         lfrfid_cli_print_usage();
     }
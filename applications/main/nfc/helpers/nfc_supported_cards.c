@@ -17,6 +17,11 @@
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH  APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
 
+#define NFC_SUPPORTED_CARDS_INDEX_PATH     APP_DATA_PATH(".plugins.idx")
+#define NFC_SUPPORTED_CARDS_INDEX_MAGIC    (0x49435346U) // "FSCI"
+#define NFC_SUPPORTED_CARDS_INDEX_VERSION  (1)
+#define NFC_SUPPORTED_CARDS_INDEX_SIZE_MAX (8 * 1024)
+
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
     NfcSupportedCardsPluginFeatureHasRead = (1U << 1),
@@ -25,10 +30,33 @@ typedef enum {
 
 typedef struct {
     FuriString* name;
-    NfcProtocol protocol;
+    NfcProtocol protocol; /**< NfcProtocolInvalid if the file is not a valid plugin */
     NfcSupportedCardsPluginFeature feature;
+    uint32_t timestamp;
+    uint32_t size;
 } NfcSupportedCardsPluginCache;
 
+/*
+ * Plugin index file: header followed by a record and the name (without suffix)
+ * for every plugin file. Invalid plugins are kept too, so they are not loaded again.
+ */
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t plugin_api_version;
+    uint16_t firmware_api_version_major;
+    uint16_t firmware_api_version_minor;
+    uint16_t plugins_num;
+} NfcSupportedCardsIndexHeader;
+
+typedef struct FURI_PACKED {
+    uint32_t timestamp;
+    uint32_t size;
+    uint8_t protocol;
+    uint8_t feature;
+    uint8_t name_len;
+} NfcSupportedCardsIndexRecord;
+
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
 
 typedef enum {
@@ -42,6 +70,7 @@ typedef struct {
     Storage* storage;
     File* directory;
     char file_name[256];
+    FileInfo file_info;
     FlipperApplication* app;
 } NfcSupportedCardsLoadContext;
 
@@ -64,16 +93,21 @@ NfcSupportedCards* nfc_supported_cards_alloc(void) {
     return instance;
 }
 
-void nfc_supported_cards_free(NfcSupportedCards* instance) {
-    furi_assert(instance);
-
+static void nfc_supported_cards_plugin_cache_reset(NfcSupportedCardsPluginCache_t cache_arr) {
     NfcSupportedCardsPluginCache_it_t iter;
-    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+    for(NfcSupportedCardsPluginCache_it(iter, cache_arr);
         !NfcSupportedCardsPluginCache_end_p(iter);
         NfcSupportedCardsPluginCache_next(iter)) {
         NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
         furi_string_free(plugin_cache->name);
     }
+    NfcSupportedCardsPluginCache_reset(cache_arr);
+}
+
+void nfc_supported_cards_free(NfcSupportedCards* instance) {
+    furi_assert(instance);
+
+    nfc_supported_cards_plugin_cache_reset(instance->plugins_cache_arr);
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
     composite_api_resolver_free(instance->api_resolver);
@@ -140,35 +174,176 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
     return plugin;
 }
 
-static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
-    NfcSupportedCardsLoadContext* instance,
-    const ElfApiInterface* api_interface) {
-    const NfcSupportedCardsPlugin* plugin = NULL;
+static void nfc_supported_cards_index_header_fill(
+    NfcSupportedCardsIndexHeader* header,
+    const ElfApiInterface* api_interface,
+    size_t plugins_num) {
+    header->magic = NFC_SUPPORTED_CARDS_INDEX_MAGIC;
+    header->version = NFC_SUPPORTED_CARDS_INDEX_VERSION;
+    header->plugin_api_version = NFC_SUPPORTED_CARD_PLUGIN_API_VERSION;
+    header->firmware_api_version_major = api_interface->api_version_major;
+    header->firmware_api_version_minor = api_interface->api_version_minor;
+    header->plugins_num = plugins_num;
+}
+
+static bool nfc_supported_cards_index_load(
+    Storage* storage,
+    const ElfApiInterface* api_interface,
+    NfcSupportedCardsPluginCache_t index_arr) {
+    bool loaded = false;
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = NULL;
 
     do {
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        // Index is small, read it at once
+        const size_t file_size = storage_file_size(file);
+        if(file_size < sizeof(NfcSupportedCardsIndexHeader) ||
+           file_size > NFC_SUPPORTED_CARDS_INDEX_SIZE_MAX)
+            break;
+
+        buffer = malloc(file_size);
+        if(storage_file_read(file, buffer, file_size) != file_size) break;
+
+        NfcSupportedCardsIndexHeader header;
+        NfcSupportedCardsIndexHeader header_expected;
+        memcpy(&header, buffer, sizeof(header));
+        nfc_supported_cards_index_header_fill(
+            &header_expected, api_interface, header.plugins_num);
+        if(memcmp(&header, &header_expected, sizeof(header)) != 0) break;
+
+        size_t offset = sizeof(header);
+        size_t plugins_num = 0;
+        while(plugins_num < header.plugins_num) {
+            NfcSupportedCardsIndexRecord record;
+            if(offset + sizeof(record) > file_size) break;
+            memcpy(&record, &buffer[offset], sizeof(record));
+            offset += sizeof(record);
+            if(offset + record.name_len > file_size) break;
+
+            NfcSupportedCardsPluginCache plugin_cache = {
+                .name = furi_string_alloc(),
+                .protocol = record.protocol,
+                .feature = record.feature,
+                .timestamp = record.timestamp,
+                .size = record.size,
+            };
+            furi_string_set_strn(
+                plugin_cache.name, (const char*)&buffer[offset], record.name_len);
+            offset += record.name_len;
+
+            NfcSupportedCardsPluginCache_push_back(index_arr, plugin_cache);
+            plugins_num++;
+        }
+
+        loaded = (plugins_num == header.plugins_num) && (offset == file_size);
+    } while(false);
+
+    if(!loaded) {
+        nfc_supported_cards_plugin_cache_reset(index_arr);
+    }
+
+    free(buffer);
+    storage_file_free(file);
+
+    return loaded;
+}
+
+static void nfc_supported_cards_index_save(
+    Storage* storage,
+    const ElfApiInterface* api_interface,
+    NfcSupportedCardsPluginCache_t cache_arr) {
+    File* file = storage_file_alloc(storage);
+
+    do {
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        NfcSupportedCardsIndexHeader header;
+        nfc_supported_cards_index_header_fill(
+            &header, api_interface, NfcSupportedCardsPluginCache_size(cache_arr));
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        bool success = true;
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            NfcSupportedCardsIndexRecord record = {
+                .timestamp = plugin_cache->timestamp,
+                .size = plugin_cache->size,
+                .protocol = plugin_cache->protocol,
+                .feature = plugin_cache->feature,
+                .name_len = furi_string_size(plugin_cache->name),
+            };
+            success = storage_file_write(file, &record, sizeof(record)) == sizeof(record) &&
+                      storage_file_write(
+                          file, furi_string_get_cstr(plugin_cache->name), record.name_len) ==
+                          record.name_len;
+            if(!success) break;
+        }
+        if(!success) break;
+
+        FURI_LOG_D(TAG, "Index saved");
+    } while(false);
+
+    storage_file_free(file);
+}
+
+static bool nfc_supported_cards_get_next_plugin_file(NfcSupportedCardsLoadContext* instance) {
+    bool file_found = false;
+
+    while(!file_found) {
         if(!storage_file_is_open(instance->directory)) break;
         if(!storage_dir_read(
-               instance->directory, NULL, instance->file_name, sizeof(instance->file_name)))
+               instance->directory,
+               &instance->file_info,
+               instance->file_name,
+               sizeof(instance->file_name)))
             break;
 
         const size_t suffix_len = strlen(NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
         const size_t file_name_len = strlen(instance->file_name);
-        if(file_name_len <= suffix_len) break;
+        // Name length is stored in a byte in the index
+        if(file_name_len <= suffix_len || file_name_len - suffix_len > UINT8_MAX) continue;
 
         size_t suffix_start_pos = file_name_len - suffix_len;
         if(memcmp(
                &instance->file_name[suffix_start_pos],
                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX,
                suffix_len) != 0) //-V1051
-            break;
+            continue;
 
         // Trim suffix from file_name to save memory. The suffix will be concatenated on plugin load.
         instance->file_name[suffix_start_pos] = '\0';
+        file_found = true;
+    }
+
+    return file_found;
+}
 
-        plugin = nfc_supported_cards_get_plugin(instance, instance->file_name, api_interface);
-    } while(plugin == NULL); //-V654
+static const NfcSupportedCardsPluginCache*
+    nfc_supported_cards_index_find(NfcSupportedCardsPluginCache_t index_arr, const char* name) {
+    const NfcSupportedCardsPluginCache* found = NULL;
 
-    return plugin;
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, index_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_cref(iter);
+        if(furi_string_equal_str(plugin_cache->name, name)) {
+            found = plugin_cache;
+            break;
+        }
+    }
+
+    return found;
 }
 
 void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
@@ -180,37 +355,82 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             break;
 
         instance->load_context = nfc_supported_cards_load_context_alloc();
-
-        while(true) {
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin =
-                nfc_supported_cards_get_next_plugin(instance->load_context, api_interface);
-            if(plugin == NULL) break; //-V547
-
-            NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
-            plugin_cache.name = furi_string_alloc_set(instance->load_context->file_name);
-            plugin_cache.protocol = plugin->protocol;
-            if(plugin->verify) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
-            }
-            if(plugin->read) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
-            }
-            if(plugin->parse) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+        NfcSupportedCardsLoadContext* load_context = instance->load_context;
+        const ElfApiInterface* api_interface = composite_api_resolver_get(instance->api_resolver);
+
+        // Plugins are only loaded if they are not in the index or have changed since
+        NfcSupportedCardsPluginCache_t index_arr;
+        NfcSupportedCardsPluginCache_init(index_arr);
+        bool index_changed =
+            !nfc_supported_cards_index_load(load_context->storage, api_interface, index_arr);
+        size_t plugins_loaded = 0;
+        size_t plugins_indexed = 0;
+
+        FuriString* plugin_path = furi_string_alloc();
+        while(nfc_supported_cards_get_next_plugin_file(load_context)) {
+            NfcSupportedCardsPluginCache plugin_cache = {
+                .name = furi_string_alloc_set(load_context->file_name),
+                .protocol = NfcProtocolInvalid,
+                .size = load_context->file_info.size,
+            };
+
+            furi_string_printf(
+                plugin_path,
+                "%s/%s%s",
+                NFC_SUPPORTED_CARDS_PLUGINS_PATH,
+                load_context->file_name,
+                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
+            storage_common_timestamp(
+                load_context->storage, furi_string_get_cstr(plugin_path), &plugin_cache.timestamp);
+
+            const NfcSupportedCardsPluginCache* indexed =
+                nfc_supported_cards_index_find(index_arr, load_context->file_name);
+            if(indexed && indexed->timestamp == plugin_cache.timestamp &&
+               indexed->size == plugin_cache.size) {
+                plugin_cache.protocol = indexed->protocol;
+                plugin_cache.feature = indexed->feature;
+                plugins_indexed++;
+            } else {
+                const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
+                    load_context, load_context->file_name, api_interface);
+                if(plugin) {
+                    plugin_cache.protocol = plugin->protocol;
+                    if(plugin->verify) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
+                    }
+                    if(plugin->read) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
+                    }
+                    if(plugin->parse) {
+                        plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+                    }
+                }
+                index_changed = true;
             }
+
+            if(plugin_cache.protocol != NfcProtocolInvalid) plugins_loaded++;
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
+        furi_string_free(plugin_path);
+
+        // Plugins removed since the index was saved
+        if(NfcSupportedCardsPluginCache_size(index_arr) != plugins_indexed) {
+            index_changed = true;
+        }
+        if(index_changed) {
+            nfc_supported_cards_index_save(
+                load_context->storage, api_interface, instance->plugins_cache_arr);
+        }
 
+        nfc_supported_cards_plugin_cache_reset(index_arr);
+        NfcSupportedCardsPluginCache_clear(index_arr);
         nfc_supported_cards_load_context_free(instance->load_context);
 
-        size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
         if(plugins_loaded == 0) {
             FURI_LOG_D(TAG, "Plugins not found");
             instance->load_state = NfcSupportedCardsLoadStateFail;
         } else {
-            FURI_LOG_D(TAG, "Loaded %zu plugins", plugins_loaded);
+            FURI_LOG_D(TAG, "Loaded %zu plugins, %zu from index", plugins_loaded, plugins_indexed);
             instance->load_state = NfcSupportedCardsLoadStateSuccess;
         }
 
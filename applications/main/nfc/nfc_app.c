@@ -48,6 +48,8 @@ NfcApp* nfc_app_alloc(void) {
         instance->view_dispatcher, nfc_back_event_callback);
 
     instance->nfc = nfc_alloc();
+    // Kept for the app lifetime, so that adaptive scans use the detection history
+    instance->scanner = nfc_scanner_alloc(instance->nfc);
 
     instance->detected_protocols = nfc_detected_protocols_alloc();
     instance->felica_auth = felica_auth_alloc();
@@ -140,6 +142,7 @@ void nfc_app_free(NfcApp* instance) {
         rpc_system_app_set_callback(instance->rpc_ctx, NULL, NULL);
     }
 
+    nfc_scanner_free(instance->scanner);
     nfc_free(instance->nfc);
 
     nfc_detected_protocols_free(instance->detected_protocols);
@@ -3,15 +3,23 @@
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/hex.h>
+#include <lib/toolbox/keys_dict.h>
+#include <lib/toolbox/stream/buffered_file_stream.h>
+#include <lib/nfc/helpers/mfkey32.h>
 
 #include <furi_hal_nfc.h>
+#include <storage/storage.h>
 
 #define FLAG_EVENT (1 << 10)
 
+#define NFC_CLI_MFKEY32_LOG_PATH          EXT_PATH("nfc/.mfkey32.log")
+#define NFC_CLI_MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
+
 static void nfc_cli_print_usage(void) {
     printf("Usage:\r\n");
     printf("nfc <cmd>\r\n");
     printf("Cmd list:\r\n");
+    printf("\tmfkey32 [<log_path>]\t - recover keys from reader nonces log\r\n");
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\tfield\t - turn field on\r\n");
     }
@@ -40,6 +48,109 @@ static void nfc_cli_field(Cli* cli, FuriString* args) {
     furi_hal_nfc_release();
 }
 
+typedef struct {
+    Cli* cli;
+    int32_t percent;
+} NfcCliMfkey32Context;
+
+static bool nfc_cli_mfkey32_progress_callback(float progress, void* context) {
+    NfcCliMfkey32Context* ctx = context;
+
+    if(cli_cmd_interrupt_received(ctx->cli)) return false;
+
+    int32_t percent = progress * 100;
+    if(percent != ctx->percent) {
+        ctx->percent = percent;
+        printf("\r%3ld%%", percent);
+        fflush(stdout);
+    }
+
+    return true;
+}
+
+static void nfc_cli_mfkey32(Cli* cli, FuriString* args) {
+    FuriString* path = furi_string_alloc();
+    if(!args_read_probably_quoted_string_and_trim(args, path)) {
+        furi_string_set(path, NFC_CLI_MFKEY32_LOG_PATH);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    KeysDict* dict = NULL;
+
+    do {
+        if(!buffered_file_stream_open(
+               stream, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            printf("Failed to open %s\r\n", furi_string_get_cstr(path));
+            break;
+        }
+
+        dict = keys_dict_alloc(
+            NFC_CLI_MF_CLASSIC_DICT_USER_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+
+        // Sector and key type pairs already recovered, the log may repeat them
+        uint64_t recovered[MfClassicKeyTypeB + 1] = {};
+        size_t keys_added = 0;
+
+        while(stream_read_line(stream, line)) {
+            Mfkey32Nonces nonces;
+            uint8_t sector_num = 0;
+            MfClassicKeyType key_type = MfClassicKeyTypeA;
+            if(!mfkey32_parse_log_line(
+                   furi_string_get_cstr(line), &nonces, &sector_num, &key_type)) {
+                continue;
+            }
+            if(sector_num < 64 && (recovered[key_type] & (1ULL << sector_num))) continue;
+
+            printf(
+                "Sector %u key %c\r\n", sector_num, key_type == MfClassicKeyTypeA ? 'A' : 'B');
+
+            NfcCliMfkey32Context context = {.cli = cli, .percent = -1};
+            MfClassicKey key = {};
+            uint32_t start = furi_get_tick();
+            Mfkey32Error error = mfkey32_recover(
+                &nonces,
+                MFKEY32_DEFAULT_RAM_BUDGET,
+                &key,
+                nfc_cli_mfkey32_progress_callback,
+                &context);
+            uint32_t elapsed = furi_get_tick() - start;
+
+            if(error == Mfkey32ErrorNone) {
+                printf("\rKey: ");
+                for(size_t i = 0; i < sizeof(MfClassicKey); i++) {
+                    printf("%02X", key.data[i]);
+                }
+                printf(" (%lus)\r\n", elapsed / 1000);
+
+                if(sector_num < 64) recovered[key_type] |= 1ULL << sector_num;
+                if(!keys_dict_is_key_present(dict, key.data, sizeof(MfClassicKey))) {
+                    keys_dict_add_key(dict, key.data, sizeof(MfClassicKey));
+                    keys_added++;
+                }
+            } else if(error == Mfkey32ErrorNotFound) {
+                printf("\rKey not found (%lus)\r\n", elapsed / 1000);
+            } else if(error == Mfkey32ErrorMemory) {
+                printf("\rNot enough memory\r\n");
+                break;
+            } else {
+                printf("\rCancelled\r\n");
+                break;
+            }
+        }
+
+        printf("%zu new keys added to user dict\r\n", keys_added);
+    } while(false);
+
+    if(dict) keys_dict_free(dict);
+    furi_string_free(line);
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(path);
+}
+
 static void nfc_cli(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     FuriString* cmd;
@@ -50,6 +161,10 @@ static void nfc_cli(Cli* cli, FuriString* args, void* context) {
             nfc_cli_print_usage();
             break;
         }
+        if(furi_string_cmp_str(cmd, "mfkey32") == 0) {
+            nfc_cli_mfkey32(cli, args);
+            break;
+        }
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "field") == 0) {
                 nfc_cli_field(cli, args);
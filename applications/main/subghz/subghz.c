@@ -133,6 +133,9 @@ SubGhz* subghz_alloc(void) {
     //init threshold rssi
     subghz->threshold_rssi = subghz_threshold_rssi_alloc();
 
+    // Binary RAW files are opt-in, older firmware and tools only read text
+    subghz->raw_encoding = SubGhzRawEncodingText;
+
     subghz_unlock(subghz);
     subghz_rx_key_state_set(subghz, SubGhzRxKeyStateIDLE);
     subghz->history = subghz_history_alloc();
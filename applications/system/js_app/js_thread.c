@@ -2,6 +2,8 @@
 #include <toolbox/path.h>
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/strint.h>
+#include <toolbox/crc.h>
+#include <toolbox/version.h>
 #include <loader/firmware_api/firmware_api.h>
 #include <flipper_application/api_hashtable/api_hashtable.h>
 #include <flipper_application/plugins/composite_resolver.h>
@@ -13,6 +15,8 @@
 
 #define TAG "JS"
 
+#define JS_BCODE_CACHE_PATH EXT_PATH(".js_cache")
+
 struct JsThread {
     FuriThread* thread;
     FuriString* path;
@@ -235,6 +239,14 @@ static void js_dump_write_callback(void* ctx, const char* format, ...) {
 }
 #endif
 
+static uint32_t js_bcode_cache_build_id(void) {
+    // Bytecode depends on the interpreter, which only changes with the firmware
+    const char* githash = version_get_githash(NULL);
+    const char* builddate = version_get_builddate(NULL);
+    uint32_t id = crc32_update(0xFFFFFFFF, githash, strlen(githash));
+    return crc32_update(id, builddate, strlen(builddate));
+}
+
 static int32_t js_thread(void* arg) {
     JsThread* worker = arg;
     worker->resolver = composite_api_resolver_alloc();
@@ -291,6 +303,13 @@ static int32_t js_thread(void* arg) {
 
     mjs_set_exec_flags_poller(mjs, js_exit_flag_poll);
 
+    // Keep parsed bytecode to skip parsing on the next run of the same firmware build
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_simply_mkdir(storage, JS_BCODE_CACHE_PATH)) {
+        mjs_set_jsc_cache(mjs, JS_BCODE_CACHE_PATH, js_bcode_cache_build_id());
+    }
+    furi_record_close(RECORD_STORAGE);
+
     mjs_err_t err = mjs_exec_file(mjs, furi_string_get_cstr(worker->path), NULL);
 
 #ifdef JS_DEBUG
@@ -7,6 +7,7 @@
 LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
+#define FURI_LOG_LINE_SIZE     (64U)
 
 typedef struct {
     FuriLogLevel log_level;
@@ -107,6 +108,32 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
+static void furi_log_vprintf(const char* format, va_list args) {
+    // Short lines are formatted on the stack, so that logging doesn't touch the heap
+    char line[FURI_LOG_LINE_SIZE];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int size = vsnprintf(line, sizeof(line), format, args_copy);
+    va_end(args_copy);
+
+    if(size < 0) return;
+
+    if((size_t)size < sizeof(line)) {
+        furi_log_puts(line);
+    } else {
+        FuriString* string = furi_string_alloc_vprintf(format, args);
+        furi_log_puts(furi_string_get_cstr(string));
+        furi_string_free(string);
+    }
+}
+
+static void furi_log_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_log_vprintf(format, args);
+    va_end(args);
+}
+
 void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
     do {
         if(level > furi_log.log_level) {
@@ -118,8 +145,6 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
             break;
         }
 
-        FuriString* string = furi_string_alloc();
-
         const char* color = _FURI_LOG_CLR_RESET;
         const char* log_letter = " ";
         switch(level) {
@@ -148,19 +173,14 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
         }
 
         // Timestamp
-        furi_string_printf(
-            string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
-        furi_log_puts(furi_string_get_cstr(string));
-        furi_string_reset(string);
+        furi_log_printf(
+            "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, furi_get_tick(), color, log_letter, tag);
 
         va_list args;
         va_start(args, format);
-        furi_string_vprintf(string, format, args);
+        furi_log_vprintf(format, args);
         va_end(args);
 
-        furi_log_puts(furi_string_get_cstr(string));
-        furi_string_free(string);
-
         furi_log_puts("\r\n");
 
         furi_mutex_release(furi_log.mutex);
@@ -170,16 +190,11 @@ void furi_log_print_format(FuriLogLevel level, const char* tag, const char* form
 void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
     if(level <= furi_log.log_level &&
        furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
         va_list args;
         va_start(args, format);
-        furi_string_vprintf(string, format, args);
+        furi_log_vprintf(format, args);
         va_end(args);
 
-        furi_log_puts(furi_string_get_cstr(string));
-        furi_string_free(string);
-
         furi_mutex_release(furi_log.mutex);
     }
 }
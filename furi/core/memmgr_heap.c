@@ -123,13 +123,18 @@ DICT_DEF2( //-V1048
     MemmgrHeapAllocDict_t,
     DICT_OPLIST(MemmgrHeapAllocDict))
 
+/* Allocation count of the traced threads */
+DICT_DEF2(MemmgrHeapAllocCountDict, uint32_t, uint32_t) //-V1048
+
 /* Thread allocation tracing storage */
 static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
+static MemmgrHeapAllocCountDict_t memmgr_heap_alloc_count_dict = {0};
 static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
 
 /* Initialize tracing storage on start */
 void memmgr_heap_init(void) {
     MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    MemmgrHeapAllocCountDict_init(memmgr_heap_alloc_count_dict);
 }
 
 void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
@@ -141,6 +146,7 @@ void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
         MemmgrHeapAllocDict_init(alloc_dict);
         MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
         MemmgrHeapAllocDict_clear(alloc_dict);
+        MemmgrHeapAllocCountDict_set_at(memmgr_heap_alloc_count_dict, (uint32_t)thread_id, 0);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -151,6 +157,7 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
     {
         memmgr_heap_thread_trace_depth++;
         furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
+        MemmgrHeapAllocCountDict_erase(memmgr_heap_alloc_count_dict, (uint32_t)thread_id);
         memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
@@ -188,6 +195,22 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     return leftovers;
 }
 
+size_t memmgr_heap_get_thread_alloc_count(FuriThreadId thread_id) {
+    size_t count = MEMMGR_HEAP_UNKNOWN;
+    vTaskSuspendAll();
+    {
+        memmgr_heap_thread_trace_depth++;
+        uint32_t* alloc_count =
+            MemmgrHeapAllocCountDict_get(memmgr_heap_alloc_count_dict, (uint32_t)thread_id);
+        if(alloc_count) {
+            count = *alloc_count;
+        }
+        memmgr_heap_thread_trace_depth--;
+    }
+    (void)xTaskResumeAll();
+    return count;
+}
+
 #undef traceMALLOC
 static inline void traceMALLOC(void* pointer, size_t size) {
     FuriThreadId thread_id = furi_thread_get_current_id();
@@ -198,6 +221,11 @@ static inline void traceMALLOC(void* pointer, size_t size) {
         if(alloc_dict) {
             MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
         }
+        uint32_t* alloc_count =
+            MemmgrHeapAllocCountDict_get(memmgr_heap_alloc_count_dict, (uint32_t)thread_id);
+        if(alloc_count) {
+            (*alloc_count)++;
+        }
         memmgr_heap_thread_trace_depth--;
     }
 }
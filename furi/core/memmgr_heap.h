@@ -34,6 +34,14 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id);
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 
+/** Memmgr heap get number of allocations made by the thread since tracking was enabled
+ *
+ * @param      thread_id  - thread id to track
+ *
+ * @return     allocation count, MEMMGR_HEAP_UNKNOWN if the thread is not tracked
+ */
+size_t memmgr_heap_get_thread_alloc_count(FuriThreadId thread_id);
+
 /** Memmgr heap get the max contiguous block size on the heap
  *
  * @return     size_t max contiguous block size
@@ -1,6 +1,7 @@
 #include "elf_file.h"
 #include "elf_file_i.h"
 
+#include <furi_hal.h>
 #include <storage/storage.h>
 #include <elf.h>
 #include "elf_api_interface.h"
@@ -14,6 +15,16 @@
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
 
+/* Default read windows over the tables used during load, about 11KB in total */
+#define ELF_SECTION_TABLE_CACHE_SIZE 2048
+#define ELF_SECTION_NAMES_CACHE_SIZE 1024
+#define ELF_SYMBOL_TABLE_CACHE_SIZE 4096
+#define ELF_SYMBOL_NAMES_CACHE_SIZE 4096
+#define ELF_RELOCATION_CHUNK_COUNT 64
+
+/* String tables larger than this are read through the windows */
+#define ELF_STRING_TABLE_MAX_SIZE 16384
+
 // #define ELF_DEBUG_LOG 1
 
 #ifndef ELF_DEBUG_LOG
@@ -55,6 +66,122 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
     AddressCache_set_at(cache, symEntry, symAddr);
 }
 
+static void elf_read_cache_reset(ELFReadCache* cache) {
+    if(cache->data) {
+        free(cache->data);
+    }
+    memset(cache, 0, sizeof(ELFReadCache));
+}
+
+static void elf_read_cache_init(ELFReadCache* cache, off_t start, size_t size, size_t capacity) {
+    elf_read_cache_reset(cache);
+    cache->region_start = start;
+    cache->region_end = start + size;
+    cache->capacity = MIN(size, capacity);
+}
+
+static bool elf_read_cache_contains(ELFReadCache* cache, off_t offset, size_t size) {
+    return offset >= cache->window_start &&
+           offset + (off_t)size <= cache->window_start + (off_t)cache->window_size;
+}
+
+static bool elf_read_cache_fill(File* fd, ELFReadCache* cache, off_t offset, size_t size) {
+    // Reads that don't fit the window go straight to the file
+    if(size > cache->capacity || offset < cache->region_start ||
+       offset + (off_t)size > cache->region_end) {
+        return false;
+    }
+
+    if(!cache->data) {
+        // Caches are optional, leave the memory to the sections
+        if(memmgr_heap_get_max_free_block() < cache->capacity * 4) {
+            cache->capacity = 0;
+            return false;
+        }
+        cache->data = malloc(cache->capacity);
+    }
+
+    // Window starts at the requested offset, but never runs past the region end
+    off_t window_start = MIN(offset, cache->region_end - (off_t)cache->capacity);
+
+    cache->window_size = 0;
+    if(!storage_file_seek(fd, window_start, true) ||
+       storage_file_read(fd, cache->data, cache->capacity) != cache->capacity) {
+        return false;
+    }
+    cache->window_start = window_start;
+    cache->window_size = cache->capacity;
+
+    return true;
+}
+
+static bool elf_read_cached(File* fd, ELFReadCache* cache, off_t offset, void* data, size_t size) {
+    if(elf_read_cache_contains(cache, offset, size) ||
+       elf_read_cache_fill(fd, cache, offset, size)) {
+        memcpy(data, &cache->data[offset - cache->window_start], size);
+        return true;
+    }
+
+    return storage_file_seek(fd, offset, true) && storage_file_read(fd, data, size) == size;
+}
+
+/** Get a NUL terminated string from the cache, false if it is not entirely in the window */
+static bool elf_read_cached_string(
+    File* fd,
+    ELFReadCache* cache,
+    off_t offset,
+    FuriString* name,
+    bool fill) {
+    if(fill && !elf_read_cache_fill(fd, cache, offset, 1)) return false;
+    if(!elf_read_cache_contains(cache, offset, 1)) return false;
+
+    const char* string = (const char*)&cache->data[offset - cache->window_start];
+    size_t left = cache->window_start + cache->window_size - offset;
+    if(!memchr(string, '\0', left)) return false;
+
+    furi_string_cat_str(name, string);
+    return true;
+}
+
+static void elf_string_table_reset(ELFStringTable* table) {
+    if(table->data) {
+        free(table->data);
+    }
+    memset(table, 0, sizeof(ELFStringTable));
+}
+
+/** Read a string table into RAM, false if it is out of the file, too large or the heap is low */
+static bool elf_string_table_load(File* fd, ELFStringTable* table, off_t offset, size_t size) {
+    elf_string_table_reset(table);
+
+    // Size comes from the file as is, a broken one must not reach malloc
+    if(size == 0 || size > ELF_STRING_TABLE_MAX_SIZE || offset < 0 ||
+       (uint64_t)offset + size > storage_file_size(fd)) {
+        return false;
+    }
+
+    // Tables are optional, leave the memory to the sections
+    if(memmgr_heap_get_max_free_block() < size * 4) {
+        return false;
+    }
+
+    // Terminated past the end too, so a broken table can't run a name out of the buffer
+    table->data = malloc(size + 1);
+    table->data[size] = '\0';
+    table->size = size;
+
+    if(!storage_file_seek(fd, offset, true) || storage_file_read(fd, table->data, size) != size) {
+        elf_string_table_reset(table);
+        return false;
+    }
+
+    return true;
+}
+
+static const char* elf_string_table_get(const ELFStringTable* table, size_t offset) {
+    return (offset < table->size) ? &table->data[offset] : NULL;
+}
+
 /**************************************************************************************************/
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
@@ -64,18 +191,25 @@ static void elf_file_maybe_release_fd(ELFFile* elf) {
         storage_file_free(elf->fd);
         elf->fd = NULL;
     }
+
+    elf_read_cache_reset(&elf->section_table_cache);
+    elf_read_cache_reset(&elf->section_names_cache);
+    elf_read_cache_reset(&elf->symbol_table_cache);
+    elf_read_cache_reset(&elf->symbol_names_cache);
+    elf_string_table_reset(&elf->symbol_names);
 }
 
 static ELFSection* elf_file_get_section(ELFFile* elf, const char* name) {
     return ELFSectionDict_get(elf->sections, name);
 }
 
+/* Names from the section names table are used as keys as is, others are copied */
 static ELFSection* elf_file_get_or_put_section(ELFFile* elf, const char* name) {
     ELFSection* section_p = elf_file_get_section(elf, name);
     if(!section_p) {
         ELFSectionDict_set_at(
             elf->sections,
-            strdup(name),
+            elf->section_names.data ? name : strdup(name),
             (ELFSection){
                 .data = NULL,
                 .sec_idx = 0,
@@ -93,8 +227,6 @@ static ELFSection* elf_file_get_or_put_section(ELFFile* elf, const char* name) {
 static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString* name) {
     bool result = false;
 
-    off_t old = storage_file_tell(elf->fd);
-
     do {
         if(!storage_file_seek(elf->fd, offset, true)) break;
 
@@ -113,84 +245,117 @@ static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString*
         }
 
     } while(false);
-    storage_file_seek(elf->fd, old, true);
 
     return result;
 }
 
-static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
-    return elf_read_string_from_offset(elf, elf->section_table_strings + offset, name);
+static bool elf_read_cached_string_from_offset(
+    ELFFile* elf,
+    ELFReadCache* cache,
+    off_t offset,
+    FuriString* name) {
+    // Refill once if the string is cut by the window end, long strings are read directly
+    if(elf_read_cached_string(elf->fd, cache, offset, name, false) ||
+       elf_read_cached_string(elf->fd, cache, offset, name, true)) {
+        return true;
+    }
+
+    return elf_read_string_from_offset(elf, offset, name);
+}
+
+/** Get a section name, valid until the next name read if the table is not in RAM */
+static const char* elf_read_section_name(ELFFile* elf, off_t offset) {
+    if(elf->section_names.data) {
+        return elf_string_table_get(&elf->section_names, offset);
+    }
+
+    if(offset >= (off_t)elf->section_table_strings_size) {
+        return NULL;
+    }
+
+    off_t name_offset = elf->section_table_strings + offset;
+    furi_string_reset(elf->name_buffer);
+    if(!elf_read_cached_string_from_offset(
+           elf, &elf->section_names_cache, name_offset, elf->name_buffer)) {
+        return NULL;
+    }
+
+    return furi_string_get_cstr(elf->name_buffer);
 }
 
-static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
-    return elf_read_string_from_offset(elf, elf->symbol_table_strings + offset, name);
+/** Get a symbol name, valid until the next name read */
+static const char* elf_read_symbol_name(ELFFile* elf, off_t offset) {
+    const char* name = elf_string_table_get(&elf->symbol_names, offset);
+    if(name) return name;
+
+    // String table is not in RAM, read the name through the window
+    furi_string_reset(elf->name_buffer);
+    if(!elf_read_cached_string_from_offset(
+           elf, &elf->symbol_names_cache, elf->symbol_table_strings + offset, elf->name_buffer)) {
+        return NULL;
+    }
+
+    return furi_string_get_cstr(elf->name_buffer);
 }
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
     off_t offset = SECTION_OFFSET(elf, section_idx);
-    return storage_file_seek(elf->fd, offset, true) &&
-           storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
+    return elf_read_cached(
+        elf->fd, &elf->section_table_cache, offset, section_header, sizeof(Elf32_Shdr));
 }
 
-static bool elf_read_section(
-    ELFFile* elf,
-    size_t section_idx,
-    Elf32_Shdr* section_header,
-    FuriString* name) {
+/** Read a section header and its name, NULL on failure */
+static const char*
+    elf_read_section(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
     if(!elf_read_section_header(elf, section_idx, section_header)) {
-        return false;
-    }
-
-    if(section_header->sh_name && !elf_read_section_name(elf, section_header->sh_name, name)) {
-        return false;
+        return NULL;
     }
 
-    return true;
+    return elf_read_section_name(elf, section_header->sh_name);
 }
 
-static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* name) {
-    bool success = false;
-    off_t old = storage_file_tell(elf->fd);
+/** Read a symbol and its name, NULL on failure */
+static const char* elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym) {
     off_t pos = elf->symbol_table + n * sizeof(Elf32_Sym);
-    if(storage_file_seek(elf->fd, pos, true) &&
-       storage_file_read(elf->fd, sym, sizeof(Elf32_Sym)) == sizeof(Elf32_Sym)) {
-        if(sym->st_name)
-            success = elf_read_symbol_name(elf, sym->st_name, name);
-        else {
-            Elf32_Shdr shdr;
-            success = elf_read_section(elf, sym->st_shndx, &shdr, name);
-        }
+    if(!elf_read_cached(elf->fd, &elf->symbol_table_cache, pos, sym, sizeof(Elf32_Sym))) {
+        return NULL;
+    }
+
+    if(sym->st_name) {
+        return elf_read_symbol_name(elf, sym->st_name);
+    } else {
+        Elf32_Shdr shdr;
+        return elf_read_section(elf, sym->st_shndx, &shdr);
     }
-    storage_file_seek(elf->fd, old, true);
-    return success;
 }
 
 static ELFSection* elf_section_of(ELFFile* elf, int index) {
-    ELFSectionDict_it_t it;
-    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
-        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
-        if(itref->value.sec_idx == index) {
-            return &itref->value;
-        }
+    if(!elf->section_index || index <= 0 || (size_t)index >= elf->sections_count) {
+        return NULL;
     }
 
-    return NULL;
+    return elf->section_index[index];
+}
+
+static Elf32_Addr elf_address_of_by_hash(ELFFile* elf, uint32_t hash) {
+    Elf32_Addr addr = 0;
+    if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
+        return addr;
+    }
+    return ELF_INVALID_ADDRESS;
 }
 
-static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, const char* sName) {
+/** Symbol address, hash is the name hash for firmware symbols */
+static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, uint32_t hash) {
     if(sym->st_shndx == SHN_UNDEF) {
-        Elf32_Addr addr = 0;
-        uint32_t hash = elf_symbolname_hash(sName);
-        if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
-            return addr;
-        }
-    } else {
-        ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
-        if(symSec) {
-            return ((Elf32_Addr)symSec->data) + sym->st_value;
-        }
+        return elf_address_of_by_hash(elf, hash);
     }
-    FURI_LOG_D(TAG, "  Can not find address for symbol %s", sName);
+
+    ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
+    if(symSec) {
+        return ((Elf32_Addr)symSec->data) + sym->st_value;
+    }
+
     return ELF_INVALID_ADDRESS;
 }
 
@@ -358,15 +523,15 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
 
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
-        Elf32_Rel rel;
         size_t relEntries = s->rel_count;
         size_t relCount;
-        (void)storage_file_seek(elf->fd, s->rel_offset, true);
         FURI_LOG_D(TAG, " Offset   Info     Type             Name");
 
         int relocate_result = true;
-        FuriString* symbol_name;
-        symbol_name = furi_string_alloc();
+
+        // Relocations are read in chunks, one storage request per chunk
+        size_t chunk_count = MIN(relEntries, elf->read_windows.relocations);
+        Elf32_Rel* chunk = malloc(sizeof(Elf32_Rel) * chunk_count);
 
         for(relCount = 0; relCount < relEntries; relCount++) {
             if(relCount % RESOLVER_THREAD_YIELD_STEP == 0) {
@@ -374,24 +539,41 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
+            if(relCount % chunk_count == 0) {
+                uint32_t start = DWT->CYCCNT;
+                size_t read_size = sizeof(Elf32_Rel) * MIN(chunk_count, relEntries - relCount);
+                bool read_ok =
+                    storage_file_seek(
+                        elf->fd, s->rel_offset + relCount * sizeof(Elf32_Rel), true) &&
+                    storage_file_read(elf->fd, chunk, read_size) == read_size;
+                elf->read_cycles += DWT->CYCCNT - start;
+
+                if(!read_ok) {
+                    FURI_LOG_E(TAG, "  reloc read fail");
+                    free(chunk);
+                    return false;
+                }
             }
 
+            Elf32_Rel rel = chunk[relCount % chunk_count];
+
             Elf32_Addr symAddr;
 
             int symEntry = ELF32_R_SYM(rel.r_info);
             int relType = ELF32_R_TYPE(rel.r_info);
             Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
 
+            const char* symbol_name = "";
             if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
+                uint32_t start = DWT->CYCCNT;
+
                 Elf32_Sym sym;
-                furi_string_reset(symbol_name);
-                if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
+                symbol_name = elf_read_symbol(elf, symEntry, &sym);
+                uint32_t resolve_start = DWT->CYCCNT;
+                elf->read_cycles += resolve_start - start;
+                if(!symbol_name) {
                     FURI_LOG_E(TAG, "  symbol read fail");
-                    furi_string_free(symbol_name);
+                    free(chunk);
                     return false;
                 }
 
@@ -401,10 +583,12 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     (unsigned int)rel.r_offset,
                     (unsigned int)rel.r_info,
                     elf_reloc_type_to_str(relType),
-                    furi_string_get_cstr(symbol_name));
+                    symbol_name);
 
-                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                uint32_t hash = (sym.st_shndx == SHN_UNDEF) ? elf_symbolname_hash(symbol_name) : 0;
+                symAddr = elf_address_of(elf, &sym, hash);
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                elf->resolve_cycles += DWT->CYCCNT - resolve_start;
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -417,11 +601,11 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     relocate_result = false;
                 }
             } else {
-                FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
+                FURI_LOG_E(TAG, "  No symbol address of %s", symbol_name);
                 relocate_result = false;
             }
         }
-        furi_string_free(symbol_name);
+        free(chunk);
 
         return relocate_result;
     } else {
@@ -510,8 +694,7 @@ static SectionTypeInfo elf_preload_section(
     ELFFile* elf,
     size_t section_idx,
     Elf32_Shdr* section_header,
-    FuriString* name_string) {
-    const char* name = furi_string_get_cstr(name_string);
+    const char* name) {
     SectionTypeInfo info;
 
 #ifdef ELF_DEBUG_LOG
@@ -622,6 +805,11 @@ static SectionTypeInfo elf_preload_section(
         FURI_LOG_D(TAG, "Found .symtab section");
         elf->symbol_table = section_header->sh_offset;
         elf->symbol_count = section_header->sh_size / sizeof(Elf32_Sym);
+        elf_read_cache_init(
+            &elf->symbol_table_cache,
+            elf->symbol_table,
+            elf->symbol_count * sizeof(Elf32_Sym),
+            elf->read_windows.symbol_table);
 
         info.type = SectionTypeSymTab;
         info.result = ELFLoadSectionResultSuccess;
@@ -632,6 +820,12 @@ static SectionTypeInfo elf_preload_section(
     if(strcmp(name, ".strtab") == 0) {
         FURI_LOG_D(TAG, "Found .strtab section");
         elf->symbol_table_strings = section_header->sh_offset;
+        elf->symbol_table_strings_size = section_header->sh_size;
+        elf_read_cache_init(
+            &elf->symbol_names_cache,
+            elf->symbol_table_strings,
+            elf->symbol_table_strings_size,
+            elf->read_windows.symbol_names);
 
         info.type = SectionTypeStrTab;
         info.result = ELFLoadSectionResultSuccess;
@@ -657,32 +851,17 @@ static SectionTypeInfo elf_preload_section(
     return info;
 }
 
-static Elf32_Addr elf_address_of_by_hash(ELFFile* elf, uint32_t hash) {
-    Elf32_Addr addr = 0;
-    if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
-        return addr;
-    }
-    return ELF_INVALID_ADDRESS;
-}
-
 static bool elf_file_find_string_by_hash(ELFFile* elf, uint32_t hash, FuriString* out) {
-    bool result = false;
-
-    FuriString* symbol_name = furi_string_alloc();
     Elf32_Sym sym;
     for(size_t i = 0; i < elf->symbol_count; i++) {
-        furi_string_reset(symbol_name);
-        if(elf_read_symbol(elf, i, &sym, symbol_name)) {
-            if(elf_symbolname_hash(furi_string_get_cstr(symbol_name)) == hash) {
-                furi_string_set(out, symbol_name);
-                result = true;
-                break;
-            }
+        const char* symbol_name = elf_read_symbol(elf, i, &sym);
+        if(symbol_name && elf_symbolname_hash(symbol_name) == hash) {
+            furi_string_set(out, symbol_name);
+            return true;
         }
     }
-    furi_string_free(symbol_name);
 
-    return result;
+    return false;
 }
 
 static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
@@ -726,6 +905,7 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
             hash_or_section_index,
             offsets_count);
 
+        uint32_t resolve_start = DWT->CYCCNT;
         Elf32_Addr address = 0;
         if(is_section) {
             ELFSection* symSec = elf_section_of(elf, hash_or_section_index);
@@ -735,6 +915,7 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
         } else {
             address = elf_address_of_by_hash(elf, hash_or_section_index);
         }
+        elf->resolve_cycles += DWT->CYCCNT - resolve_start;
 
         if(address == ELF_INVALID_ADDRESS) {
             FuriString* symbol_name = furi_string_alloc();
@@ -811,6 +992,15 @@ ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface)
     ELFFile* elf = malloc(sizeof(ELFFile));
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
+    elf->name_buffer = furi_string_alloc();
+    elf->read_windows = (ELFFileReadWindows){
+        .section_table = ELF_SECTION_TABLE_CACHE_SIZE,
+        .section_names = ELF_SECTION_NAMES_CACHE_SIZE,
+        .symbol_table = ELF_SYMBOL_TABLE_CACHE_SIZE,
+        .symbol_names = ELF_SYMBOL_NAMES_CACHE_SIZE,
+        .relocations = ELF_RELOCATION_CHUNK_COUNT,
+        .string_tables = true,
+    };
     ELFSectionDict_init(elf->sections);
     AddressCache_init(elf->trampoline_cache);
     elf->init_array_called = false;
@@ -837,12 +1027,20 @@ void elf_file_free(ELFFile* elf) {
                 aligned_free(itref->value.fast_rel->data);
                 free(itref->value.fast_rel);
             }
-            free((void*)itref->key);
+            if(!elf->section_names.data) {
+                free((void*)itref->key);
+            }
         }
 
         ELFSectionDict_clear(elf->sections);
     }
 
+    // Section names may be the section keys, so they go after the sections
+    if(elf->section_index) {
+        free(elf->section_index);
+    }
+    elf_string_table_reset(&elf->section_names);
+
     // free trampoline data
     {
         AddressCache_it_t it;
@@ -860,6 +1058,7 @@ void elf_file_free(ELFFile* elf) {
     }
 
     elf_file_maybe_release_fd(elf);
+    furi_string_free(elf->name_buffer);
     free(elf);
 }
 
@@ -867,11 +1066,20 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     Elf32_Ehdr h;
     Elf32_Shdr sH;
 
-    if(!storage_file_open(elf->fd, path, FSAM_READ, FSOM_OPEN_EXISTING) ||
-       !storage_file_seek(elf->fd, 0, true) ||
-       storage_file_read(elf->fd, &h, sizeof(h)) != sizeof(h) ||
-       !storage_file_seek(elf->fd, h.e_shoff + h.e_shstrndx * sizeof(sH), true) ||
-       storage_file_read(elf->fd, &sH, sizeof(Elf32_Shdr)) != sizeof(Elf32_Shdr)) {
+    uint32_t start = DWT->CYCCNT;
+    bool opened = storage_file_open(elf->fd, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                  storage_file_seek(elf->fd, 0, true) &&
+                  storage_file_read(elf->fd, &h, sizeof(h)) == sizeof(h) &&
+                  storage_file_seek(elf->fd, h.e_shoff + h.e_shstrndx * sizeof(sH), true) &&
+                  storage_file_read(elf->fd, &sH, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
+
+    // Section names are small and looked up all the time, they are kept in RAM if possible
+    if(opened && elf->read_windows.string_tables) {
+        elf_string_table_load(elf->fd, &elf->section_names, sH.sh_offset, sH.sh_size);
+    }
+    elf->read_cycles += DWT->CYCCNT - start;
+
+    if(!opened) {
         return false;
     }
 
@@ -879,27 +1087,58 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+    elf->section_table_strings_size = sH.sh_size;
+
+    elf_read_cache_init(
+        &elf->section_table_cache,
+        elf->section_table,
+        elf->sections_count * sizeof(Elf32_Shdr),
+        elf->read_windows.section_table);
+    elf_read_cache_init(
+        &elf->section_names_cache,
+        elf->section_table_strings,
+        elf->section_table_strings_size,
+        elf->read_windows.section_names);
+
     return true;
 }
 
+void elf_file_set_read_windows(ELFFile* elf, const ELFFileReadWindows* windows) {
+    furi_check(windows);
+    furi_check(windows->relocations > 0);
+    elf->read_windows = *windows;
+}
+
+static void elf_file_index_sections(ELFFile* elf) {
+    elf->section_index = malloc(sizeof(ELFSection*) * elf->sections_count);
+
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+        // Relocation only entries have no section of their own
+        if(itref->value.sec_idx && itref->value.sec_idx < elf->sections_count) {
+            elf->section_index[itref->value.sec_idx] = &itref->value;
+        }
+    }
+}
+
 ElfLoadSectionTableResult elf_file_load_section_table(ELFFile* elf) {
     SectionType loaded_sections = 0;
-    FuriString* name = furi_string_alloc();
     ElfLoadSectionTableResult result = ElfLoadSectionTableResultSuccess;
+    uint32_t start = DWT->CYCCNT;
 
     FURI_LOG_D(TAG, "Scan ELF indexs...");
 
     for(size_t section_idx = 1; section_idx < elf->sections_count; section_idx++) {
         Elf32_Shdr section_header;
 
-        furi_string_reset(name);
-        if(!elf_read_section(elf, section_idx, &section_header, name)) {
+        const char* name = elf_read_section(elf, section_idx, &section_header);
+        if(!name) {
             loaded_sections = 0;
             break;
         }
 
-        FURI_LOG_D(
-            TAG, "Preloading data for section #%d %s", section_idx, furi_string_get_cstr(name));
+        FURI_LOG_D(TAG, "Preloading data for section #%d %s", section_idx, name);
         SectionTypeInfo section_type_info =
             elf_preload_section(elf, section_idx, &section_header, name);
         loaded_sections |= section_type_info.type;
@@ -918,21 +1157,20 @@ ElfLoadSectionTableResult elf_file_load_section_table(ELFFile* elf) {
         }
     }
 
-    furi_string_free(name);
-
-    if(result != ElfLoadSectionTableResultSuccess) {
-        return result;
-    } else {
+    if(result == ElfLoadSectionTableResultSuccess) {
         bool sections_valid =
             IS_FLAGS_SET(loaded_sections, SectionTypeSymTab | SectionTypeStrTab) |
             IS_FLAGS_SET(loaded_sections, SectionTypeFastRelData);
         if(sections_valid) {
-            return ElfLoadSectionTableResultSuccess;
+            elf_file_index_sections(elf);
         } else {
             FURI_LOG_E(TAG, "No valid sections found");
-            return ElfLoadSectionTableResultError;
+            result = ElfLoadSectionTableResultError;
         }
     }
+
+    elf->read_cycles += DWT->CYCCNT - start;
+    return result;
 }
 
 ElfProcessSectionResult elf_process_section(
@@ -941,17 +1179,16 @@ ElfProcessSectionResult elf_process_section(
     ElfProcessSection* process_section,
     void* context) {
     ElfProcessSectionResult result = ElfProcessSectionResultNotFound;
-    FuriString* section_name = furi_string_alloc();
     Elf32_Shdr section_header;
 
     // find section
     for(size_t section_idx = 1; section_idx < elf->sections_count; section_idx++) {
-        furi_string_reset(section_name);
-        if(!elf_read_section(elf, section_idx, &section_header, section_name)) {
+        const char* section_name = elf_read_section(elf, section_idx, &section_header);
+        if(!section_name) {
             break;
         }
 
-        if(furi_string_cmp(section_name, name) == 0) {
+        if(strcmp(section_name, name) == 0) {
             result = ElfProcessSectionResultCannotProcess;
             break;
         }
@@ -965,18 +1202,47 @@ ElfProcessSectionResult elf_process_section(
         }
     }
 
-    furi_string_free(section_name);
-
     return result;
 }
 
+/** Read symbol names into RAM if there are relocations to resolve by name and memory allows */
+static void elf_load_symbol_names(ELFFile* elf) {
+    bool names_needed = false;
+
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        const ELFSectionDict_itref_t* itref = ELFSectionDict_cref(it);
+        if(itref->value.rel_count && !itref->value.fast_rel) {
+            names_needed = true;
+        }
+    }
+
+    if(!names_needed || !elf->read_windows.string_tables) {
+        return;
+    }
+
+    // Table is optional, names are read through the window otherwise
+    uint32_t start = DWT->CYCCNT;
+    bool loaded = elf_string_table_load(
+        elf->fd, &elf->symbol_names, elf->symbol_table_strings, elf->symbol_table_strings_size);
+    if(!loaded) {
+        FURI_LOG_D(TAG, "Symbol names are read through the window");
+    }
+    elf->read_cycles += DWT->CYCCNT - start;
+}
+
 ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     furi_check(elf->fd != NULL);
     ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
     ELFSectionDict_it_t it;
 
+    uint32_t start = DWT->CYCCNT;
+    uint32_t measured = elf->read_cycles + elf->resolve_cycles;
+
     AddressCache_init(elf->relocation_cache);
 
+    elf_load_symbol_names(elf);
+
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
         FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
@@ -1013,6 +1279,11 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     }
 
     elf_file_maybe_release_fd(elf);
+
+    // Everything that is not a read or a lookup is relocation
+    measured = (elf->read_cycles + elf->resolve_cycles) - measured;
+    elf->relocate_cycles += (DWT->CYCCNT - start) - measured;
+
     return status;
 }
 
@@ -1042,6 +1313,13 @@ const ElfApiInterface* elf_file_get_api_interface(ELFFile* elf_file) {
     return elf_file->api_interface;
 }
 
+void elf_file_get_load_timings(ELFFile* elf, ELFFileLoadTimings* timings) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    timings->read_us = elf->read_cycles / cycles_per_us;
+    timings->resolve_us = elf->resolve_cycles / cycles_per_us;
+    timings->relocate_us = elf->relocate_cycles / cycles_per_us;
+}
+
 void elf_file_init_debug_info(ELFFile* elf, ELFDebugInfo* debug_info) {
     // set entry
     debug_info->entry = elf->entry;
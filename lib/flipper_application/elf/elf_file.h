@@ -48,6 +48,22 @@ typedef enum {
     ElfLoadSectionTableResultSuccess,
 } ElfLoadSectionTableResult;
 
+typedef struct {
+    uint32_t read_us;
+    uint32_t resolve_us;
+    uint32_t relocate_us;
+} ELFFileLoadTimings;
+
+/** Windows the ELF tables are read through while loading, 0 reads every entry directly */
+typedef struct {
+    size_t section_table; /**< Section headers window, bytes */
+    size_t section_names; /**< Section names window, bytes */
+    size_t symbol_table; /**< Symbol table window, bytes */
+    size_t symbol_names; /**< Symbol names window, bytes */
+    size_t relocations; /**< Relocation entries per read, at least 1 */
+    bool string_tables; /**< Read string tables that fit into RAM in full */
+} ELFFileReadWindows;
+
 typedef bool(ElfProcessSection)(File* file, size_t offset, size_t size, void* context);
 
 /**
@@ -72,6 +88,13 @@ void elf_file_free(ELFFile* elf_file);
  */
 bool elf_file_open(ELFFile* elf_file, const char* path);
 
+/**
+ * @brief Set read windows, call before elf_file_open
+ * @param elf_file 
+ * @param windows 
+ */
+void elf_file_set_read_windows(ELFFile* elf_file, const ELFFileReadWindows* windows);
+
 /**
  * @brief Load ELF file section table (load stage #1)
  * @param elf_file 
@@ -135,6 +158,15 @@ void elf_file_init_debug_info(ELFFile* elf_file, ELFDebugInfo* debug_info);
  */
 void elf_file_clear_debug_info(ELFDebugInfo* debug_info);
 
+/**
+ * @brief Get time spent in ELF file load stages
+ * Read covers headers, string tables, section data and relocation tables,
+ * resolve covers symbol lookups, relocate is the rest of elf_file_load_sections
+ * @param elf_file 
+ * @param timings 
+ */
+void elf_file_get_load_timings(ELFFile* elf_file, ELFFileLoadTimings* timings);
+
 /**
  * @brief Process ELF file section
  * 
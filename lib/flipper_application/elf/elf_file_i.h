@@ -28,21 +28,52 @@ struct ELFSection {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Read window over a file region, serves small reads from RAM
+ */
+typedef struct {
+    uint8_t* data;
+    size_t capacity;
+    off_t region_start;
+    off_t region_end;
+    off_t window_start;
+    size_t window_size;
+} ELFReadCache;
+
+/**
+ * String table read into RAM once, names are used in place
+ */
+typedef struct {
+    char* data;
+    size_t size;
+} ELFStringTable;
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
     off_t section_table_strings;
+    size_t section_table_strings_size;
 
     size_t symbol_count;
     off_t symbol_table;
     off_t symbol_table_strings;
+    size_t symbol_table_strings_size;
     off_t entry;
     ELFSectionDict_t sections;
+    ELFSection** section_index;
 
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
 
     File* fd;
+    ELFFileReadWindows read_windows;
+    ELFReadCache section_table_cache;
+    ELFReadCache section_names_cache;
+    ELFReadCache symbol_table_cache;
+    ELFReadCache symbol_names_cache;
+    ELFStringTable section_names;
+    ELFStringTable symbol_names;
+    FuriString* name_buffer;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
 
@@ -51,6 +82,10 @@ struct ELFFile {
     ELFSection* fini_array;
 
     bool init_array_called;
+
+    uint32_t read_cycles;
+    uint32_t resolve_cycles;
+    uint32_t relocate_cycles;
 };
 
 #ifdef __cplusplus
@@ -63,6 +63,23 @@ FlipperApplication*
     return app;
 }
 
+void flipper_application_set_read_windows(
+    FlipperApplication* app,
+    const FlipperApplicationReadWindows* windows) {
+    furi_check(app);
+    furi_check(windows);
+
+    ELFFileReadWindows elf_windows = {
+        .section_table = windows->section_table,
+        .section_names = windows->section_names,
+        .symbol_table = windows->symbol_table,
+        .symbol_names = windows->symbol_names,
+        .relocations = windows->relocations,
+        .string_tables = windows->string_tables,
+    };
+    elf_file_set_read_windows(app->elf, &elf_windows);
+}
+
 bool flipper_application_is_plugin(FlipperApplication* app) {
     furi_check(app);
     return app->manifest.stack_size == 0;
@@ -229,6 +246,19 @@ FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplicatio
     }
 }
 
+void flipper_application_get_load_timings(
+    FlipperApplication* app,
+    FlipperApplicationLoadTimings* timings) {
+    furi_check(app);
+    furi_check(timings);
+
+    ELFFileLoadTimings elf_timings;
+    elf_file_get_load_timings(app->elf, &elf_timings);
+    timings->read_us = elf_timings.read_us;
+    timings->resolve_us = elf_timings.resolve_us;
+    timings->relocate_us = elf_timings.relocate_us;
+}
+
 static int32_t flipper_application_thread(void* context) {
     furi_check(context);
     FlipperApplication* app = (FlipperApplication*)context;
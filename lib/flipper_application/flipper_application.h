@@ -32,6 +32,23 @@ typedef enum {
     FlipperApplicationLoadStatusMissingImports,
 } FlipperApplicationLoadStatus;
 
+/** Time spent on preload and mapping of an application, in microseconds */
+typedef struct {
+    uint32_t read_us; /**< Reading headers, sections, symbols and relocations from storage */
+    uint32_t resolve_us; /**< Looking up symbol addresses */
+    uint32_t relocate_us; /**< Patching section data, thread yields included */
+} FlipperApplicationLoadTimings;
+
+/** Windows the ELF tables are read through while mapping, 0 reads every entry directly */
+typedef struct {
+    size_t section_table; /**< Section headers window, bytes */
+    size_t section_names; /**< Section names window, bytes */
+    size_t symbol_table; /**< Symbol table window, bytes */
+    size_t symbol_names; /**< Symbol names window, bytes */
+    size_t relocations; /**< Relocation entries per read, at least 1 */
+    bool string_tables; /**< Read string tables that fit into RAM in full */
+} FlipperApplicationReadWindows;
+
 /** Get text description of preload status
  * @param status Status code
  * @return String pointer to description
@@ -71,6 +88,17 @@ FlipperApplication*
  */
 void flipper_application_free(FlipperApplication* app);
 
+/** Override read windows, for load benchmarks and tests
+ *
+ * Call before preload. Windows are sized for typical applications by default.
+ *
+ * @param app Application pointer
+ * @param windows Window sizes to use
+ */
+void flipper_application_set_read_windows(
+    FlipperApplication* app,
+    const FlipperApplicationReadWindows* windows);
+
 /** Validate elf file and load application metadata
  *
  * @param      app   Application pointer
@@ -103,6 +131,14 @@ const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplic
  */
 FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app);
 
+/** Get time breakdown of application loading
+ * @param app Application pointer
+ * @param timings Pointer to timings to fill
+ */
+void flipper_application_get_load_timings(
+    FlipperApplication* app,
+    FlipperApplicationLoadTimings* timings);
+
 /** Allocate application thread at entry point address, using app name and
  * stack size from metadata. Returned thread isn't started yet. 
  * Can be only called once for application instance.
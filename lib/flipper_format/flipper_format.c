@@ -122,6 +122,10 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+bool flipper_format_get_strict_mode(FlipperFormat* flipper_format) {
+    return flipper_format->strict_mode;
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_check(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -208,6 +208,14 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/** Get FlipperFormat mode.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ *
+ * @return     True if strict mode is enabled
+ */
+bool flipper_format_get_strict_mode(FlipperFormat* flipper_format);
+
 /** Rewind the RW pointer.
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
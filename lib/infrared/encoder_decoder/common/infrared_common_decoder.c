@@ -314,3 +314,10 @@ void infrared_common_decoder_reset(InfraredCommonDecoder* decoder) {
     infrared_common_decoder_reset_state(decoder);
     decoder->timings_cnt = 0;
 }
+
+/* Idle decoder waits for preamble and holds no timings: only preamble start can change that */
+bool infrared_common_decoder_is_idle(const InfraredCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    return (decoder->state == InfraredCommonDecoderStateWaitPreamble) && !decoder->timings_cnt;
+}
@@ -14,12 +14,26 @@
 #include "rca/infrared_protocol_rca.h"
 #include "pioneer/infrared_protocol_pioneer.h"
 
+#include "nec/infrared_protocol_nec_i.h"
+#include "samsung/infrared_protocol_samsung_i.h"
+#include "rc5/infrared_protocol_rc5_i.h"
+#include "rc6/infrared_protocol_rc6_i.h"
+#include "sirc/infrared_protocol_sirc_i.h"
+#include "kaseikyo/infrared_protocol_kaseikyo_i.h"
+#include "rca/infrared_protocol_rca_i.h"
+#include "pioneer/infrared_protocol_pioneer_i.h"
+
+/* Preamble marks are quantized to 64us steps for decoder lookup */
+#define INFRARED_DECODER_QUANT_SHIFT 6
+
 typedef struct {
     InfraredAlloc alloc;
     InfraredDecode decode;
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderIsIdle is_idle;
+    const InfraredTimings* timings;
 } InfraredDecoders;
 
 typedef struct {
@@ -29,8 +43,18 @@ typedef struct {
     InfraredFree free;
 } InfraredEncoders;
 
+typedef uint8_t InfraredDecoderMask;
+
 struct InfraredDecoderHandler {
     void** ctx;
+    /* Decoders taking part in current frame */
+    InfraredDecoderMask viable;
+    /* Decoders with a preamble, they can drop out of a frame */
+    InfraredDecoderMask rejectable;
+    /* Decoders that may start a frame, by quantized mark duration */
+    InfraredDecoderMask* preamble_lut;
+    size_t preamble_lut_size;
+    InfraredDecoderStats* stats;
 };
 
 struct InfraredEncoderHandler {
@@ -51,6 +75,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .is_idle = infrared_decoder_nec_is_idle,
+             .timings = &infrared_protocol_nec.timings,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -65,6 +91,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .is_idle = infrared_decoder_samsung32_is_idle,
+             .timings = &infrared_protocol_samsung32.timings,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -79,6 +107,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
+             .is_idle = infrared_decoder_rc5_is_idle,
+             .timings = &infrared_protocol_rc5.timings,
              .free = infrared_decoder_rc5_free},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
@@ -93,6 +123,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .is_idle = infrared_decoder_rc6_is_idle,
+             .timings = &infrared_protocol_rc6.timings,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -107,6 +139,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .is_idle = infrared_decoder_sirc_is_idle,
+             .timings = &infrared_protocol_sirc.timings,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -121,6 +155,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_pioneer_decode,
              .reset = infrared_decoder_pioneer_reset,
              .check_ready = infrared_decoder_pioneer_check_ready,
+             .is_idle = infrared_decoder_pioneer_is_idle,
+             .timings = &infrared_protocol_pioneer.timings,
              .free = infrared_decoder_pioneer_free},
         .encoder =
             {.alloc = infrared_encoder_pioneer_alloc,
@@ -135,6 +171,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .is_idle = infrared_decoder_kaseikyo_is_idle,
+             .timings = &infrared_protocol_kaseikyo.timings,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -149,6 +187,8 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
+             .is_idle = infrared_decoder_rca_is_idle,
+             .timings = &infrared_protocol_rca.timings,
              .free = infrared_decoder_rca_free},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
@@ -162,6 +202,14 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+static_assert(COUNT_OF(infrared_encoder_decoder) <= sizeof(InfraredDecoderMask) * 8);
+
+/**
+ * Decoder waiting for a preamble has rejected current frame and can't produce
+ * anything until a mark of its preamble length arrives. Such decoders are skipped,
+ * and one lookup by quantized mark duration tells which of them have to rejoin.
+ * Decoders without a preamble can start on any timing and are never skipped.
+ */
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_check(handler);
@@ -169,21 +217,94 @@ const InfraredMessage*
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
 
+    if(level) {
+        size_t quant = duration >> INFRARED_DECODER_QUANT_SHIFT;
+        if(quant < handler->preamble_lut_size) {
+            handler->viable |= handler->preamble_lut[quant];
+        }
+    }
+
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
-        if(infrared_encoder_decoder[i].decoder.decode) {
-            message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
-            if(!result && message) {
+        const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+        InfraredDecoderStats* stats = &handler->stats[i];
+        InfraredDecoderMask bit = 1 << i;
+
+        if(!(handler->viable & bit)) {
+            stats->skipped++;
+            continue;
+        }
+
+        message = decoder->decode(handler->ctx[i], level, duration);
+        stats->fed++;
+
+        if(message) {
+            stats->decoded++;
+            if(!result) {
                 result = message;
             }
+        } else if((handler->rejectable & bit) && decoder->is_idle(handler->ctx[i])) {
+            handler->viable &= ~bit;
+            stats->rejected++;
         }
     }
 
     return result;
 }
 
+static void infrared_decoder_build_preamble_lut(InfraredDecoderHandler* handler) {
+    handler->rejectable = 0;
+    handler->preamble_lut_size = 0;
+
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        const InfraredTimings* timings = infrared_encoder_decoder[i].decoder.timings;
+        if(!timings->preamble_mark) continue;
+
+        handler->rejectable |= 1 << i;
+        size_t max_quant = (timings->preamble_mark + timings->preamble_tolerance) >>
+                           INFRARED_DECODER_QUANT_SHIFT;
+        handler->preamble_lut_size = MAX(handler->preamble_lut_size, max_quant + 1);
+    }
+
+    handler->preamble_lut = malloc(sizeof(InfraredDecoderMask) * handler->preamble_lut_size);
+    memset(handler->preamble_lut, 0, sizeof(InfraredDecoderMask) * handler->preamble_lut_size);
+
+    /* Mark every quant overlapping preamble tolerance window, so lookup never misses a match */
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        const InfraredTimings* timings = infrared_encoder_decoder[i].decoder.timings;
+        if(!timings->preamble_mark) continue;
+
+        uint32_t min_mark = (timings->preamble_mark > timings->preamble_tolerance) ?
+                                timings->preamble_mark - timings->preamble_tolerance :
+                                0;
+        uint32_t max_mark = timings->preamble_mark + timings->preamble_tolerance;
+
+        for(size_t quant = min_mark >> INFRARED_DECODER_QUANT_SHIFT;
+            quant <= (max_mark >> INFRARED_DECODER_QUANT_SHIFT);
+            ++quant) {
+            handler->preamble_lut[quant] |= 1 << i;
+        }
+    }
+}
+
+static void infrared_decoder_reset_stats(InfraredDecoderHandler* handler) {
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        InfraredDecoderStats* stats = &handler->stats[i];
+        memset(stats, 0, sizeof(InfraredDecoderStats));
+        stats->protocol = InfraredProtocolUnknown;
+
+        for(InfraredProtocol protocol = 0; protocol < InfraredProtocolMAX; ++protocol) {
+            if(infrared_encoder_decoder[i].get_protocol_variant(protocol)) {
+                stats->protocol = protocol;
+                break;
+            }
+        }
+    }
+}
+
 InfraredDecoderHandler* infrared_alloc_decoder(void) {
     InfraredDecoderHandler* handler = malloc(sizeof(InfraredDecoderHandler));
     handler->ctx = malloc(sizeof(void*) * COUNT_OF(infrared_encoder_decoder));
+    handler->stats = malloc(sizeof(InfraredDecoderStats) * COUNT_OF(infrared_encoder_decoder));
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
         handler->ctx[i] = 0;
@@ -191,6 +312,9 @@ InfraredDecoderHandler* infrared_alloc_decoder(void) {
             handler->ctx[i] = infrared_encoder_decoder[i].decoder.alloc();
     }
 
+    infrared_decoder_build_preamble_lut(handler);
+    infrared_decoder_reset_stats(handler);
+
     infrared_reset_decoder(handler);
     return handler;
 }
@@ -204,6 +328,8 @@ void infrared_free_decoder(InfraredDecoderHandler* handler) {
             infrared_encoder_decoder[i].decoder.free(handler->ctx[i]);
     }
 
+    free(handler->preamble_lut);
+    free(handler->stats);
     free(handler->ctx);
     free(handler);
 }
@@ -215,6 +341,8 @@ void infrared_reset_decoder(InfraredDecoderHandler* handler) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
+
+    handler->viable = (1 << COUNT_OF(infrared_encoder_decoder)) - 1;
 }
 
 const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* handler) {
@@ -224,10 +352,16 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     InfraredMessage* result = NULL;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        /* idle decoder has nothing to finish */
+        if(!(handler->viable & (1 << i))) continue;
+
         if(infrared_encoder_decoder[i].decoder.check_ready) {
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
-            if(!result && message) {
-                result = message;
+            if(message) {
+                handler->stats[i].decoded++;
+                if(!result) {
+                    result = message;
+                }
             }
         }
     }
@@ -235,6 +369,27 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     return result;
 }
 
+size_t infrared_get_decoder_count(void) {
+    return COUNT_OF(infrared_encoder_decoder);
+}
+
+void infrared_get_decoder_stats(
+    const InfraredDecoderHandler* handler,
+    size_t index,
+    InfraredDecoderStats* stats) {
+    furi_check(handler);
+    furi_check(index < COUNT_OF(infrared_encoder_decoder));
+    furi_check(stats);
+
+    *stats = handler->stats[index];
+}
+
+void infrared_reset_decoder_stats(InfraredDecoderHandler* handler) {
+    furi_check(handler);
+
+    infrared_decoder_reset_stats(handler);
+}
+
 InfraredEncoderHandler* infrared_alloc_encoder(void) {
     InfraredEncoderHandler* handler = malloc(sizeof(InfraredEncoderHandler));
     handler->handler = NULL;
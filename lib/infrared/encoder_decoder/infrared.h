@@ -53,6 +53,14 @@ typedef enum {
     InfraredStatusReady,
 } InfraredStatus;
 
+typedef struct {
+    InfraredProtocol protocol; /**< First protocol handled by decoder */
+    uint32_t fed; /**< Timings passed to decoder */
+    uint32_t skipped; /**< Timings skipped while decoder waited for its preamble */
+    uint32_t rejected; /**< Times decoder dropped out of a frame */
+    uint32_t decoded; /**< Messages decoded */
+} InfraredDecoderStats;
+
 /**
  * Initialize decoder.
  *
@@ -106,6 +114,34 @@ void infrared_free_decoder(InfraredDecoderHandler* handler);
  */
 void infrared_reset_decoder(InfraredDecoderHandler* handler);
 
+/**
+ * Get amount of decoders in decoder handler.
+ *
+ * \return      decoder count, valid indexes for infrared_get_decoder_stats().
+ */
+size_t infrared_get_decoder_count(void);
+
+/**
+ * Get decoder counters.
+ * Each decoder is skipped once it rejects current frame, until a mark of its
+ * preamble length arrives. Counters show how much work that saved.
+ *
+ * \param[in]   handler     - handler to INFRARED decoders. Should be acquired with \c infrared_alloc_decoder().
+ * \param[in]   index       - decoder index, less than infrared_get_decoder_count().
+ * \param[out]  stats       - decoder counters.
+ */
+void infrared_get_decoder_stats(
+    const InfraredDecoderHandler* handler,
+    size_t index,
+    InfraredDecoderStats* stats);
+
+/**
+ * Reset decoder counters.
+ *
+ * \param[in]   handler     - handler to INFRARED decoders. Should be acquired with \c infrared_alloc_decoder().
+ */
+void infrared_reset_decoder_stats(InfraredDecoderHandler* handler);
+
 /**
  * Get protocol name by protocol enum.
  *
@@ -48,3 +48,7 @@ void infrared_decoder_kaseikyo_free(void* decoder) {
 void infrared_decoder_kaseikyo_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+bool infrared_decoder_kaseikyo_is_idle(void* decoder) {
+    return infrared_common_decoder_is_idle(decoder);
+}
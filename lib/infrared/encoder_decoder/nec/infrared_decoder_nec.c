@@ -95,3 +95,7 @@ void infrared_decoder_nec_free(void* decoder) {
 void infrared_decoder_nec_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+bool infrared_decoder_nec_is_idle(void* decoder) {
+    return infrared_common_decoder_is_idle(decoder);
+}
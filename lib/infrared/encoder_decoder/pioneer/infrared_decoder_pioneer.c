@@ -55,3 +55,7 @@ void infrared_decoder_pioneer_free(void* decoder) {
 void infrared_decoder_pioneer_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+bool infrared_decoder_pioneer_is_idle(void* decoder) {
+    return infrared_common_decoder_is_idle(decoder);
+}
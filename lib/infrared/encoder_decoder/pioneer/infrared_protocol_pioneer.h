@@ -24,6 +24,7 @@
 void* infrared_decoder_pioneer_alloc(void);
 void infrared_decoder_pioneer_reset(void* decoder);
 InfraredMessage* infrared_decoder_pioneer_check_ready(void* decoder);
+bool infrared_decoder_pioneer_is_idle(void* decoder);
 void infrared_decoder_pioneer_free(void* decoder);
 InfraredMessage* infrared_decoder_pioneer_decode(void* decoder, bool level, uint32_t duration);
 
@@ -28,6 +28,7 @@ void* infrared_decoder_rc5_alloc(void);
 void infrared_decoder_rc5_reset(void* decoder);
 void infrared_decoder_rc5_free(void* decoder);
 InfraredMessage* infrared_decoder_rc5_check_ready(void* ctx);
+bool infrared_decoder_rc5_is_idle(void* ctx);
 InfraredMessage* infrared_decoder_rc5_decode(void* decoder, bool level, uint32_t duration);
 
 void* infrared_encoder_rc5_alloc(void);
@@ -67,3 +67,7 @@ void infrared_decoder_samsung32_free(void* decoder) {
 void infrared_decoder_samsung32_reset(void* decoder) {
     infrared_common_decoder_reset(decoder);
 }
+
+bool infrared_decoder_samsung32_is_idle(void* decoder) {
+    return infrared_common_decoder_is_idle(decoder);
+}
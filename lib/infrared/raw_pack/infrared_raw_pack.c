@@ -0,0 +1,154 @@
+#include "infrared_raw_pack.h"
+
+#include <stdlib.h>
+#include <toolbox/varint.h>
+
+#define INFRARED_RAW_PACK_VERSION (1)
+
+// Version byte followed by the timings amount
+#define INFRARED_RAW_PACK_HEADER_MAX_SIZE (1 + 5)
+// Zigzag varint of a 31 bit difference
+#define INFRARED_RAW_PACK_TIMING_MAX_SIZE (5)
+
+static size_t infrared_raw_unpack_header(const uint8_t* input, size_t input_size, size_t* count) {
+    if(input_size < 2 || input[0] != INFRARED_RAW_PACK_VERSION) return 0;
+
+    uint32_t value;
+    size_t size = varint_uint32_unpack(&value, &input[1], input_size - 1);
+    if(size > input_size - 1) return 0;
+
+    *count = value;
+    return size + 1;
+}
+
+size_t infrared_raw_pack_get_max_size(size_t timings_cnt) {
+    return INFRARED_RAW_PACK_HEADER_MAX_SIZE + timings_cnt * INFRARED_RAW_PACK_TIMING_MAX_SIZE;
+}
+
+size_t infrared_raw_pack(const uint32_t* timings, size_t timings_cnt, uint8_t* output) {
+    uint8_t* start = output;
+
+    *output++ = INFRARED_RAW_PACK_VERSION;
+    output += varint_uint32_pack(timings_cnt, output);
+
+    uint32_t previous[2] = {0, 0};
+    for(size_t i = 0; i < timings_cnt; ++i) {
+        if(timings[i] > INFRARED_RAW_PACK_MAX_TIMING) return 0;
+
+        const int32_t delta = (int32_t)timings[i] - (int32_t)previous[i % 2];
+        output += varint_int32_pack(delta, output);
+        previous[i % 2] = timings[i];
+    }
+
+    return output - start;
+}
+
+bool infrared_raw_unpack_get_count(const uint8_t* input, size_t input_size, size_t* timings_cnt) {
+    return infrared_raw_unpack_header(input, input_size, timings_cnt) != 0;
+}
+
+bool infrared_raw_unpack(
+    const uint8_t* input,
+    size_t input_size,
+    uint32_t* timings,
+    size_t timings_cnt) {
+    size_t count;
+    size_t offset = infrared_raw_unpack_header(input, input_size, &count);
+    if(!offset || count != timings_cnt) return false;
+
+    uint32_t previous[2] = {0, 0};
+    for(size_t i = 0; i < timings_cnt; ++i) {
+        if(offset >= input_size) return false;
+
+        int32_t delta;
+        offset += varint_int32_unpack(&delta, &input[offset], input_size - offset);
+        if(offset > input_size) return false;
+
+        // Wraps around to a huge value if the difference is negative beyond zero
+        const uint32_t timing = previous[i % 2] + (uint32_t)delta;
+        if(timing > INFRARED_RAW_PACK_MAX_TIMING) return false;
+
+        timings[i] = timing;
+        previous[i % 2] = timing;
+    }
+
+    // Trailing garbage means the data is not what it claims to be
+    return offset == input_size;
+}
+
+static size_t infrared_raw_pack_get_decimal_length(const uint32_t* timings, size_t timings_cnt) {
+    size_t length = 0;
+    for(size_t i = 0; i < timings_cnt; ++i) {
+        // Digits and a separating space
+        for(uint32_t value = timings[i]; value >= 10; value /= 10) {
+            ++length;
+        }
+        length += 2;
+    }
+    return length;
+}
+
+InfraredRawPackStatus
+    infrared_raw_pack_write(FlipperFormat* ff, const uint32_t* timings, size_t timings_cnt) {
+    uint8_t* packed = malloc(infrared_raw_pack_get_max_size(timings_cnt));
+    const size_t packed_size = infrared_raw_pack(timings, timings_cnt, packed);
+
+    InfraredRawPackStatus status = InfraredRawPackStatusNotPacked;
+
+    // Packed timings take 3 characters per byte
+    if(packed_size &&
+       (packed_size * 3 < infrared_raw_pack_get_decimal_length(timings, timings_cnt))) {
+        status = flipper_format_write_hex(ff, INFRARED_RAW_PACK_KEY, packed, packed_size) ?
+                     InfraredRawPackStatusOk :
+                     InfraredRawPackStatusError;
+    }
+
+    free(packed);
+    return status;
+}
+
+InfraredRawPackStatus infrared_raw_pack_read(
+    FlipperFormat* ff,
+    size_t max_timings_cnt,
+    uint32_t** timings,
+    size_t* timings_cnt) {
+    uint32_t size;
+
+    const bool strict_mode = flipper_format_get_strict_mode(ff);
+    flipper_format_set_strict_mode(ff, true);
+    const bool is_packed = flipper_format_get_value_count(ff, INFRARED_RAW_PACK_KEY, &size);
+    flipper_format_set_strict_mode(ff, strict_mode);
+
+    if(!is_packed) return InfraredRawPackStatusNotPacked;
+    if(size > infrared_raw_pack_get_max_size(max_timings_cnt)) {
+        return InfraredRawPackStatusTooLong;
+    }
+
+    InfraredRawPackStatus status = InfraredRawPackStatusError;
+    uint8_t* packed = malloc(size);
+    uint32_t* unpacked = NULL;
+
+    do {
+        if(!flipper_format_read_hex(ff, INFRARED_RAW_PACK_KEY, packed, size)) break;
+
+        size_t count;
+        if(!infrared_raw_unpack_get_count(packed, size, &count)) break;
+
+        if(count > max_timings_cnt) {
+            status = InfraredRawPackStatusTooLong;
+            break;
+        }
+
+        unpacked = malloc(sizeof(uint32_t) * count);
+        if(!infrared_raw_unpack(packed, size, unpacked, count)) break;
+
+        *timings = unpacked;
+        *timings_cnt = count;
+        unpacked = NULL;
+        status = InfraredRawPackStatusOk;
+    } while(false);
+
+    free(unpacked);
+    free(packed);
+    return status;
+}
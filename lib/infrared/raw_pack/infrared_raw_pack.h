@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <flipper_format/flipper_format.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest timing value that can be packed, us */
+#define INFRARED_RAW_PACK_MAX_TIMING (0x3FFFFFFFUL)
+
+/** FlipperFormat key of the packed timings */
+#define INFRARED_RAW_PACK_KEY "packed"
+
+typedef enum {
+    InfraredRawPackStatusOk, /**< Packed timings written or read. */
+    InfraredRawPackStatusNotPacked, /**< Timings must be written or read as a decimal list. */
+    InfraredRawPackStatusTooLong, /**< More timings than the caller allows. */
+    InfraredRawPackStatusError, /**< File operation failed or packed data is corrupted. */
+} InfraredRawPackStatus;
+
+/**
+ * Get buffer size enough to pack given amount of timings.
+ *
+ * \param[in]   timings_cnt - timings array size.
+ *
+ * \return      worst case packed data size in bytes.
+ */
+size_t infrared_raw_pack_get_max_size(size_t timings_cnt);
+
+/**
+ * Pack raw timings into compact binary form.
+ *
+ * Every timing is stored as a zigzag varint of its difference
+ * with the previous timing of the same level (mark or space),
+ * which takes a single byte for most of the real world signals.
+ * Packing is lossless.
+ *
+ * \param[in]   timings - array of timings to pack.
+ * \param[in]   timings_cnt - timings array size.
+ * \param[out]  output - buffer of at least infrared_raw_pack_get_max_size() bytes.
+ *
+ * \return      packed data size in bytes, 0 if any timing
+ *              exceeds INFRARED_RAW_PACK_MAX_TIMING.
+ */
+size_t infrared_raw_pack(const uint32_t* timings, size_t timings_cnt, uint8_t* output);
+
+/**
+ * Get timings amount stored in packed data without unpacking it.
+ *
+ * \param[in]   input - packed data.
+ * \param[in]   input_size - packed data size in bytes.
+ * \param[out]  timings_cnt - timings amount.
+ *
+ * \return      true if packed data header is valid, false otherwise.
+ */
+bool infrared_raw_unpack_get_count(const uint8_t* input, size_t input_size, size_t* timings_cnt);
+
+/**
+ * Unpack raw timings.
+ *
+ * \param[in]   input - packed data.
+ * \param[in]   input_size - packed data size in bytes.
+ * \param[out]  timings - array to unpack timings to.
+ * \param[in]   timings_cnt - timings array size, must be equal
+ *              to the amount returned by infrared_raw_unpack_get_count().
+ *
+ * \return      true if packed data is valid, false otherwise.
+ */
+bool infrared_raw_unpack(
+    const uint8_t* input,
+    size_t input_size,
+    uint32_t* timings,
+    size_t timings_cnt);
+
+/**
+ * Write timings to a FlipperFormat file in packed form.
+ *
+ * Nothing is written if the packed form is not shorter than
+ * the decimal list or some timing can't be packed.
+ *
+ * \param[in,out] ff - file to write to.
+ * \param[in]   timings - array of timings to write.
+ * \param[in]   timings_cnt - timings array size.
+ *
+ * \return      InfraredRawPackStatusOk if written,
+ *              InfraredRawPackStatusNotPacked if the decimal list must be written instead,
+ *              InfraredRawPackStatusError on write error.
+ */
+InfraredRawPackStatus
+    infrared_raw_pack_write(FlipperFormat* ff, const uint32_t* timings, size_t timings_cnt);
+
+/**
+ * Read packed timings from a FlipperFormat file.
+ *
+ * Packed timings are only looked for as the next key, so that the key
+ * of one of the following signals is never picked up. Strict mode
+ * of the file is left as the caller had it.
+ *
+ * \param[in,out] ff - file to read from.
+ * \param[in]   max_timings_cnt - largest timings amount allowed.
+ * \param[out]  timings - allocated timings array on success, to be freed by the caller.
+ * \param[out]  timings_cnt - timings amount on success.
+ *
+ * \return      InfraredRawPackStatusOk if read,
+ *              InfraredRawPackStatusNotPacked if the next key is not packed timings,
+ *              InfraredRawPackStatusTooLong if there are more than max_timings_cnt timings,
+ *              InfraredRawPackStatusError on read error or corrupted data.
+ */
+InfraredRawPackStatus infrared_raw_pack_read(
+    FlipperFormat* ff,
+    size_t max_timings_cnt,
+    uint32_t** timings,
+    size_t* timings_cnt);
+
+#ifdef __cplusplus
+}
+#endif
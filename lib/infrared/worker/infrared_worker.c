@@ -2,13 +2,15 @@
 
 #include <furi_hal_infrared.h>
 #include <float_tools.h>
+#include <toolbox/spsc_ring.h>
 
 #include <core/check.h>
 #include <core/common_defines.h>
 
 #include <notification/notification_messages.h>
 
-#define INFRARED_WORKER_RX_TIMEOUT INFRARED_RAW_RX_TIMING_DELAY_US
+#define INFRARED_WORKER_RX_TIMEOUT    INFRARED_RAW_RX_TIMING_DELAY_US
+#define INFRARED_WORKER_RX_BATCH_SIZE 32
 
 #define INFRARED_WORKER_RX_RECEIVED         0x01
 #define INFRARED_WORKER_RX_TIMEOUT_RECEIVED 0x02
@@ -52,6 +54,7 @@ struct InfraredWorkerSignal {
 struct InfraredWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
+    SpscRing* rx_ring;
 
     InfraredWorkerSignal signal;
     InfraredWorkerState state;
@@ -105,13 +108,12 @@ static void infrared_worker_rx_callback(void* context, bool level, uint32_t dura
     furi_assert(duration != 0);
     LevelDuration level_duration = level_duration_make(level, duration);
 
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    uint32_t events = (ret == sizeof(LevelDuration)) ? INFRARED_WORKER_RX_RECEIVED :
-                                                       INFRARED_WORKER_OVERRUN;
-
-    uint32_t flags_set = furi_thread_flags_set(furi_thread_get_id(instance->thread), events);
-    furi_check(flags_set & events);
+    // Ring wakes the worker up itself when it stops being empty
+    if(!spsc_ring_push(instance->rx_ring, &level_duration)) {
+        uint32_t flags_set = furi_thread_flags_set(
+            furi_thread_get_id(instance->thread), INFRARED_WORKER_OVERRUN);
+        furi_check(flags_set & INFRARED_WORKER_OVERRUN);
+    }
 }
 
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
@@ -164,7 +166,8 @@ static void
 static int32_t infrared_worker_rx_thread(void* thread_context) {
     InfraredWorker* instance = thread_context;
     uint32_t events = 0;
-    LevelDuration level_duration;
+    LevelDuration batch[INFRARED_WORKER_RX_BATCH_SIZE];
+    size_t count;
     uint32_t last_blink_time = 0;
 
     while(1) {
@@ -179,12 +182,10 @@ static int32_t infrared_worker_rx_thread(void* thread_context) {
             }
             if(instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_backlight_on);
-            while(sizeof(LevelDuration) ==
-                  furi_stream_buffer_receive(
-                      instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
-                if(!instance->rx.overrun) {
-                    bool level = level_duration_get_level(level_duration);
-                    uint32_t duration = level_duration_get_duration(level_duration);
+            while((count = spsc_ring_pop(instance->rx_ring, batch, COUNT_OF(batch)))) {
+                for(size_t i = 0; i < count && !instance->rx.overrun; i++) {
+                    bool level = level_duration_get_level(batch[i]);
+                    uint32_t duration = level_duration_get_duration(batch[i]);
                     infrared_worker_process_timings(instance, duration, level);
                 }
             }
@@ -232,6 +233,7 @@ InfraredWorker* infrared_worker_alloc(void) {
         MAX(sizeof(InfraredWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1),
             sizeof(LevelDuration) * MAX_TIMINGS_AMOUNT);
     instance->stream = furi_stream_buffer_alloc(buffer_size, sizeof(InfraredWorkerTiming));
+    instance->rx_ring = spsc_ring_alloc(sizeof(LevelDuration), MAX_TIMINGS_AMOUNT);
     instance->infrared_decoder = infrared_alloc_decoder();
     instance->infrared_encoder = infrared_alloc_encoder();
     instance->blink_enable = false;
@@ -250,6 +252,7 @@ void infrared_worker_free(InfraredWorker* instance) {
     infrared_free_decoder(instance->infrared_decoder);
     infrared_free_encoder(instance->infrared_encoder);
     furi_stream_buffer_free(instance->stream);
+    spsc_ring_free(instance->rx_ring);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -259,10 +262,10 @@ void infrared_worker_rx_start(InfraredWorker* instance) {
     furi_check(instance);
     furi_check(instance->state == InfraredWorkerStateIdle);
 
-    furi_stream_set_trigger_level(instance->stream, sizeof(LevelDuration));
-
     furi_thread_set_callback(instance->thread, infrared_worker_rx_thread);
     furi_thread_start(instance->thread);
+    spsc_ring_set_wakeup(
+        instance->rx_ring, furi_thread_get_id(instance->thread), INFRARED_WORKER_RX_RECEIVED, 1);
 
     furi_hal_infrared_async_rx_set_capture_isr_callback(infrared_worker_rx_callback, instance);
     furi_hal_infrared_async_rx_set_timeout_isr_callback(
@@ -285,7 +288,8 @@ void infrared_worker_rx_stop(InfraredWorker* instance) {
     furi_thread_flags_set(furi_thread_get_id(instance->thread), INFRARED_WORKER_EXIT);
     furi_thread_join(instance->thread);
 
-    furi_check(furi_stream_buffer_reset(instance->stream) == FuriStatusOk);
+    spsc_ring_set_wakeup(instance->rx_ring, NULL, 0, 1);
+    spsc_ring_flush(instance->rx_ring);
 
     instance->state = InfraredWorkerStateIdle;
 }
@@ -0,0 +1,190 @@
+#include "lfrfid_raw_analyzer.h"
+#include <furi_hal.h>
+
+#define TAG "LfRfidRawAnalyzer"
+
+struct LFRFIDRawAnalyzer {
+    ProtocolDict* dict;
+
+    LFRFIDRawAnalyzerCallback callback;
+    void* context;
+
+    ProtocolId last_protocol;
+    uint8_t* last_data;
+    uint8_t* protocol_data;
+    uint32_t repeat_count;
+
+    LFRFIDRawAnalyzerClock clock;
+    uint32_t clock_ticks_per_us;
+    void* clock_context;
+
+    uint64_t process_ticks;
+    LFRFIDRawAnalyzerStats stats;
+};
+
+static uint32_t lfrfid_raw_analyzer_clock_cycles(void* context) {
+    UNUSED(context);
+    return DWT->CYCCNT;
+}
+
+LFRFIDRawAnalyzer* lfrfid_raw_analyzer_alloc(ProtocolDict* dict) {
+    furi_check(dict);
+
+    LFRFIDRawAnalyzer* analyzer = malloc(sizeof(LFRFIDRawAnalyzer));
+    analyzer->dict = dict;
+
+    size_t data_size = protocol_dict_get_max_data_size(dict);
+    analyzer->last_data = malloc(data_size);
+    analyzer->protocol_data = malloc(data_size);
+
+    lfrfid_raw_analyzer_set_clock(
+        analyzer,
+        lfrfid_raw_analyzer_clock_cycles,
+        furi_hal_cortex_instructions_per_microsecond(),
+        NULL);
+    lfrfid_raw_analyzer_reset(analyzer);
+
+    return analyzer;
+}
+
+void lfrfid_raw_analyzer_free(LFRFIDRawAnalyzer* analyzer) {
+    furi_check(analyzer);
+
+    free(analyzer->last_data);
+    free(analyzer->protocol_data);
+    free(analyzer);
+}
+
+void lfrfid_raw_analyzer_set_callback(
+    LFRFIDRawAnalyzer* analyzer,
+    LFRFIDRawAnalyzerCallback callback,
+    void* context) {
+    furi_check(analyzer);
+
+    analyzer->callback = callback;
+    analyzer->context = context;
+}
+
+void lfrfid_raw_analyzer_set_clock(
+    LFRFIDRawAnalyzer* analyzer,
+    LFRFIDRawAnalyzerClock clock,
+    uint32_t ticks_per_us,
+    void* context) {
+    furi_check(analyzer);
+    furi_check(!clock || ticks_per_us);
+
+    analyzer->clock = clock;
+    analyzer->clock_ticks_per_us = ticks_per_us;
+    analyzer->clock_context = context;
+    analyzer->process_ticks = 0;
+}
+
+void lfrfid_raw_analyzer_reset(LFRFIDRawAnalyzer* analyzer) {
+    furi_check(analyzer);
+
+    protocol_dict_decoders_start(analyzer->dict);
+
+    analyzer->last_protocol = PROTOCOL_NO;
+    analyzer->repeat_count = 0;
+    analyzer->process_ticks = 0;
+    memset(&analyzer->stats, 0, sizeof(LFRFIDRawAnalyzerStats));
+}
+
+static void lfrfid_raw_analyzer_hit(LFRFIDRawAnalyzer* analyzer, ProtocolId protocol) {
+    size_t data_size = protocol_dict_get_data_size(analyzer->dict, protocol);
+    protocol_dict_get_data(analyzer->dict, protocol, analyzer->protocol_data, data_size);
+
+    // same validation rule as in lfrfid_worker read mode
+    if(protocol == analyzer->last_protocol &&
+       memcmp(analyzer->last_data, analyzer->protocol_data, data_size) == 0) {
+        analyzer->repeat_count++;
+    } else {
+        analyzer->last_protocol = protocol;
+        memcpy(analyzer->last_data, analyzer->protocol_data, data_size);
+        analyzer->repeat_count = 0;
+    }
+
+    LFRFIDRawAnalyzerHit hit = {
+        .protocol = protocol,
+        .data = analyzer->protocol_data,
+        .data_size = data_size,
+        .timestamp = analyzer->stats.capture_time,
+        .pair_index = analyzer->stats.pair_count - 1,
+        .repeat_count = analyzer->repeat_count,
+        .validate_count = protocol_dict_get_validate_count(analyzer->dict, protocol),
+    };
+    hit.validated = hit.repeat_count >= hit.validate_count;
+
+    analyzer->stats.hit_count++;
+    if(hit.validated) analyzer->stats.validated_count++;
+
+    if(analyzer->callback) {
+        analyzer->callback(&hit, analyzer->context);
+    }
+}
+
+ProtocolId
+    lfrfid_raw_analyzer_feed(LFRFIDRawAnalyzer* analyzer, uint32_t pulse, uint32_t duration) {
+    furi_check(analyzer);
+
+    analyzer->stats.pair_count++;
+    analyzer->stats.capture_time += duration;
+
+    // inverted pulse would underflow the low level, decoders resync on the following pairs
+    if(pulse > duration || pulse == 0) {
+        analyzer->stats.warn_count++;
+        return PROTOCOL_NO;
+    }
+
+    uint32_t ticks = analyzer->clock ? analyzer->clock(analyzer->clock_context) : 0;
+
+    ProtocolId protocol = protocol_dict_decoders_feed(analyzer->dict, true, pulse);
+    if(protocol == PROTOCOL_NO) {
+        protocol = protocol_dict_decoders_feed(analyzer->dict, false, duration - pulse);
+    }
+
+    if(analyzer->clock) {
+        analyzer->process_ticks += analyzer->clock(analyzer->clock_context) - ticks;
+    }
+
+    if(protocol != PROTOCOL_NO) {
+        lfrfid_raw_analyzer_hit(analyzer, protocol);
+    }
+
+    return protocol;
+}
+
+bool lfrfid_raw_analyzer_process_file(LFRFIDRawAnalyzer* analyzer, LFRFIDRawFile* file) {
+    furi_check(analyzer);
+    furi_check(file);
+
+    bool pass_end = false;
+    bool result = true;
+
+    while(true) {
+        uint32_t pulse = 0;
+        uint32_t duration = 0;
+
+        if(!lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end)) {
+            FURI_LOG_E(TAG, "Failed to read pair");
+            result = false;
+            break;
+        }
+
+        // file wraps around on the end, pair that was read belongs to the next pass
+        if(pass_end) break;
+
+        lfrfid_raw_analyzer_feed(analyzer, pulse, duration);
+    }
+
+    return result;
+}
+
+const LFRFIDRawAnalyzerStats* lfrfid_raw_analyzer_get_stats(LFRFIDRawAnalyzer* analyzer) {
+    furi_check(analyzer);
+
+    analyzer->stats.process_time =
+        analyzer->clock ? analyzer->process_ticks / analyzer->clock_ticks_per_us : 0;
+
+    return &analyzer->stats;
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include <furi.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include "lfrfid_raw_file.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LFRFIDRawAnalyzer LFRFIDRawAnalyzer;
+
+/** Single protocol decode found in the capture */
+typedef struct {
+    ProtocolId protocol; /**< Decoded protocol */
+    const uint8_t* data; /**< Decoded protocol data, valid only during callback */
+    size_t data_size; /**< Decoded protocol data size */
+    uint64_t timestamp; /**< Capture time of the decode, us from the capture start */
+    size_t pair_index; /**< Index of the pair that completed the decode */
+    uint32_t repeat_count; /**< Identical decodes in a row, not counting the first one */
+    uint32_t validate_count; /**< Repeats required by the protocol to trust the data */
+    bool validated; /**< repeat_count reached validate_count */
+} LFRFIDRawAnalyzerHit;
+
+/** Analyzer statistics */
+typedef struct {
+    size_t pair_count; /**< Pairs read, including malformed ones */
+    size_t warn_count; /**< Malformed pairs (zero or inverted pulse), not fed to the decoders */
+    size_t hit_count; /**< Decodes of any protocol */
+    size_t validated_count; /**< Decodes that reached protocol validate count */
+    uint64_t capture_time; /**< Total capture time, us */
+    uint64_t process_time; /**< Time spent in decoders, us, 0 without a clock */
+} LFRFIDRawAnalyzerStats;
+
+/**
+ * @brief Clock used to measure the time spent in decoders
+ *
+ * @param context clock context
+ * @return free running tick count, wraps around
+ */
+typedef uint32_t (*LFRFIDRawAnalyzerClock)(void* context);
+
+/**
+ * @brief Hit callback
+ *
+ * @param hit decoded protocol description
+ * @param context callback context
+ */
+typedef void (*LFRFIDRawAnalyzerCallback)(const LFRFIDRawAnalyzerHit* hit, void* context);
+
+/**
+ * @brief Allocate a new LFRFIDRawAnalyzer instance
+ *
+ * Decoder time is measured with the CPU cycle counter until another clock is set.
+ *
+ * @param dict protocol dictionary to decode with, must outlive the analyzer
+ * @return LFRFIDRawAnalyzer*
+ */
+LFRFIDRawAnalyzer* lfrfid_raw_analyzer_alloc(ProtocolDict* dict);
+
+/**
+ * @brief Free a LFRFIDRawAnalyzer instance
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ */
+void lfrfid_raw_analyzer_free(LFRFIDRawAnalyzer* analyzer);
+
+/**
+ * @brief Set hit callback
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ * @param callback called on every protocol decode, can be NULL
+ * @param context callback context
+ */
+void lfrfid_raw_analyzer_set_callback(
+    LFRFIDRawAnalyzer* analyzer,
+    LFRFIDRawAnalyzerCallback callback,
+    void* context);
+
+/**
+ * @brief Set the clock decoder time is measured with, clears the time measured so far
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ * @param clock clock, NULL to not measure decoder time
+ * @param ticks_per_us clock ticks in a microsecond
+ * @param context clock context
+ */
+void lfrfid_raw_analyzer_set_clock(
+    LFRFIDRawAnalyzer* analyzer,
+    LFRFIDRawAnalyzerClock clock,
+    uint32_t ticks_per_us,
+    void* context);
+
+/**
+ * @brief Restart decoders and clear statistics
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ */
+void lfrfid_raw_analyzer_reset(LFRFIDRawAnalyzer* analyzer);
+
+/**
+ * @brief Feed single pulse/duration pair, as stored in RAW file
+ *
+ * Pairs with a zero or inverted pulse are counted as warnings and skipped, capture time
+ * still advances by their duration.
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ * @param pulse high level duration, us
+ * @param duration full period duration, us
+ * @return ProtocolId decoded protocol or PROTOCOL_NO
+ */
+ProtocolId
+    lfrfid_raw_analyzer_feed(LFRFIDRawAnalyzer* analyzer, uint32_t pulse, uint32_t duration);
+
+/**
+ * @brief Feed whole RAW file in a single pass, without real time pacing
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ * @param file RAW file opened for reading, header must be already read
+ * @return bool true if file was processed to the end
+ */
+bool lfrfid_raw_analyzer_process_file(LFRFIDRawAnalyzer* analyzer, LFRFIDRawFile* file);
+
+/**
+ * @brief Get analyzer statistics
+ *
+ * @param analyzer LFRFIDRawAnalyzer instance
+ * @return const LFRFIDRawAnalyzerStats*
+ */
+const LFRFIDRawAnalyzerStats* lfrfid_raw_analyzer_get_stats(LFRFIDRawAnalyzer* analyzer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,8 +3,7 @@
 #include "lfrfid_worker_i.h"
 #include "tools/t5577.h"
 #include <toolbox/pulse_protocols/pulse_glue.h>
-#include <toolbox/buffer_stream.h>
-#include "tools/varint_pair.h"
+#include <toolbox/spsc_ring.h>
 #include <lib/bit_lib/bit_lib.h>
 
 #define TAG "LfRfidWorker"
@@ -34,8 +33,11 @@
 
 #define LFRFID_WORKER_WRITE_MAX_UNSUCCESSFUL_READS 5
 
-#define LFRFID_WORKER_READ_BUFFER_SIZE  512
-#define LFRFID_WORKER_READ_BUFFER_COUNT 16
+#define LFRFID_WORKER_READ_RING_SIZE  2048
+#define LFRFID_WORKER_READ_WATERMARK  64
+#define LFRFID_WORKER_READ_BATCH_SIZE 32
+// Not a part of LFRFIDEventAll, so it never starts a mode
+#define LFRFID_WORKER_READ_EVENT_DATA (1UL << 16)
 
 #define LFRFID_WORKER_EMULATE_BUFFER_SIZE 1024
 
@@ -53,8 +55,14 @@ void lfrfid_worker_delay(LFRFIDWorker* worker, uint32_t milliseconds) {
 /**************************************************************************************************/
 
 typedef struct {
-    BufferStream* stream;
-    VarintPair* pair;
+    uint32_t pulse;
+    uint32_t duration;
+} LFRFIDWorkerReadPair;
+
+typedef struct {
+    SpscRing* ring;
+    uint32_t pulse;
+    bool pulse_valid;
     bool ignore_next_pulse;
 } LFRFIDWorkerReadContext;
 
@@ -72,7 +80,7 @@ static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* cont
         if(level) {
             ctx->ignore_next_pulse = true;
         }
-        varint_pair_reset(ctx->pair);
+        ctx->pulse_valid = false;
         return;
     }
 
@@ -80,11 +88,17 @@ static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* cont
     furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, level);
 #endif
 
-    bool need_to_send = varint_pair_pack(ctx->pair, level, duration);
-    if(need_to_send) {
-        buffer_stream_send_from_isr(
-            ctx->stream, varint_pair_get_data(ctx->pair), varint_pair_get_size(ctx->pair));
-        varint_pair_reset(ctx->pair);
+    // pulse is followed by the whole period, two pulses in a row drop the pair
+    if(level) {
+        ctx->pulse = duration;
+        ctx->pulse_valid = !ctx->pulse_valid;
+    } else if(ctx->pulse_valid) {
+        LFRFIDWorkerReadPair pair = {
+            .pulse = ctx->pulse,
+            .duration = duration,
+        };
+        spsc_ring_push(ctx->ring, &pair);
+        ctx->pulse_valid = false;
     }
 }
 
@@ -127,10 +141,16 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
 
-    LFRFIDWorkerReadContext ctx;
-    ctx.pair = varint_pair_alloc();
-    ctx.stream =
-        buffer_stream_alloc(LFRFID_WORKER_READ_BUFFER_SIZE, LFRFID_WORKER_READ_BUFFER_COUNT);
+    LFRFIDWorkerReadContext ctx = {0};
+    ctx.ring = spsc_ring_alloc(sizeof(LFRFIDWorkerReadPair), LFRFID_WORKER_READ_RING_SIZE);
+    spsc_ring_set_wakeup(
+        ctx.ring,
+        furi_thread_get_current_id(),
+        LFRFID_WORKER_READ_EVENT_DATA,
+        LFRFID_WORKER_READ_WATERMARK);
+    LFRFIDWorkerReadPair* pairs =
+        malloc(sizeof(LFRFIDWorkerReadPair) * LFRFID_WORKER_READ_BATCH_SIZE);
+    uint32_t overrun_count = 0;
 
     furi_hal_rfid_tim_read_capture_start(lfrfid_worker_read_capture, &ctx);
 
@@ -155,138 +175,129 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             break;
         }
 
-        Buffer* buffer = buffer_stream_receive(ctx.stream, 100);
+        // keep reading without waiting while there is more than one batch pending
+        if(spsc_ring_get_count(ctx.ring) < LFRFID_WORKER_READ_BATCH_SIZE) {
+            furi_thread_flags_wait(LFRFID_WORKER_READ_EVENT_DATA, FuriFlagWaitAny, 100);
+        }
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
         furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, true);
 #endif
 
-        if(buffer_stream_get_overrun_count(ctx.stream) > 0) {
+        if(spsc_ring_get_overrun_count(ctx.ring) != overrun_count) {
             FURI_LOG_E(TAG, "Read overrun, recovering");
-            buffer_stream_reset(ctx.stream);
+            overrun_count = spsc_ring_get_overrun_count(ctx.ring);
+            spsc_ring_flush(ctx.ring);
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
             furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
             continue;
         }
 
-        if(buffer == NULL) {
+        size_t count = spsc_ring_pop(ctx.ring, pairs, LFRFID_WORKER_READ_BATCH_SIZE);
+        if(count == 0) {
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
             furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
             continue;
         }
 
-        size_t size = buffer_get_size(buffer);
-        uint8_t* data = buffer_get_data(buffer);
-        size_t index = 0;
-
-        while(index < size) {
-            uint32_t duration;
-            uint32_t pulse;
-            size_t tmp_size;
-
-            if(!varint_pair_unpack(&data[index], size - index, &pulse, &duration, &tmp_size)) {
-                FURI_LOG_E(TAG, "can't unpack varint pair");
-                break;
-            } else {
-                index += tmp_size;
-
-                average_duration += duration;
-                average_pulse += pulse;
-                average_index++;
-                if(average_index >= LFRFID_WORKER_READ_AVERAGE_COUNT) {
-                    float average = (float)average_pulse / (float)average_duration;
-                    average_pulse = 0;
-                    average_duration = 0;
-                    average_index = 0;
-
-                    if(worker->read_cb) {
-                        if(average > 0.2f && average < 0.8f) {
-                            if(!card_detected) {
-                                card_detected = true;
-                                worker->read_cb(
-                                    LFRFIDWorkerReadSenseStart, PROTOCOL_NO, worker->cb_ctx);
-                            }
-                        } else {
-                            if(card_detected) {
-                                card_detected = false;
-                                worker->read_cb(
-                                    LFRFIDWorkerReadSenseEnd, PROTOCOL_NO, worker->cb_ctx);
-                            }
+        for(size_t index = 0; index < count; index++) {
+            uint32_t pulse = pairs[index].pulse;
+            uint32_t duration = pairs[index].duration;
+
+            average_duration += duration;
+            average_pulse += pulse;
+            average_index++;
+            if(average_index >= LFRFID_WORKER_READ_AVERAGE_COUNT) {
+                float average = (float)average_pulse / (float)average_duration;
+                average_pulse = 0;
+                average_duration = 0;
+                average_index = 0;
+
+                if(worker->read_cb) {
+                    if(average > 0.2f && average < 0.8f) {
+                        if(!card_detected) {
+                            card_detected = true;
+                            worker->read_cb(
+                                LFRFIDWorkerReadSenseStart, PROTOCOL_NO, worker->cb_ctx);
+                        }
+                    } else {
+                        if(card_detected) {
+                            card_detected = false;
+                            worker->read_cb(
+                                LFRFIDWorkerReadSenseEnd, PROTOCOL_NO, worker->cb_ctx);
                         }
                     }
                 }
+            }
 
-                ProtocolId protocol = PROTOCOL_NO;
+            ProtocolId protocol = PROTOCOL_NO;
 
+            protocol = protocol_dict_decoders_feed_by_feature(
+                worker->protocols, feature, true, pulse);
+            if(protocol == PROTOCOL_NO) {
                 protocol = protocol_dict_decoders_feed_by_feature(
-                    worker->protocols, feature, true, pulse);
-                if(protocol == PROTOCOL_NO) {
-                    protocol = protocol_dict_decoders_feed_by_feature(
-                        worker->protocols, feature, false, duration - pulse);
-                }
-
-                if(protocol != PROTOCOL_NO) {
-                    // reset switch timer
-                    switch_os_tick_last = furi_get_tick();
+                    worker->protocols, feature, false, duration - pulse);
+            }
 
-                    size_t protocol_data_size =
-                        protocol_dict_get_data_size(worker->protocols, protocol);
-                    protocol_dict_get_data(
-                        worker->protocols, protocol, protocol_data, protocol_data_size);
+            if(protocol != PROTOCOL_NO) {
+                // reset switch timer
+                switch_os_tick_last = furi_get_tick();
 
-                    // validate protocol
-                    if(protocol == last_protocol &&
-                       memcmp(last_data, protocol_data, protocol_data_size) == 0) {
-                        last_read_count = last_read_count + 1;
+                size_t protocol_data_size =
+                    protocol_dict_get_data_size(worker->protocols, protocol);
+                protocol_dict_get_data(
+                    worker->protocols, protocol, protocol_data, protocol_data_size);
 
-                        size_t validation_count =
-                            protocol_dict_get_validate_count(worker->protocols, protocol);
+                // validate protocol
+                if(protocol == last_protocol &&
+                   memcmp(last_data, protocol_data, protocol_data_size) == 0) {
+                    last_read_count = last_read_count + 1;
 
-                        if(last_read_count >= validation_count) {
-                            state = LFRFIDWorkerReadOK;
-                            *result_protocol = protocol;
-                            break;
-                        }
-                    } else {
-                        if(last_protocol == PROTOCOL_NO && worker->read_cb) {
-                            worker->read_cb(
-                                LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
-                        }
+                    size_t validation_count =
+                        protocol_dict_get_validate_count(worker->protocols, protocol);
 
-                        last_protocol = protocol;
-                        memcpy(last_data, protocol_data, protocol_data_size);
-                        last_read_count = 0;
+                    if(last_read_count >= validation_count) {
+                        state = LFRFIDWorkerReadOK;
+                        *result_protocol = protocol;
+                        break;
+                    }
+                } else {
+                    if(last_protocol == PROTOCOL_NO && worker->read_cb) {
+                        worker->read_cb(
+                            LFRFIDWorkerReadSenseCardStart, protocol, worker->cb_ctx);
                     }
 
-                    if(furi_log_get_level() >= FuriLogLevelDebug) {
-                        FuriString* string_info;
-                        string_info = furi_string_alloc();
-                        for(uint8_t i = 0; i < protocol_data_size; i++) {
-                            if(i != 0) {
-                                furi_string_cat_printf(string_info, " ");
-                            }
+                    last_protocol = protocol;
+                    memcpy(last_data, protocol_data, protocol_data_size);
+                    last_read_count = 0;
+                }
 
-                            furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
+                if(furi_log_get_level() >= FuriLogLevelDebug) {
+                    FuriString* string_info;
+                    string_info = furi_string_alloc();
+                    for(uint8_t i = 0; i < protocol_data_size; i++) {
+                        if(i != 0) {
+                            furi_string_cat_printf(string_info, " ");
                         }
 
-                        FURI_LOG_D(
-                            TAG,
-                            "%s, %zu, [%s]",
-                            protocol_dict_get_name(worker->protocols, protocol),
-                            last_read_count,
-                            furi_string_get_cstr(string_info));
-                        furi_string_free(string_info);
+                        furi_string_cat_printf(string_info, "%02X", protocol_data[i]);
                     }
 
-                    protocol_dict_decoders_start(worker->protocols);
+                    FURI_LOG_D(
+                        TAG,
+                        "%s, %zu, [%s]",
+                        protocol_dict_get_name(worker->protocols, protocol),
+                        last_read_count,
+                        furi_string_get_cstr(string_info));
+                    furi_string_free(string_info);
                 }
+
+                protocol_dict_decoders_start(worker->protocols);
             }
         }
 
-        buffer_reset(buffer);
-
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
         furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
@@ -315,8 +326,9 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     furi_hal_rfid_tim_read_stop();
     furi_hal_rfid_pins_reset();
 
-    varint_pair_free(ctx.pair);
-    buffer_stream_free(ctx.stream);
+    spsc_ring_free(ctx.ring);
+    furi_thread_flags_clear(LFRFID_WORKER_READ_EVENT_DATA);
+    free(pairs);
 
     free(protocol_data);
     free(last_data);
@@ -50,6 +50,16 @@ char* cs_read_file(const char* path, size_t* size) {
     return data;
 }
 
+int cs_write_file(const char* path, const char* data, size_t size) WEAK;
+int cs_write_file(const char* path, const char* data, size_t size) {
+    FILE* fp;
+    int ok;
+    if((fp = fopen(path, "wb")) == NULL) return 0;
+    ok = fwrite(data, 1, size, fp) == size;
+    fclose(fp);
+    return ok;
+}
+
 char* cs_mmap_file(const char* path, size_t* size) WEAK;
 char* cs_mmap_file(const char* path, size_t* size) {
     char* r;
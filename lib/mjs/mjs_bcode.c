@@ -127,16 +127,20 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs) {
 }
 
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs) {
-    struct mjs_bcode_part bp;
-    memset(&bp, 0, sizeof(bp));
-
     /* Make sure the bcode doesn't occupy any extra space */
     mbuf_trim(&mjs->bcode_gen);
 
     /* Transfer the ownership of the bcode data */
-    bp.data.p = mjs->bcode_gen.buf;
-    bp.data.len = mjs->bcode_gen.len;
+    mjs_bcode_commit_data(mjs, mjs->bcode_gen.buf, mjs->bcode_gen.len);
     mbuf_init(&mjs->bcode_gen, 0);
+}
+
+MJS_PRIVATE void mjs_bcode_commit_data(struct mjs* mjs, const char* data, size_t len) {
+    struct mjs_bcode_part bp;
+    memset(&bp, 0, sizeof(bp));
+
+    bp.data.p = data;
+    bp.data.len = len;
 
     bp.start_idx = mjs->bcode_len;
     bp.exec_res = MJS_ERRS_CNT;
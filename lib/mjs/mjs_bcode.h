@@ -14,6 +14,13 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*
+ * Version of the bcode format, stored in .jsc cache files. Bump it on any
+ * change in opcodes, their operands or the bcode header layout, so that
+ * stale cache files are ignored.
+ */
+#define MJS_BCODE_VERSION 1
+
 enum mjs_opcode {
     OP_NOP, /* ( -- ) */
     OP_DROP, /* ( a -- ) */
@@ -98,6 +105,12 @@ MJS_PRIVATE int mjs_bcode_parts_cnt(struct mjs* mjs);
  */
 MJS_PRIVATE void mjs_bcode_commit(struct mjs* mjs);
 
+/*
+ * Adds ready bcode `data` (starting with OP_BCODE_HEADER) as a next bcode
+ * part; takes the ownership of the malloc'ed `data`.
+ */
+MJS_PRIVATE void mjs_bcode_commit_data(struct mjs* mjs, const char* data, size_t len);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -63,6 +63,7 @@ void mjs_destroy(struct mjs* mjs) {
     mbuf_free(&mjs->array_buffers);
     free(mjs->error_msg);
     free(mjs->stack_trace);
+    free(mjs->jsc_cache_dir);
     mjs_ffi_args_free_list(mjs);
     gc_arena_destroy(mjs, &mjs->object_arena);
     gc_arena_destroy(mjs, &mjs->property_arena);
@@ -421,3 +422,13 @@ MJS_PRIVATE void mjs_push(struct mjs* mjs, mjs_val_t v) {
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc) {
     mjs->generate_jsc = generate_jsc;
 }
+
+void mjs_set_jsc_cache(struct mjs* mjs, const char* dir, uint32_t build_id) {
+    free(mjs->jsc_cache_dir);
+    mjs->jsc_cache_dir = (dir != NULL) ? strdup(dir) : NULL;
+    mjs->jsc_build_id = build_id;
+}
+
+int mjs_get_jsc_cache_hits(struct mjs* mjs) {
+    return mjs->jsc_cache_hits;
+}
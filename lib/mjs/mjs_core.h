@@ -89,6 +89,10 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    char* jsc_cache_dir; /* Bcode cache directory, NULL if the cache is off */
+    uint32_t jsc_build_id; /* Everything bcode depends on besides the source */
+    int jsc_cache_hits; /* Files executed from the bcode cache */
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
@@ -257,11 +257,28 @@ const char* mjs_get_stack_trace(struct mjs* mjs);
  * Sets whether *.jsc files are generated when *.js file is executed. By
  * default it's 0.
  *
- * If either `MJS_GENERATE_JSC` or `CS_MMAP` is off, then this function has no
- * effect.
+ * With `MJS_GENERATE_JSC` and `CS_MMAP` on, .jsc file is mmapped and executed
+ * in place. Otherwise this function has no effect.
  */
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc);
 
+/*
+ * Sets the bcode cache directory, with `MJS_JSC_CACHE` on. By default it's
+ * NULL, which disables the cache.
+ *
+ * `mjs_exec_file()` stores bcode of executed .js files to `dir`, one .jsc
+ * file per script path, and loads it from there instead of parsing the
+ * source as long as the source and `build_id` are unchanged. `build_id` must
+ * change whenever bcode may change for the same source, e.g. with every
+ * firmware build. The directory must exist.
+ */
+void mjs_set_jsc_cache(struct mjs* mjs, const char* dir, uint32_t build_id);
+
+/*
+ * Returns the number of .js files executed from the bcode cache.
+ */
+int mjs_get_jsc_cache_hits(struct mjs* mjs);
+
 /*
  * When invoked from a cfunction, returns number of arguments passed to the
  * current JS function call.
@@ -1083,6 +1083,161 @@ clean:
     return mjs->error;
 }
 
+#if MJS_JSC_CACHE
+/*
+ * .jsc cache file layout: the header below followed by a single bcode part,
+ * exactly as it's kept in RAM. Bcode is position independent, so it can be
+ * committed as is.
+ */
+#define MJS_JSC_MAGIC 0x43534A4DUL /* "MJSC" */
+
+struct mjs_jsc_header {
+    uint32_t magic;
+    uint16_t bcode_version;
+    uint16_t opcodes_cnt;
+    uint32_t build_id;
+    uint32_t source_hash;
+    uint32_t source_len;
+    uint32_t bcode_len;
+};
+
+static uint32_t mjs_jsc_source_hash(const char* src, size_t len) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= (uint8_t)src[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/*
+ * Returns malloc'ed path of the cache file for the .js `path`, or NULL if the
+ * cache is off. Files are named after the hash of the script path, the path
+ * itself is checked against the cached bcode on load.
+ */
+static char* mjs_jsc_path(struct mjs* mjs, const char* path) {
+    const char* jsext = ".js";
+    size_t path_len = strlen(path);
+    size_t jsc_path_len;
+    char* jsc_path;
+
+    if(mjs->jsc_cache_dir == NULL) return NULL;
+    if(path_len <= strlen(jsext) || strcmp(path + path_len - strlen(jsext), jsext) != 0) {
+        return NULL;
+    }
+
+    /* "<dir>/<8 hex digits>.jsc" */
+    jsc_path_len = strlen(mjs->jsc_cache_dir) + 1 + 8 + 4 + 1;
+    jsc_path = (char*)malloc(jsc_path_len);
+    snprintf(
+        jsc_path,
+        jsc_path_len,
+        "%s/%08lx.jsc",
+        mjs->jsc_cache_dir,
+        (unsigned long)mjs_jsc_source_hash(path, path_len));
+    return jsc_path;
+}
+
+static void mjs_jsc_header_init(
+    struct mjs* mjs,
+    struct mjs_jsc_header* hdr,
+    const char* src,
+    size_t src_len) {
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic = MJS_JSC_MAGIC;
+    hdr->bcode_version = MJS_BCODE_VERSION;
+    hdr->opcodes_cnt = OP_MAX;
+    hdr->build_id = mjs->jsc_build_id;
+    hdr->source_hash = mjs_jsc_source_hash(src, src_len);
+    hdr->source_len = src_len;
+}
+
+/*
+ * Loads bcode of `path` from its .jsc file and commits it as a new bcode part.
+ * Returns 0 if there's no .jsc file, or it's stale or broken.
+ */
+static int mjs_jsc_load(struct mjs* mjs, const char* path, const char* src, size_t src_len) {
+    struct mjs_jsc_header expected, hdr;
+    mjs_header_item_t items[MJS_HDR_ITEMS_CNT];
+    size_t size = 0;
+    char* jsc_path = mjs_jsc_path(mjs, path);
+    char* data = NULL;
+    char* bcode = NULL;
+    int ok = 0;
+
+    if(jsc_path == NULL) return 0;
+    data = cs_read_file(jsc_path, &size);
+    free(jsc_path);
+    if(data == NULL) return 0;
+
+    do {
+        if(size < sizeof(hdr)) break;
+        memcpy(&hdr, data, sizeof(hdr));
+
+        mjs_jsc_header_init(mjs, &expected, src, src_len);
+        expected.bcode_len = hdr.bcode_len;
+        if(memcmp(&hdr, &expected, sizeof(hdr)) != 0) break;
+        if(hdr.bcode_len != size - sizeof(hdr)) break;
+
+        /* Sanity check the bcode header itself */
+        bcode = data + sizeof(hdr);
+        if(hdr.bcode_len < 1 + sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT) break;
+        if((uint8_t)bcode[0] != OP_BCODE_HEADER) break;
+        memcpy(items, bcode + 1, sizeof(items));
+        if(items[MJS_HDR_ITEM_TOTAL_SIZE] + 1 != hdr.bcode_len) break;
+        if(items[MJS_HDR_ITEM_BCODE_OFFSET] > items[MJS_HDR_ITEM_TOTAL_SIZE]) break;
+        if(items[MJS_HDR_ITEM_MAP_OFFSET] > items[MJS_HDR_ITEM_TOTAL_SIZE]) break;
+
+        /* Cached bcode keeps the file name it was compiled from */
+        if(strncmp(
+               bcode + 1 + sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT,
+               path,
+               hdr.bcode_len - 1 - sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT) != 0) {
+            break;
+        }
+
+        ok = 1;
+    } while(0);
+
+    if(ok) {
+        /* Drop the cache header and hand the buffer over to the bcode part */
+        memmove(data, bcode, hdr.bcode_len);
+        mjs_bcode_commit_data(mjs, data, hdr.bcode_len);
+        mjs->jsc_cache_hits++;
+    } else {
+        LOG(LL_INFO, ("Stale or broken bcode cache for %s", path));
+        free(data);
+    }
+
+    return ok;
+}
+
+/* Stores the last committed bcode part, which is bcode of `path`, to .jsc */
+static void mjs_jsc_save(struct mjs* mjs, const char* path, const char* src) {
+    struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+    struct mjs_jsc_header hdr;
+    char* jsc_path = mjs_jsc_path(mjs, path);
+    char* data;
+
+    if(jsc_path == NULL) return;
+
+    mjs_jsc_header_init(mjs, &hdr, src, strlen(src));
+    hdr.bcode_len = bp->data.len;
+
+    data = (char*)malloc(sizeof(hdr) + bp->data.len);
+    memcpy(data, &hdr, sizeof(hdr));
+    memcpy(data + sizeof(hdr), bp->data.p, bp->data.len);
+    if(!cs_write_file(jsc_path, data, sizeof(hdr) + bp->data.len)) {
+        LOG(LL_WARN, ("Failed to write %s", jsc_path));
+    }
+
+    free(data);
+    free(jsc_path);
+}
+#endif
+
 MJS_PRIVATE mjs_err_t mjs_exec_internal(
     struct mjs* mjs,
     const char* path,
@@ -1159,6 +1314,12 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
                 }
             }
         }
+#elif MJS_JSC_CACHE
+        /* Bcode of .js files only, while the cache directory is set */
+        (void)generate_jsc;
+        if(path != NULL) {
+            mjs_jsc_save(mjs, path, src);
+        }
 #else
         (void)generate_jsc;
 #endif
@@ -1186,6 +1347,19 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     }
 
     r = MJS_UNDEFINED;
+
+#if MJS_JSC_CACHE
+    if(mjs->jsc_cache_dir != NULL) {
+        size_t off = mjs->bcode_len;
+        if(mjs_jsc_load(mjs, path, source_code, size)) {
+            /* Source text is not needed anymore, release it before running */
+            free(source_code);
+            error = mjs_execute(mjs, off, &r);
+            goto clean;
+        }
+    }
+#endif
+
     error = mjs_exec_internal(mjs, path, source_code, -1, &r);
     free(source_code);
 
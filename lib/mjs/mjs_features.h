@@ -14,6 +14,15 @@
 #define MJS_MEMORY_STATS 0
 #endif
 
+/*
+ * MJS_OBJECT_INDEX_THRESHOLD: objects with at least that many properties get
+ * a hash index on top of the property list, so that lookups don't have to
+ * scan the whole list. Set to 0 to disable the index.
+ */
+#if !defined(MJS_OBJECT_INDEX_THRESHOLD)
+#define MJS_OBJECT_INDEX_THRESHOLD 8
+#endif
+
 /*
  * MJS_GENERATE_JSC: if enabled, and if mmapping is also enabled (CS_MMAP),
  * then execution of any .js file will result in creation of a .jsc file with
@@ -30,4 +39,17 @@
 #endif
 #endif
 
+/*
+ * MJS_JSC_CACHE: portable alternative to MJS_GENERATE_JSC for platforms
+ * without mmap. If enabled, and if a cache directory is set with
+ * `mjs_set_jsc_cache()`, executing a .js file stores its bcode to a .jsc
+ * file in that directory, keyed by the source hash and the build id.
+ * Subsequent executions load the bcode from it and skip parsing altogether.
+ *
+ * By default it's enabled unless MJS_GENERATE_JSC is.
+ */
+#if !defined(MJS_JSC_CACHE)
+#define MJS_JSC_CACHE (!MJS_GENERATE_JSC)
+#endif
+
 #endif /* MJS_FEATURES_H_ */
@@ -297,7 +297,11 @@ static void gc_mark_object(struct mjs* mjs, mjs_val_t* v) {
 
     if(MARKED(obj_base)) return;
 
-    /* mark object itself, and its properties */
+    /*
+   * mark object itself, and its properties. The property index, if any, is
+   * plain heap memory pointing at the same property cells: it is released by
+   * the object destructor when the object is swept.
+   */
     for((prop = obj_base->properties), MARK(obj_base); prop != NULL; prop = next) {
         if(!gc_check_ptr(&mjs->property_arena, prop)) {
             abort();
@@ -13,6 +13,135 @@
 
 #include "common/mg_str.h"
 
+struct mjs_property_index_entry {
+    struct mjs_property* prop;
+    uint32_t hash;
+};
+
+/*
+ * Open addressing hash table of the object's properties. It only refers to
+ * the property cells which are linked in `struct mjs_object::properties`
+ * anyway, so GC doesn't have to know about it. Hashes are cached in the
+ * entries, since property names may be relocated by string compaction.
+ */
+struct mjs_property_index {
+    size_t count;
+    size_t mask;
+    struct mjs_property_index_entry entries[];
+};
+
+static uint32_t mjs_property_hash(const char* name, size_t len) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static struct mjs_property_index* mjs_property_index_alloc(size_t capacity) {
+    struct mjs_property_index* index = calloc(
+        1, sizeof(struct mjs_property_index) + capacity * sizeof(struct mjs_property_index_entry));
+    index->mask = capacity - 1;
+    return index;
+}
+
+static void mjs_property_index_put(
+    struct mjs_property_index* index,
+    struct mjs_property* prop,
+    uint32_t hash) {
+    size_t i = hash & index->mask;
+    while(index->entries[i].prop != NULL) {
+        i = (i + 1) & index->mask;
+    }
+    index->entries[i].prop = prop;
+    index->entries[i].hash = hash;
+    index->count++;
+}
+
+static void mjs_object_index_add(struct mjs_object* o, struct mjs_property* prop, uint32_t hash) {
+    struct mjs_property_index* index = o->index;
+
+    /* Keep load factor under 3/4 */
+    if((index->count + 1) * 4 > (index->mask + 1) * 3) {
+        struct mjs_property_index* grown = mjs_property_index_alloc((index->mask + 1) * 2);
+        for(size_t i = 0; i <= index->mask; i++) {
+            if(index->entries[i].prop != NULL) {
+                mjs_property_index_put(grown, index->entries[i].prop, index->entries[i].hash);
+            }
+        }
+        free(index);
+        o->index = index = grown;
+    }
+
+    mjs_property_index_put(index, prop, hash);
+}
+
+/*
+ * Remove `prop` from the index. Entries following it in the probe run are
+ * shifted back, so lookups never need tombstones.
+ */
+static void mjs_object_index_remove(
+    struct mjs_object* o,
+    struct mjs_property* prop,
+    uint32_t hash) {
+    struct mjs_property_index* index = o->index;
+    size_t i = hash & index->mask;
+    size_t j;
+
+    while(index->entries[i].prop != prop) {
+        i = (i + 1) & index->mask;
+    }
+
+    for(j = (i + 1) & index->mask; index->entries[j].prop != NULL; j = (j + 1) & index->mask) {
+        /* Entry at j stays if its home slot is cyclically within (i, j] */
+        size_t home = index->entries[j].hash & index->mask;
+        if(i <= j ? (i < home && home <= j) : (i < home || home <= j)) continue;
+        index->entries[i] = index->entries[j];
+        i = j;
+    }
+
+    index->entries[i].prop = NULL;
+    index->count--;
+}
+
+MJS_PRIVATE void mjs_object_rebuild_index(struct mjs* mjs, struct mjs_object* o) {
+    struct mjs_property* p;
+    size_t count = 0;
+    size_t capacity = 16;
+
+    free(o->index);
+    o->index = NULL;
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        count++;
+    }
+    if(MJS_OBJECT_INDEX_THRESHOLD == 0 || count < MJS_OBJECT_INDEX_THRESHOLD) return;
+
+    while(count * 4 > capacity * 3) {
+        capacity *= 2;
+    }
+
+    o->index = mjs_property_index_alloc(capacity);
+    for(p = o->properties; p != NULL; p = p->next) {
+        size_t n;
+        const char* s = mjs_get_string(mjs, &p->name, &n);
+        mjs_property_index_put(o->index, p, mjs_property_hash(s, n));
+    }
+}
+
+static int mjs_object_needs_index(const struct mjs_object* o) {
+    const struct mjs_property* p = o->properties;
+    size_t count = 0;
+
+    if(MJS_OBJECT_INDEX_THRESHOLD == 0) return 0;
+    for(; p != NULL && count < MJS_OBJECT_INDEX_THRESHOLD; p = p->next) {
+        count++;
+    }
+    return count == MJS_OBJECT_INDEX_THRESHOLD;
+}
+
 MJS_PRIVATE mjs_val_t mjs_object_to_value(struct mjs_object* o) {
     if(o == NULL) {
         return MJS_NULL;
@@ -27,11 +156,13 @@ MJS_PRIVATE void mjs_obj_destructor(struct mjs* mjs, void* cell) {
 
     struct mjs_property* destructor = mjs_get_own_property(
         mjs, obj_val, MJS_DESTRUCTOR_PROP_NAME, strlen(MJS_DESTRUCTOR_PROP_NAME));
-    if(!destructor) return;
-    if(!mjs_is_foreign(destructor->value)) return;
+    if(destructor && mjs_is_foreign(destructor->value)) {
+        mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
+        if(destructor_fn) destructor_fn(mjs, obj_val);
+    }
 
-    mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
-    if(destructor_fn) destructor_fn(mjs, obj_val);
+    free(obj->index);
+    obj->index = NULL;
 }
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v) {
@@ -52,6 +183,7 @@ mjs_val_t mjs_mk_object(struct mjs* mjs) {
     }
     (void)mjs;
     o->properties = NULL;
+    o->index = NULL;
     return mjs_object_to_value(o);
 }
 
@@ -75,6 +207,18 @@ MJS_PRIVATE struct mjs_property*
 
     o = get_object_struct(obj);
 
+    if(o->index != NULL) {
+        /* Short names are stored inline, compare them as values */
+        mjs_val_t ss = len <= 5 ? mjs_mk_string(mjs, name, len, 1) : MJS_UNDEFINED;
+        uint32_t hash = mjs_property_hash(name, len == (size_t)~0 ? strlen(name) : len);
+        size_t i = hash & o->index->mask;
+        for(; (p = o->index->entries[i].prop) != NULL; i = (i + 1) & o->index->mask) {
+            if(o->index->entries[i].hash != hash) continue;
+            if(len <= 5 ? p->name == ss : mjs_strcmp(mjs, &p->name, name, len) == 0) return p;
+        }
+        return NULL;
+    }
+
     if(len <= 5) {
         mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
         for(p = o->properties; p != NULL; p = p->next) {
@@ -196,10 +340,14 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
 
     if(p == NULL) {
         struct mjs_object* o;
+        uint32_t hash;
         if(!mjs_is_object_based(obj)) {
             return MJS_REFERENCE_ERROR;
         }
 
+        /* Hash before making the name string, it may move `name` */
+        hash = mjs_property_hash(name, name_len == (size_t)~0 ? strlen(name) : name_len);
+
         /*
      * name_v might be not a string here. In this case, we need to create a new
      * `name_v`, which will be a string.
@@ -213,6 +361,12 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
         o = get_object_struct(obj);
         p->next = o->properties;
         o->properties = p;
+
+        if(o->index != NULL) {
+            mjs_object_index_add(o, p, hash);
+        } else if(mjs_object_needs_index(o)) {
+            mjs_object_rebuild_index(mjs, o);
+        }
     }
 
     p->value = val;
@@ -233,7 +387,8 @@ MJS_PRIVATE void mjs_destroy_property(struct mjs_property** p) {
  * See comments in `object_public.h`
  */
 int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
-    struct mjs_property *prop, *prev;
+    struct mjs_property *prop, *prev, *target;
+    struct mjs_object* o;
 
     if(!mjs_is_object_based(obj)) {
         return -1;
@@ -241,21 +396,36 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
     if(len == (size_t)~0) {
         len = strlen(name);
     }
-    for(prev = NULL, prop = get_object_struct(obj)->properties; prop != NULL;
-        prev = prop, prop = prop->next) {
-        size_t n;
-        const char* s = mjs_get_string(mjs, &prop->name, &n);
-        if(n == len && strncmp(s, name, len) == 0) {
-            if(prev) {
-                prev->next = prop->next;
-            } else {
-                get_object_struct(obj)->properties = prop->next;
-            }
-            mjs_destroy_property(&prop);
-            return 0;
+    o = get_object_struct(obj);
+
+    if(o->index != NULL) {
+        /*
+         * Find the property through the index, so unlinking it only compares
+         * pointers. The index is kept when the object shrinks below the
+         * threshold, so that alternating adds and deletes don't rebuild it.
+         */
+        target = mjs_get_own_property(mjs, obj, name, len);
+        if(target == NULL) return -1;
+        mjs_object_index_remove(o, target, mjs_property_hash(name, len));
+        for(prev = NULL, prop = o->properties; prop != target; prop = prop->next) {
+            prev = prop;
+        }
+    } else {
+        for(prev = NULL, prop = o->properties; prop != NULL; prev = prop, prop = prop->next) {
+            size_t n;
+            const char* s = mjs_get_string(mjs, &prop->name, &n);
+            if(n == len && strncmp(s, name, len) == 0) break;
         }
+        if(prop == NULL) return -1;
+    }
+
+    if(prev) {
+        prev->next = prop->next;
+    } else {
+        o->properties = prop->next;
     }
-    return -1;
+    mjs_destroy_property(&prop);
+    return 0;
 }
 
 mjs_val_t mjs_next(struct mjs* mjs, mjs_val_t obj, mjs_val_t* iterator) {
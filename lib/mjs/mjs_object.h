@@ -21,8 +21,12 @@ struct mjs_property {
     mjs_val_t value; /* Property value */
 };
 
+struct mjs_property_index;
+
 struct mjs_object {
     struct mjs_property* properties;
+    /* Hash index over `properties`, NULL for small objects */
+    struct mjs_property_index* index;
 };
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v);
@@ -55,6 +59,12 @@ MJS_PRIVATE void mjs_op_create_object(struct mjs* mjs);
  */
 MJS_PRIVATE void mjs_op_object_define_property(struct mjs* mjs);
 
+/*
+ * Drop the object's property index and build a new one if the object is
+ * big enough (see `MJS_OBJECT_INDEX_THRESHOLD`)
+ */
+MJS_PRIVATE void mjs_object_rebuild_index(struct mjs* mjs, struct mjs_object* o);
+
 /*
  * Cell destructor for object arena
  */
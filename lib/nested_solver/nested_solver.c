@@ -0,0 +1,585 @@
+#include "nested_solver.h"
+#include "nested_solver_crypto1.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Work is handed out in chunks of keys. Each worker owns a range of the key space and
+// takes chunks from its front, the chunk being processed stays in the range until it's
+// done. Idle workers take ranges from the pool first, then steal the back half of the
+// largest worker range. Checkpoint is the pool plus every worker range, so the chunks
+// in progress are searched again after resume.
+
+#define NESTED_SOLVER_CHUNK_SIZE        (1ULL << 22)
+#define NESTED_SOLVER_THREADS_MAX       (256U)
+#define NESTED_SOLVER_POLL_INTERVAL_MS  (100U)
+#define NESTED_SOLVER_REPORT_INTERVAL_S (1U)
+#define NESTED_SOLVER_RANGES_MAX        (NESTED_SOLVER_THREADS_MAX * 4U)
+#define NESTED_SOLVER_FOUND_MAX         (1024U)
+
+#define NESTED_SOLVER_CHECKPOINT_HEADER  "Nested solver checkpoint"
+#define NESTED_SOLVER_CHECKPOINT_VERSION (1U)
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+} NestedSolverRange;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    NestedSolverRange range;
+} NestedSolverQueue;
+
+typedef struct {
+    size_t target_index;
+    uint64_t key;
+} NestedSolverFound;
+
+typedef struct NestedSolverWorker NestedSolverWorker;
+
+struct NestedSolverWorker {
+    NestedSolver* solver;
+    pthread_t thread;
+    NestedSolverQueue queue;
+};
+
+struct NestedSolver {
+    NestedSolverConfig config;
+    NestedSolverCallbacks callbacks;
+    size_t threads;
+
+    NestedSolverWorker* workers;
+    const NestedSolverTarget* target;
+    size_t target_index;
+    bool target_sum_valid;
+    uint16_t target_sum;
+
+    // Ranges not owned by any worker
+    pthread_mutex_t pool_mutex;
+    NestedSolverRange pool[NESTED_SOLVER_RANGES_MAX];
+    size_t pool_count;
+
+    pthread_mutex_t found_mutex;
+    NestedSolverFound found[NESTED_SOLVER_FOUND_MAX];
+    size_t found_count;
+    size_t found_reported;
+
+    atomic_uint_fast64_t keys_done;
+    atomic_uint running;
+    atomic_bool target_done;
+    volatile sig_atomic_t stop;
+};
+
+static uint64_t nested_solver_align(uint64_t key) {
+    return key & ~(uint64_t)(NESTED_SOLVER_BATCH_SIZE - 1);
+}
+
+static uint64_t nested_solver_time_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void nested_solver_sleep_ms(uint32_t ms) {
+    struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000};
+    nanosleep(&ts, NULL);
+}
+
+static bool nested_solver_should_stop(NestedSolver* solver) {
+    return solver->stop || atomic_load(&solver->target_done);
+}
+
+static void nested_solver_add_found(NestedSolver* solver, uint64_t key) {
+    pthread_mutex_lock(&solver->found_mutex);
+    if(solver->found_count < NESTED_SOLVER_FOUND_MAX) {
+        solver->found[solver->found_count].target_index = solver->target_index;
+        solver->found[solver->found_count].key = key;
+        solver->found_count++;
+    }
+    pthread_mutex_unlock(&solver->found_mutex);
+
+    if(!solver->config.find_all) atomic_store(&solver->target_done, true);
+}
+
+static void nested_solver_search(NestedSolver* solver, uint64_t start, uint64_t end) {
+    const NestedSolverTarget* target = solver->target;
+
+    for(uint64_t key_base = start; key_base < end; key_base += NESTED_SOLVER_BATCH_SIZE) {
+        uint64_t mask =
+            nested_solver_crypto1_check_batch(key_base, target->nonces, target->nonces_count);
+        while(mask) {
+            uint8_t lane = __builtin_ctzll(mask);
+            mask &= mask - 1;
+            uint64_t key = key_base + lane;
+            // Cross-check the bitsliced result with the reference implementation
+            if(!nested_solver_crypto1_check_key(key, target->nonces, target->nonces_count)) {
+                continue;
+            }
+            // Sum takes 510 Crypto1 steps, too slow for every batch but cheap for the keys
+            // which passed the nonces
+            if(solver->target_sum_valid &&
+               nested_solver_crypto1_first_byte_sum(key, target->cuid) != solver->target_sum) {
+                continue;
+            }
+            nested_solver_add_found(solver, key);
+        }
+    }
+}
+
+// Take the next chunk from the own range, the chunk is left in the range until it's done
+static bool nested_solver_take_chunk(NestedSolverWorker* worker, NestedSolverRange* chunk) {
+    NestedSolverQueue* queue = &worker->queue;
+
+    pthread_mutex_lock(&queue->mutex);
+    bool taken = queue->range.start < queue->range.end;
+    if(taken) {
+        chunk->start = queue->range.start;
+        chunk->end = queue->range.start + NESTED_SOLVER_CHUNK_SIZE;
+        if(chunk->end > queue->range.end) chunk->end = queue->range.end;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return taken;
+}
+
+static void
+    nested_solver_finish_chunk(NestedSolverWorker* worker, const NestedSolverRange* chunk) {
+    NestedSolverQueue* queue = &worker->queue;
+
+    pthread_mutex_lock(&queue->mutex);
+    queue->range.start = chunk->end;
+    if(queue->range.start > queue->range.end) queue->range.end = queue->range.start;
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+static bool nested_solver_take_from_pool(NestedSolverWorker* worker) {
+    NestedSolver* solver = worker->solver;
+    bool taken = false;
+
+    pthread_mutex_lock(&solver->pool_mutex);
+    if(solver->pool_count) {
+        NestedSolverRange range = solver->pool[--solver->pool_count];
+        pthread_mutex_lock(&worker->queue.mutex);
+        worker->queue.range = range;
+        pthread_mutex_unlock(&worker->queue.mutex);
+        taken = true;
+    }
+    pthread_mutex_unlock(&solver->pool_mutex);
+
+    return taken;
+}
+
+// Steal the back half of the largest range, leaving the chunk in progress to its owner
+static bool nested_solver_steal(NestedSolverWorker* worker) {
+    NestedSolver* solver = worker->solver;
+
+    for(;;) {
+        NestedSolverWorker* victim = NULL;
+        uint64_t victim_left = 0;
+        for(size_t i = 0; i < solver->threads; i++) {
+            NestedSolverWorker* candidate = &solver->workers[i];
+            if(candidate == worker) continue;
+            pthread_mutex_lock(&candidate->queue.mutex);
+            uint64_t left = candidate->queue.range.end - candidate->queue.range.start;
+            pthread_mutex_unlock(&candidate->queue.mutex);
+            if(left > victim_left) {
+                victim = candidate;
+                victim_left = left;
+            }
+        }
+        if(victim_left <= 2 * NESTED_SOLVER_CHUNK_SIZE) return false;
+
+        // Both queues are locked for the move, so that checkpoints never miss the range.
+        // Queues are always locked in the worker order.
+        NestedSolverQueue* first = victim < worker ? &victim->queue : &worker->queue;
+        NestedSolverQueue* second = victim < worker ? &worker->queue : &victim->queue;
+        bool stolen = false;
+        pthread_mutex_lock(&first->mutex);
+        pthread_mutex_lock(&second->mutex);
+        NestedSolverRange* range = &victim->queue.range;
+        uint64_t left = range->end - range->start;
+        if(left > 2 * NESTED_SOLVER_CHUNK_SIZE) {
+            uint64_t split = nested_solver_align(range->start + NESTED_SOLVER_CHUNK_SIZE +
+                                                 (left - NESTED_SOLVER_CHUNK_SIZE) / 2);
+            worker->queue.range.start = split;
+            worker->queue.range.end = range->end;
+            range->end = split;
+            stolen = true;
+        }
+        pthread_mutex_unlock(&second->mutex);
+        pthread_mutex_unlock(&first->mutex);
+
+        // Victim range shrank meanwhile, look again
+        if(stolen) return true;
+    }
+}
+
+static void* nested_solver_worker_thread(void* context) {
+    NestedSolverWorker* worker = context;
+    NestedSolver* solver = worker->solver;
+
+    while(!nested_solver_should_stop(solver)) {
+        NestedSolverRange chunk;
+        if(!nested_solver_take_chunk(worker, &chunk)) {
+            if(nested_solver_take_from_pool(worker) || nested_solver_steal(worker)) continue;
+            break;
+        }
+
+        nested_solver_search(solver, chunk.start, chunk.end);
+        if(nested_solver_should_stop(solver) && !atomic_load(&solver->target_done)) break;
+
+        nested_solver_finish_chunk(worker, &chunk);
+        atomic_fetch_add(&solver->keys_done, chunk.end - chunk.start);
+    }
+
+    atomic_fetch_sub(&solver->running, 1);
+    return NULL;
+}
+
+static bool nested_solver_pool_add(NestedSolver* solver, uint64_t start, uint64_t end) {
+    if(start >= end) return true;
+    if(solver->pool_count == NESTED_SOLVER_RANGES_MAX) return false;
+    solver->pool[solver->pool_count].start = start;
+    solver->pool[solver->pool_count].end = end;
+    solver->pool_count++;
+    return true;
+}
+
+// Collect the ranges left to search: pool and all the worker ranges, locked at once
+static size_t nested_solver_pending(NestedSolver* solver, NestedSolverRange* ranges) {
+    size_t count = 0;
+
+    pthread_mutex_lock(&solver->pool_mutex);
+    for(size_t i = 0; i < solver->threads; i++) {
+        pthread_mutex_lock(&solver->workers[i].queue.mutex);
+    }
+
+    for(size_t i = 0; i < solver->pool_count; i++) {
+        ranges[count++] = solver->pool[i];
+    }
+    for(size_t i = 0; i < solver->threads; i++) {
+        const NestedSolverRange* range = &solver->workers[i].queue.range;
+        if(range->start < range->end) ranges[count++] = *range;
+    }
+
+    for(size_t i = solver->threads; i > 0; i--) {
+        pthread_mutex_unlock(&solver->workers[i - 1].queue.mutex);
+    }
+    pthread_mutex_unlock(&solver->pool_mutex);
+
+    return count;
+}
+
+static bool nested_solver_checkpoint_save(
+    NestedSolver* solver,
+    uint32_t fingerprint,
+    size_t target_index,
+    const NestedSolverRange* ranges,
+    size_t ranges_count) {
+    const char* path = solver->config.checkpoint_path;
+    if(!path) return true;
+
+    // Write a copy and replace the checkpoint, so that it's never left half written
+    size_t tmp_path_len = strlen(path) + sizeof(".tmp");
+    char* tmp_path = malloc(tmp_path_len);
+    snprintf(tmp_path, tmp_path_len, "%s.tmp", path);
+
+    bool success = false;
+    FILE* file = fopen(tmp_path, "w");
+    if(file) {
+        fprintf(file, "%s\n", NESTED_SOLVER_CHECKPOINT_HEADER);
+        fprintf(file, "Version: %u\n", NESTED_SOLVER_CHECKPOINT_VERSION);
+        fprintf(file, "Log: %08" PRIx32 "\n", fingerprint);
+        fprintf(
+            file,
+            "Keys: %012" PRIx64 " %012" PRIx64 "\n",
+            solver->config.key_start,
+            solver->config.key_end);
+        fprintf(file, "Target: %zu\n", target_index);
+        for(size_t i = 0; i < ranges_count; i++) {
+            fprintf(
+                file, "Pending: %012" PRIx64 " %012" PRIx64 "\n", ranges[i].start, ranges[i].end);
+        }
+        pthread_mutex_lock(&solver->found_mutex);
+        for(size_t i = 0; i < solver->found_count; i++) {
+            const NestedSolverFound* found = &solver->found[i];
+            fprintf(file, "Found: %zu %012" PRIx64 "\n", found->target_index, found->key);
+        }
+        pthread_mutex_unlock(&solver->found_mutex);
+        success = fclose(file) == 0 && rename(tmp_path, path) == 0;
+    }
+    free(tmp_path);
+
+    if(!success) fprintf(stderr, "Failed to write checkpoint %s\n", path);
+    return success;
+}
+
+// Resume from the checkpoint: sets the target to start with, fills the pool with its
+// pending ranges and restores the keys found so far
+static NestedSolverError nested_solver_checkpoint_load(
+    NestedSolver* solver,
+    uint32_t fingerprint,
+    size_t* target_index,
+    bool* resumed) {
+    *target_index = 0;
+    *resumed = false;
+
+    const char* path = solver->config.checkpoint_path;
+    if(!path) return NestedSolverErrorNone;
+    FILE* file = fopen(path, "r");
+    if(!file) return NestedSolverErrorNone;
+
+    NestedSolverError error = NestedSolverErrorCheckpoint;
+    char line[128];
+    do {
+        if(!fgets(line, sizeof(line), file)) break;
+        if(strncmp(line, NESTED_SOLVER_CHECKPOINT_HEADER, strlen(NESTED_SOLVER_CHECKPOINT_HEADER)))
+            break;
+
+        unsigned int version = 0;
+        if(!fgets(line, sizeof(line), file) || sscanf(line, "Version: %u", &version) != 1 ||
+           version != NESTED_SOLVER_CHECKPOINT_VERSION) {
+            fprintf(stderr, "Unsupported checkpoint version\n");
+            break;
+        }
+
+        uint32_t log_fingerprint = 0;
+        if(!fgets(line, sizeof(line), file) ||
+           sscanf(line, "Log: %" SCNx32, &log_fingerprint) != 1 ||
+           log_fingerprint != fingerprint) {
+            fprintf(stderr, "Checkpoint was made for a different log\n");
+            break;
+        }
+
+        uint64_t key_start = 0;
+        uint64_t key_end = 0;
+        if(!fgets(line, sizeof(line), file) ||
+           sscanf(line, "Keys: %" SCNx64 " %" SCNx64, &key_start, &key_end) != 2 ||
+           key_start != solver->config.key_start || key_end != solver->config.key_end) {
+            fprintf(stderr, "Checkpoint was made for a different key range\n");
+            break;
+        }
+
+        if(!fgets(line, sizeof(line), file) || sscanf(line, "Target: %zu", target_index) != 1)
+            break;
+
+        bool ranges_valid = true;
+        while(fgets(line, sizeof(line), file)) {
+            uint64_t start = 0;
+            uint64_t end = 0;
+            size_t found_target = 0;
+            uint64_t key = 0;
+            if(sscanf(line, "Pending: %" SCNx64 " %" SCNx64, &start, &end) == 2) {
+                if(start % NESTED_SOLVER_BATCH_SIZE || start < key_start || end > key_end ||
+                   !nested_solver_pool_add(solver, start, end)) {
+                    ranges_valid = false;
+                    break;
+                }
+            } else if(sscanf(line, "Found: %zu %" SCNx64, &found_target, &key) == 2) {
+                if(solver->found_count < NESTED_SOLVER_FOUND_MAX) {
+                    solver->found[solver->found_count].target_index = found_target;
+                    solver->found[solver->found_count].key = key;
+                    solver->found_count++;
+                }
+            }
+        }
+        if(!ranges_valid) break;
+
+        *resumed = true;
+        error = NestedSolverErrorNone;
+    } while(false);
+    fclose(file);
+
+    if(error != NestedSolverErrorNone) fprintf(stderr, "Can't resume from %s\n", path);
+    return error;
+}
+
+static void nested_solver_report_found(NestedSolver* solver) {
+    pthread_mutex_lock(&solver->found_mutex);
+    size_t count = solver->found_count;
+    pthread_mutex_unlock(&solver->found_mutex);
+
+    for(; solver->found_reported < count; solver->found_reported++) {
+        const NestedSolverFound* found = &solver->found[solver->found_reported];
+        if(solver->callbacks.key_found) {
+            solver->callbacks.key_found(
+                found->target_index, found->key, solver->callbacks.context);
+        }
+    }
+}
+
+static bool nested_solver_target_found(NestedSolver* solver, size_t target_index) {
+    bool found = false;
+    pthread_mutex_lock(&solver->found_mutex);
+    for(size_t i = 0; i < solver->found_count; i++) {
+        if(solver->found[i].target_index == target_index) {
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&solver->found_mutex);
+    return found;
+}
+
+NestedSolver*
+    nested_solver_alloc(const NestedSolverConfig* config, const NestedSolverCallbacks* callbacks) {
+    NestedSolver* solver = calloc(1, sizeof(NestedSolver));
+    solver->config = *config;
+    if(callbacks) solver->callbacks = *callbacks;
+
+    solver->config.key_start = nested_solver_align(config->key_start);
+    solver->config.key_end = nested_solver_align(config->key_end + NESTED_SOLVER_BATCH_SIZE - 1);
+    if(solver->config.key_end > NESTED_SOLVER_KEY_SPACE) {
+        solver->config.key_end = NESTED_SOLVER_KEY_SPACE;
+    }
+
+    solver->threads = config->threads;
+    if(solver->threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        solver->threads = cores > 0 ? (size_t)cores : 1;
+    }
+    if(solver->threads > NESTED_SOLVER_THREADS_MAX) solver->threads = NESTED_SOLVER_THREADS_MAX;
+
+    solver->workers = calloc(solver->threads, sizeof(NestedSolverWorker));
+    for(size_t i = 0; i < solver->threads; i++) {
+        solver->workers[i].solver = solver;
+        pthread_mutex_init(&solver->workers[i].queue.mutex, NULL);
+    }
+    pthread_mutex_init(&solver->pool_mutex, NULL);
+    pthread_mutex_init(&solver->found_mutex, NULL);
+
+    return solver;
+}
+
+void nested_solver_free(NestedSolver* solver) {
+    for(size_t i = 0; i < solver->threads; i++) {
+        pthread_mutex_destroy(&solver->workers[i].queue.mutex);
+    }
+    pthread_mutex_destroy(&solver->pool_mutex);
+    pthread_mutex_destroy(&solver->found_mutex);
+    free(solver->workers);
+    free(solver);
+}
+
+void nested_solver_stop(NestedSolver* solver) {
+    solver->stop = 1;
+}
+
+// Search one target with all the workers, pool must be filled beforehand
+static void
+    nested_solver_run_target(NestedSolver* solver, uint32_t fingerprint, uint64_t keys_total) {
+    NestedSolverRange* ranges = malloc(sizeof(NestedSolverRange) * NESTED_SOLVER_RANGES_MAX);
+
+    for(size_t i = 0; i < solver->threads; i++) {
+        solver->workers[i].queue.range.start = 0;
+        solver->workers[i].queue.range.end = 0;
+    }
+
+    // Keys done before resuming count towards progress, but not towards speed
+    uint64_t keys_skipped = keys_total;
+    size_t ranges_count = nested_solver_pending(solver, ranges);
+    for(size_t i = 0; i < ranges_count; i++) {
+        keys_skipped -= ranges[i].end - ranges[i].start;
+    }
+
+    atomic_store(&solver->target_done, false);
+    atomic_store(&solver->running, solver->threads);
+    for(size_t i = 0; i < solver->threads; i++) {
+        NestedSolverWorker* worker = &solver->workers[i];
+        pthread_create(&worker->thread, NULL, nested_solver_worker_thread, worker);
+    }
+
+    uint64_t report_time = nested_solver_time_ms();
+    uint64_t report_keys = 0;
+    uint64_t checkpoint_time = report_time;
+
+    while(atomic_load(&solver->running)) {
+        nested_solver_sleep_ms(NESTED_SOLVER_POLL_INTERVAL_MS);
+        nested_solver_report_found(solver);
+
+        uint64_t now = nested_solver_time_ms();
+        if(now - report_time >= NESTED_SOLVER_REPORT_INTERVAL_S * 1000) {
+            uint64_t keys_done = atomic_load(&solver->keys_done);
+            NestedSolverProgress progress = {
+                .target_index = solver->target_index,
+                .keys_done = keys_skipped + keys_done,
+                .keys_total = keys_total,
+                .keys_per_second = (double)(keys_done - report_keys) * 1000 / (now - report_time),
+            };
+            if(solver->callbacks.progress) {
+                solver->callbacks.progress(&progress, solver->callbacks.context);
+            }
+            report_time = now;
+            report_keys = keys_done;
+        }
+
+        if(solver->config.checkpoint_path &&
+           now - checkpoint_time >= solver->config.checkpoint_interval_s * 1000ULL) {
+            ranges_count = nested_solver_pending(solver, ranges);
+            nested_solver_checkpoint_save(
+                solver, fingerprint, solver->target_index, ranges, ranges_count);
+            checkpoint_time = now;
+        }
+    }
+
+    for(size_t i = 0; i < solver->threads; i++) {
+        pthread_join(solver->workers[i].thread, NULL);
+    }
+    nested_solver_report_found(solver);
+
+    if(solver->stop && !atomic_load(&solver->target_done)) {
+        ranges_count = nested_solver_pending(solver, ranges);
+        nested_solver_checkpoint_save(
+            solver, fingerprint, solver->target_index, ranges, ranges_count);
+    }
+
+    free(ranges);
+}
+
+NestedSolverError
+    nested_solver_run(NestedSolver* solver, const NestedSolverTarget* targets, size_t count) {
+    uint32_t fingerprint = nested_solver_targets_fingerprint(targets, count);
+    uint64_t keys_total = solver->config.key_end - solver->config.key_start;
+
+    size_t first_target = 0;
+    bool resumed = false;
+    NestedSolverError error =
+        nested_solver_checkpoint_load(solver, fingerprint, &first_target, &resumed);
+    if(error != NestedSolverErrorNone) return error;
+    nested_solver_report_found(solver);
+
+    for(size_t i = first_target; i < count; i++) {
+        solver->target = &targets[i];
+        solver->target_index = i;
+        solver->target_sum_valid = nested_solver_target_sum(&targets[i], &solver->target_sum);
+        atomic_store(&solver->keys_done, 0);
+
+        if(!resumed) {
+            solver->pool_count = 0;
+            nested_solver_pool_add(solver, solver->config.key_start, solver->config.key_end);
+        }
+        resumed = false;
+
+        if(!solver->config.find_all && nested_solver_target_found(solver, i)) continue;
+
+        nested_solver_run_target(solver, fingerprint, keys_total);
+        if(solver->stop && !atomic_load(&solver->target_done)) {
+            return NestedSolverErrorStopped;
+        }
+
+        // Next target starts from the whole key range
+        NestedSolverRange next = {solver->config.key_start, solver->config.key_end};
+        if(!nested_solver_checkpoint_save(solver, fingerprint, i + 1, &next, i + 1 < count)) {
+            return NestedSolverErrorCheckpoint;
+        }
+    }
+
+    return NestedSolverErrorNone;
+}
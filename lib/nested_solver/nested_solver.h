@@ -0,0 +1,192 @@
+/**
+ * @file nested_solver.h
+ * @brief Offline MIFARE Classic nested/hardnested key solver.
+ *
+ * Host library, not part of the firmware build. Consumes the nonce log written by
+ * the nested attack of the MIFARE Classic poller (nfc/.nested.log on the SD card)
+ * and enumerates the key space on all host cores, checking 64 candidate keys at once
+ * with a bitsliced Crypto1 implementation. Keys matching the nonces of a hardnested
+ * target are also checked against the sum property of its first nonce bytes.
+ *
+ * The log parser lives here, next to the poller, so that the solver is versioned
+ * together with the log format.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the MIFARE Classic key space */
+#define NESTED_SOLVER_KEY_SPACE (1ULL << 48)
+
+/** Maximum number of nonces kept per target key */
+#define NESTED_SOLVER_TARGET_NONCES_MAX (32U)
+
+/** Number of encrypted first nonce byte values, all of them are needed for the sum property */
+#define NESTED_SOLVER_FIRST_BYTES (256U)
+
+/** One encrypted tag nonce of a nested authentication */
+typedef struct {
+    uint32_t cuid; /**< Card UID used in the authentication */
+    uint32_t nt; /**< Plain tag nonce, valid if nt_known is set */
+    uint32_t nt_enc; /**< Encrypted tag nonce */
+    uint8_t par; /**< Encrypted parity bits, byte 0 in bit 3, even parity convention */
+    bool nt_known; /**< Plain nonce was recovered by the poller, weak PRNG only */
+} NestedSolverNonce;
+
+/** Key to be recovered and the nonces collected for it */
+typedef struct {
+    uint32_t cuid;
+    uint8_t sector;
+    char key_type; /**< 'A' or 'B' */
+    NestedSolverNonce nonces[NESTED_SOLVER_TARGET_NONCES_MAX];
+    size_t nonces_count;
+    /** Encrypted first bytes of the nonces with unknown plain text, one bit per value.
+     * Taken from every logged nonce, including the ones not kept in nonces. */
+    uint8_t first_byte_seen[NESTED_SOLVER_FIRST_BYTES / 8];
+    /** First parity bit each seen first byte was logged with, xor the byte parity */
+    uint8_t first_byte_parity[NESTED_SOLVER_FIRST_BYTES / 8];
+    /** Same first byte was logged with different parity bits, sum can't be trusted */
+    bool first_byte_conflict;
+} NestedSolverTarget;
+
+typedef enum {
+    NestedSolverErrorNone, /**< Search finished */
+    NestedSolverErrorStopped, /**< Search was stopped, checkpoint can be used to resume */
+    NestedSolverErrorCheckpoint, /**< Checkpoint can't be read, written or doesn't match the log */
+} NestedSolverError;
+
+typedef struct {
+    size_t target_index; /**< Target being searched */
+    uint64_t keys_done; /**< Keys checked for the target, including the resumed part */
+    uint64_t keys_total; /**< Keys to check for the target */
+    double keys_per_second; /**< Speed over the last report interval */
+} NestedSolverProgress;
+
+/**
+ * @brief Solver callbacks, called from the thread which runs nested_solver_run()
+ */
+typedef struct {
+    void (*progress)(const NestedSolverProgress* progress, void* context);
+    void (*key_found)(size_t target_index, uint64_t key, void* context);
+    void* context;
+} NestedSolverCallbacks;
+
+typedef struct {
+    size_t threads; /**< Worker threads, 0 to use all online cores */
+    uint64_t key_start; /**< First key to check, rounded down to 64 */
+    uint64_t key_end; /**< Key to stop at, exclusive, rounded up to 64 */
+    bool find_all; /**< Keep searching after the first key matching all nonces */
+    const char* checkpoint_path; /**< Checkpoint file, NULL to disable checkpoints */
+    uint32_t checkpoint_interval_s; /**< Seconds between checkpoint writes */
+} NestedSolverConfig;
+
+typedef struct NestedSolver NestedSolver;
+
+/**
+ * @brief Parse one line of the nested nonce log
+ *
+ * Weak PRNG lines carry two nonces with the plain nonce recovered by the poller and
+ * the PRNG distance, hardnested lines carry one nonce with unknown plain text.
+ *
+ * @param line log line, "Sec 1 key A cuid 2a234f80 nt0 ... par0 0110 ..."
+ * @param target target the line is added to, nonces are appended to it
+ * @return true if the line is well formed
+ */
+bool nested_solver_log_parse_line(const char* line, NestedSolverTarget* target);
+
+/**
+ * @brief Load the nested nonce log, grouping nonces by card, sector and key type
+ *
+ * Nonces with known plain text are ordered first, as they reject candidates faster.
+ *
+ * @param path log file path
+ * @param targets allocated target array, to be freed by the caller
+ * @return number of targets, 0 if the log can't be read or has no valid lines
+ */
+size_t nested_solver_log_load(const char* path, NestedSolverTarget** targets);
+
+/**
+ * @brief Number of candidate key bits the target nonces can verify
+ *
+ * Known plain nonces verify 32 keystream bits, unknown ones only 4 parity bits.
+ * Less than 48 bits means several keys of the key space are expected to match.
+ *
+ * @param target target
+ * @return verified bits
+ */
+size_t nested_solver_target_bits(const NestedSolverTarget* target);
+
+/**
+ * @brief Hardnested sum property of the target nonces
+ *
+ * Sum over all 256 encrypted first nonce bytes of the first parity bit xor the byte
+ * parity. Only a few sums are possible and each key has one of them, keys whose own sum
+ * differs are rejected, which cuts the false positives of targets with few nonces.
+ *
+ * @param target target
+ * @param sum sum, 0 to 256
+ * @return true if every first byte was logged, with consistent parity bits
+ */
+bool nested_solver_target_sum(const NestedSolverTarget* target, uint16_t* sum);
+
+/**
+ * @brief Fingerprint of the targets, stored in checkpoints to detect a different log
+ *
+ * @param targets target array
+ * @param count number of targets
+ * @return fingerprint
+ */
+uint32_t nested_solver_targets_fingerprint(const NestedSolverTarget* targets, size_t count);
+
+/**
+ * @brief Allocate a solver
+ *
+ * @param config solver configuration, copied
+ * @param callbacks solver callbacks, copied, can be NULL
+ * @return NestedSolver*
+ */
+NestedSolver* nested_solver_alloc(
+    const NestedSolverConfig* config,
+    const NestedSolverCallbacks* callbacks);
+
+/**
+ * @brief Free a solver
+ *
+ * @param solver NestedSolver instance, must not be running
+ */
+void nested_solver_free(NestedSolver* solver);
+
+/**
+ * @brief Search keys for all targets
+ *
+ * Targets are searched one after another, each one split between the worker threads.
+ * Idle workers steal the second half of the busiest worker range. Progress is reported
+ * once a second. If a checkpoint path is set, the checkpoint is resumed from when it
+ * exists and rewritten periodically, after each target and when the search is stopped.
+ *
+ * @param solver NestedSolver instance
+ * @param targets target array
+ * @param count number of targets
+ * @return NestedSolverError
+ */
+NestedSolverError
+    nested_solver_run(NestedSolver* solver, const NestedSolverTarget* targets, size_t count);
+
+/**
+ * @brief Request the running search to stop
+ *
+ * Async-signal-safe, can be called from a SIGINT handler.
+ *
+ * @param solver NestedSolver instance
+ */
+void nested_solver_stop(NestedSolver* solver);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,320 @@
+#include "nested_solver.h"
+#include "nested_solver_crypto1.h"
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Command line front end of the solver, built and run by scripts/nested_solver.py
+
+#define NESTED_SOLVER_CLI_CHECKPOINT_INTERVAL_S (60U)
+
+// Self test searches a window of the key space around a random key
+#define NESTED_SOLVER_CLI_SELFTEST_WINDOW (1ULL << 26)
+#define NESTED_SOLVER_CLI_SELFTEST_LOG    "/tmp/nested_solver_XXXXXX"
+
+typedef struct {
+    const NestedSolverTarget* targets;
+    size_t found;
+    uint64_t expected_key;
+    bool* expected_found;
+} NestedSolverCli;
+
+static NestedSolver* nested_solver_cli_solver;
+
+static void nested_solver_cli_sigint(int sig) {
+    (void)sig;
+    if(nested_solver_cli_solver) nested_solver_stop(nested_solver_cli_solver);
+}
+
+static void nested_solver_cli_progress(const NestedSolverProgress* progress, void* context) {
+    (void)context;
+    fprintf(
+        stderr,
+        "\rTarget %zu: %6.2f%%, %8.2f Mkeys/s ",
+        progress->target_index,
+        (double)progress->keys_done * 100 / (double)progress->keys_total,
+        progress->keys_per_second / 1e6);
+    fflush(stderr);
+}
+
+static void nested_solver_cli_key_found(size_t target_index, uint64_t key, void* context) {
+    NestedSolverCli* cli = context;
+    const NestedSolverTarget* target = &cli->targets[target_index];
+
+    fprintf(stderr, "\n");
+    printf(
+        "Sec %u key %c cuid %08" PRIx32 ": %012" PRIx64 "\n",
+        target->sector,
+        target->key_type,
+        target->cuid,
+        key);
+    fflush(stdout);
+
+    cli->found++;
+    if(cli->expected_found && key == cli->expected_key) cli->expected_found[target_index] = true;
+}
+
+static uint64_t nested_solver_cli_random(void) {
+    uint64_t value = 0;
+    for(uint8_t i = 0; i < 4; i++) {
+        value = value << 16 | (rand() & 0xFFFF);
+    }
+    return value;
+}
+
+// Parity bits as mf_classic_poller_handler_nested_collect_nt_enc() collects them
+static uint8_t nested_solver_cli_poller_parity(uint8_t parity_data, bool hardnested) {
+    uint8_t parity = 0;
+    for(int i = 0; i < 4; i++) {
+        parity = (parity << 1) | (((parity_data >> i) & 0x01) ^ 0x01);
+    }
+    if(hardnested) parity ^= 0x0F;
+    return parity;
+}
+
+// Nonce as mf_classic_poller_handler_nested_log() writes it
+static void nested_solver_cli_log_nonce(
+    FILE* file,
+    uint8_t nt_idx,
+    uint32_t nt,
+    uint32_t nt_enc,
+    uint8_t par) {
+    fprintf(
+        file,
+        " nt%u %08" PRIx32 " ks%u %08" PRIx32 " par%u ",
+        nt_idx,
+        nt,
+        nt_idx,
+        nt_enc ^ nt,
+        nt_idx);
+    for(uint8_t pb = 0; pb < 4; pb++) {
+        fprintf(file, "%u", (par >> (3 - pb)) & 1);
+    }
+}
+
+// Nested log of a card using the key everywhere: a weak PRNG nonce pair for sector 1 key A,
+// hardnested nonces covering every encrypted first byte for sector 2 key B. Card side
+// encryption and the poller parity handling are done separately, so the log goes through
+// the same conventions as one written by the poller.
+static bool nested_solver_cli_selftest_log(const char* path, uint64_t key) {
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+
+    uint32_t cuid = nested_solver_cli_random();
+    uint8_t parity_data = 0;
+
+    fprintf(file, "Sec %d key %c cuid %08" PRIx32, 1, 'A', cuid);
+    for(uint8_t nt_idx = 0; nt_idx < 2; nt_idx++) {
+        uint32_t nt = nested_solver_cli_random();
+        uint32_t nt_enc = nested_solver_crypto1_encrypt_nonce(key, cuid, nt, &parity_data);
+        uint8_t par = nested_solver_cli_poller_parity(parity_data, false);
+        nested_solver_cli_log_nonce(file, nt_idx, nt, nt_enc, par);
+    }
+    fprintf(file, " dist %u\n", (unsigned int)(nested_solver_cli_random() % 1000));
+
+    // One nonce per first byte keeps the log short, poller logs repeated ones as well
+    uint8_t seen[NESTED_SOLVER_FIRST_BYTES / 8] = {};
+    for(size_t count = 0; count < NESTED_SOLVER_FIRST_BYTES;) {
+        uint32_t nt = nested_solver_cli_random();
+        uint32_t nt_enc = nested_solver_crypto1_encrypt_nonce(key, cuid, nt, &parity_data);
+        uint8_t byte = nt_enc >> 24;
+        if(seen[byte / 8] & (1 << (byte % 8))) continue;
+        seen[byte / 8] |= 1 << (byte % 8);
+        count++;
+
+        uint8_t par = nested_solver_cli_poller_parity(parity_data, true);
+        fprintf(file, "Sec %d key %c cuid %08" PRIx32, 2, 'B', cuid);
+        // Plain nonce of a hard PRNG card is unknown, poller logs it as 0
+        nested_solver_cli_log_nonce(file, 0, 0, nt_enc, par);
+        fprintf(file, "\n");
+    }
+
+    return fclose(file) == 0;
+}
+
+static void nested_solver_cli_usage(const char* name) {
+    fprintf(
+        stderr,
+        "Usage: %s [options] <nested log>\n"
+        "       %s [options] -s\n"
+        "Options:\n"
+        "  -t <threads>     worker threads, all cores by default\n"
+        "  -r <start:end>   key range to search, hex, end exclusive\n"
+        "  -c <checkpoint>  checkpoint file to resume from and update\n"
+        "  -i <seconds>     checkpoint interval, %u by default\n"
+        "  -a               find all matching keys, not only the first one\n"
+        "  -k <key>         key expected for every target, hex, fails if not found\n"
+        "  -s               self test on a nonce log made with a random key\n"
+        "  -w <log>         keep the self test log\n",
+        name,
+        name,
+        NESTED_SOLVER_CLI_CHECKPOINT_INTERVAL_S);
+}
+
+int main(int argc, char** argv) {
+    NestedSolverConfig config = {
+        .key_end = NESTED_SOLVER_KEY_SPACE,
+        .checkpoint_interval_s = NESTED_SOLVER_CLI_CHECKPOINT_INTERVAL_S,
+    };
+    NestedSolverCli cli = {};
+    bool expected_set = false;
+    bool selftest = false;
+    const char* selftest_log = NULL;
+    bool range_set = false;
+
+    int opt = 0;
+    while((opt = getopt(argc, argv, "t:r:c:i:ak:sw:h")) != -1) {
+        switch(opt) {
+        case 't':
+            config.threads = strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            if(sscanf(optarg, "%" SCNx64 ":%" SCNx64, &config.key_start, &config.key_end) != 2 ||
+               config.key_start >= config.key_end || config.key_end > NESTED_SOLVER_KEY_SPACE) {
+                fprintf(stderr, "Invalid key range %s\n", optarg);
+                return 1;
+            }
+            range_set = true;
+            break;
+        case 'c':
+            config.checkpoint_path = optarg;
+            break;
+        case 'i':
+            config.checkpoint_interval_s = strtoul(optarg, NULL, 10);
+            break;
+        case 'a':
+            config.find_all = true;
+            break;
+        case 'k':
+            if(sscanf(optarg, "%" SCNx64, &cli.expected_key) != 1 ||
+               cli.expected_key >= NESTED_SOLVER_KEY_SPACE) {
+                fprintf(stderr, "Invalid key %s\n", optarg);
+                return 1;
+            }
+            expected_set = true;
+            break;
+        case 's':
+            selftest = true;
+            break;
+        case 'w':
+            selftest_log = optarg;
+            break;
+        default:
+            nested_solver_cli_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    NestedSolverTarget* targets = NULL;
+    size_t count = 0;
+    const char* log_path = NULL;
+    char selftest_path[] = NESTED_SOLVER_CLI_SELFTEST_LOG;
+
+    if(selftest) {
+        srand(time(NULL));
+        cli.expected_key = nested_solver_cli_random() % NESTED_SOLVER_KEY_SPACE;
+        expected_set = true;
+        if(!range_set) {
+            config.key_start = cli.expected_key & ~(NESTED_SOLVER_CLI_SELFTEST_WINDOW - 1);
+            config.key_end = config.key_start + NESTED_SOLVER_CLI_SELFTEST_WINDOW;
+        }
+        fprintf(stderr, "Self test key %012" PRIx64 "\n", cli.expected_key);
+
+        log_path = selftest_log;
+        if(!log_path) {
+            int fd = mkstemp(selftest_path);
+            if(fd < 0) {
+                fprintf(stderr, "Can't create %s\n", selftest_path);
+                return 1;
+            }
+            close(fd);
+            log_path = selftest_path;
+        }
+        if(!nested_solver_cli_selftest_log(log_path, cli.expected_key)) {
+            fprintf(stderr, "Can't write %s\n", log_path);
+            return 1;
+        }
+    } else {
+        if(optind != argc - 1) {
+            nested_solver_cli_usage(argv[0]);
+            return 1;
+        }
+        log_path = argv[optind];
+    }
+
+    count = nested_solver_log_load(log_path, &targets);
+    if(selftest && !selftest_log) remove(log_path);
+    if(!count) {
+        fprintf(stderr, "No nonces found in %s\n", log_path);
+        return 1;
+    }
+
+    if(expected_set) {
+        // Targets with fewer bits than the key match other keys too, keep searching
+        config.find_all = true;
+        cli.expected_found = calloc(count, sizeof(bool));
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        const NestedSolverTarget* target = &targets[i];
+        size_t bits = nested_solver_target_bits(target);
+        uint16_t sum = 0;
+        bool sum_valid = nested_solver_target_sum(target, &sum);
+        fprintf(
+            stderr,
+            "Target %zu: Sec %u key %c cuid %08" PRIx32 ", %zu nonces, %zu bits",
+            i,
+            target->sector,
+            target->key_type,
+            target->cuid,
+            target->nonces_count,
+            bits);
+        if(sum_valid) fprintf(stderr, ", first byte sum %u", sum);
+        fprintf(stderr, "%s\n", bits < 48 ? ", false positives expected" : "");
+    }
+
+    cli.targets = targets;
+    NestedSolverCallbacks callbacks = {
+        .progress = nested_solver_cli_progress,
+        .key_found = nested_solver_cli_key_found,
+        .context = &cli,
+    };
+    nested_solver_cli_solver = nested_solver_alloc(&config, &callbacks);
+    signal(SIGINT, nested_solver_cli_sigint);
+
+    NestedSolverError error = nested_solver_run(nested_solver_cli_solver, targets, count);
+    fprintf(stderr, "\n");
+
+    signal(SIGINT, SIG_DFL);
+    nested_solver_free(nested_solver_cli_solver);
+    nested_solver_cli_solver = NULL;
+    free(targets);
+
+    int ret = 0;
+    if(error == NestedSolverErrorStopped) {
+        fprintf(stderr, "Stopped%s\n", config.checkpoint_path ? ", checkpoint saved" : "");
+        ret = 2;
+    } else if(error == NestedSolverErrorCheckpoint) {
+        ret = 1;
+    } else if(expected_set) {
+        size_t missing = 0;
+        for(size_t i = 0; i < count; i++) {
+            if(!cli.expected_found[i]) missing++;
+        }
+        if(missing) fprintf(stderr, "Expected key not found for %zu targets\n", missing);
+        if(selftest) fprintf(stderr, "Self test %s\n", missing ? "failed" : "passed");
+        ret = missing ? 1 : 0;
+    } else if(!cli.found) {
+        fprintf(stderr, "No keys found\n");
+        ret = 1;
+    }
+    free(cli.expected_found);
+
+    return ret;
+}
@@ -0,0 +1,314 @@
+#include "nested_solver_crypto1.h"
+
+// Reference implementation follows crypto1.c of the NFC library, which needs furi.
+// Bitsliced implementation keeps the LFSR as a sequence of 64 lane bit masks, newest
+// bit last: odd half bit j is seq[n - 2j], even half bit j is seq[n - 1 - 2j].
+
+#define NESTED_SOLVER_LF_POLY_ODD  (0x29CE5C)
+#define NESTED_SOLVER_LF_POLY_EVEN (0x870804)
+
+// Filter function: nibble functions of the odd half bits 0-19, combined by fc
+#define NESTED_SOLVER_FILTER_FA (0xF22CU)
+#define NESTED_SOLVER_FILTER_FB (0xD938U)
+#define NESTED_SOLVER_FILTER_FC (0xEC57E80AU)
+
+#define NESTED_SOLVER_LFSR_BITS  (48U)
+#define NESTED_SOLVER_NONCE_BITS (32U)
+
+// Sequence holds the key and the bits shifted in while the nonce and one more bit are fed
+#define NESTED_SOLVER_SEQ_LEN (NESTED_SOLVER_LFSR_BITS + NESTED_SOLVER_NONCE_BITS + 1U)
+
+// Bits are fed MSB byte first, LSB first within a byte
+#define NESTED_SOLVER_BEBIT(x, t) (((x) >> ((t) ^ 24U)) & 1U)
+
+#define NESTED_SOLVER_LANES(bit) ((uint64_t)0 - (uint64_t)((bit) & 1U))
+
+#define NESTED_SOLVER_ALWAYS_INLINE inline __attribute__((always_inline))
+
+typedef struct {
+    uint32_t odd;
+    uint32_t even;
+} NestedSolverCrypto1;
+
+static inline uint8_t nested_solver_even_parity8(uint8_t data) {
+    return __builtin_parity(data);
+}
+
+static inline uint32_t nested_solver_filter(uint32_t in) {
+    uint32_t out = 0;
+    out |= (NESTED_SOLVER_FILTER_FA >> (in & 0xf) & 1) << 4;
+    out |= (NESTED_SOLVER_FILTER_FB >> (in >> 4 & 0xf) & 1) << 3;
+    out |= (NESTED_SOLVER_FILTER_FA >> (in >> 8 & 0xf) & 1) << 2;
+    out |= (NESTED_SOLVER_FILTER_FA >> (in >> 12 & 0xf) & 1) << 1;
+    out |= (NESTED_SOLVER_FILTER_FB >> (in >> 16 & 0xf) & 1);
+    return NESTED_SOLVER_FILTER_FC >> out & 1;
+}
+
+static void nested_solver_crypto1_init(NestedSolverCrypto1* crypto1, uint64_t key) {
+    crypto1->odd = 0;
+    crypto1->even = 0;
+    for(int8_t i = 47; i > 0; i -= 2) {
+        crypto1->odd = crypto1->odd << 1 | (key >> ((i - 1) ^ 7) & 1);
+        crypto1->even = crypto1->even << 1 | (key >> (i ^ 7) & 1);
+    }
+}
+
+static uint8_t
+    nested_solver_crypto1_bit(NestedSolverCrypto1* crypto1, uint8_t in, bool is_encrypted) {
+    uint32_t out = nested_solver_filter(crypto1->odd);
+    uint32_t feed = (out & is_encrypted) ^ (in & 1);
+    feed ^= __builtin_parity(
+        (crypto1->odd & NESTED_SOLVER_LF_POLY_ODD) ^ (crypto1->even & NESTED_SOLVER_LF_POLY_EVEN));
+    crypto1->even = crypto1->even << 1 | feed;
+
+    uint32_t tmp = crypto1->odd;
+    crypto1->odd = crypto1->even;
+    crypto1->even = tmp;
+    return out;
+}
+
+static uint32_t
+    nested_solver_crypto1_word(NestedSolverCrypto1* crypto1, uint32_t in, bool is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t t = 0; t < NESTED_SOLVER_NONCE_BITS; t++) {
+        uint32_t bit =
+            nested_solver_crypto1_bit(crypto1, NESTED_SOLVER_BEBIT(in, t), is_encrypted);
+        out |= bit << (t ^ 24U);
+    }
+    return out;
+}
+
+// Parity of each decrypted nonce byte must match the encrypted parity bit and the
+// keystream bit which follows the byte
+static bool nested_solver_parity_matches(uint32_t nt, uint32_t ks, uint8_t next_ks, uint8_t par) {
+    uint8_t ks_next[] = {
+        NESTED_SOLVER_BEBIT(ks, 8),
+        NESTED_SOLVER_BEBIT(ks, 16),
+        NESTED_SOLVER_BEBIT(ks, 24),
+        next_ks,
+    };
+    for(uint8_t i = 0; i < 4; i++) {
+        uint8_t byte = nt >> (24 - 8 * i);
+        uint8_t par_bit = par >> (3 - i) & 1;
+        if(nested_solver_even_parity8(byte) != (par_bit ^ ks_next[i])) return false;
+    }
+    return true;
+}
+
+bool nested_solver_crypto1_check_key(uint64_t key, const NestedSolverNonce* nonces, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        const NestedSolverNonce* nonce = &nonces[i];
+        NestedSolverCrypto1 crypto1;
+        nested_solver_crypto1_init(&crypto1, key);
+
+        if(nonce->nt_known) {
+            uint32_t ks = nested_solver_crypto1_word(&crypto1, nonce->cuid ^ nonce->nt, false);
+            if(ks != (nonce->nt ^ nonce->nt_enc)) return false;
+        } else {
+            uint32_t ks = nested_solver_crypto1_word(&crypto1, nonce->cuid ^ nonce->nt_enc, true);
+            uint8_t next_ks = nested_solver_filter(crypto1.odd);
+            if(!nested_solver_parity_matches(nonce->nt_enc ^ ks, ks, next_ks, nonce->par)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+uint32_t nested_solver_crypto1_encrypt_nonce(
+    uint64_t key,
+    uint32_t cuid,
+    uint32_t nt,
+    uint8_t* parity_data) {
+    NestedSolverCrypto1 crypto1;
+    nested_solver_crypto1_init(&crypto1, key);
+
+    uint32_t ks = nested_solver_crypto1_word(&crypto1, cuid ^ nt, false);
+    uint8_t next_ks = nested_solver_filter(crypto1.odd);
+
+    uint8_t ks_next[] = {
+        NESTED_SOLVER_BEBIT(ks, 8),
+        NESTED_SOLVER_BEBIT(ks, 16),
+        NESTED_SOLVER_BEBIT(ks, 24),
+        next_ks,
+    };
+    *parity_data = 0;
+    for(uint8_t i = 0; i < 4; i++) {
+        uint8_t byte = nt >> (24 - 8 * i);
+        uint8_t odd_parity = nested_solver_even_parity8(byte) ^ 1;
+        *parity_data |= (odd_parity ^ ks_next[i]) << i;
+    }
+
+    return nt ^ ks;
+}
+
+// Feeds the remaining bits of the encrypted first byte for all their values. Parity bit
+// xor the encrypted byte parity is the keystream byte parity xor the next keystream bit.
+static uint16_t nested_solver_crypto1_first_byte_sum_step(
+    NestedSolverCrypto1 crypto1,
+    uint32_t cuid,
+    uint8_t ks_parity,
+    uint8_t t) {
+    if(t == 8) return ks_parity ^ nested_solver_filter(crypto1.odd);
+
+    uint16_t sum = 0;
+    for(uint8_t bit = 0; bit < 2; bit++) {
+        NestedSolverCrypto1 next = crypto1;
+        uint8_t ks = nested_solver_crypto1_bit(&next, NESTED_SOLVER_BEBIT(cuid, t) ^ bit, true);
+        sum += nested_solver_crypto1_first_byte_sum_step(next, cuid, ks_parity ^ ks, t + 1);
+    }
+    return sum;
+}
+
+uint16_t nested_solver_crypto1_first_byte_sum(uint64_t key, uint32_t cuid) {
+    NestedSolverCrypto1 crypto1;
+    nested_solver_crypto1_init(&crypto1, key);
+    return nested_solver_crypto1_first_byte_sum_step(crypto1, cuid, 0, 0);
+}
+
+// Select b in the lanes where s is set, a elsewhere
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t
+    nested_solver_mux(uint64_t s, uint64_t a, uint64_t b) {
+    return a ^ (s & (a ^ b));
+}
+
+// Four input function given by its truth table, folds into a few gates for a constant table
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t
+    nested_solver_lut4(uint16_t table, uint64_t x0, uint64_t x1, uint64_t x2, uint64_t x3) {
+    uint64_t level0[8];
+    for(uint8_t i = 0; i < 8; i++) {
+        level0[i] = nested_solver_mux(
+            x0, NESTED_SOLVER_LANES(table >> (2 * i)), NESTED_SOLVER_LANES(table >> (2 * i + 1)));
+    }
+    uint64_t level1[4];
+    for(uint8_t i = 0; i < 4; i++) {
+        level1[i] = nested_solver_mux(x1, level0[2 * i], level0[2 * i + 1]);
+    }
+    uint64_t level2[2];
+    for(uint8_t i = 0; i < 2; i++) {
+        level2[i] = nested_solver_mux(x2, level1[2 * i], level1[2 * i + 1]);
+    }
+    return nested_solver_mux(x3, level2[0], level2[1]);
+}
+
+// Five input fc function, x4 is the most significant index bit
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t nested_solver_lut5(
+    uint32_t table,
+    uint64_t x0,
+    uint64_t x1,
+    uint64_t x2,
+    uint64_t x3,
+    uint64_t x4) {
+    uint64_t lo = nested_solver_lut4(table & 0xffff, x0, x1, x2, x3);
+    uint64_t hi = nested_solver_lut4(table >> 16, x0, x1, x2, x3);
+    return nested_solver_mux(x4, lo, hi);
+}
+
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t
+    nested_solver_bs_filter_nibble(uint16_t table, const uint64_t* seq, size_t n, uint8_t nibble) {
+    size_t j = 4 * nibble;
+    return nested_solver_lut4(
+        table, seq[n - 2 * j], seq[n - 2 * (j + 1)], seq[n - 2 * (j + 2)], seq[n - 2 * (j + 3)]);
+}
+
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t
+    nested_solver_bs_filter(const uint64_t* seq, size_t n) {
+    uint64_t a = nested_solver_bs_filter_nibble(NESTED_SOLVER_FILTER_FA, seq, n, 0);
+    uint64_t b = nested_solver_bs_filter_nibble(NESTED_SOLVER_FILTER_FB, seq, n, 1);
+    uint64_t c = nested_solver_bs_filter_nibble(NESTED_SOLVER_FILTER_FA, seq, n, 2);
+    uint64_t d = nested_solver_bs_filter_nibble(NESTED_SOLVER_FILTER_FA, seq, n, 3);
+    uint64_t e = nested_solver_bs_filter_nibble(NESTED_SOLVER_FILTER_FB, seq, n, 4);
+    return nested_solver_lut5(NESTED_SOLVER_FILTER_FC, e, d, c, b, a);
+}
+
+static NESTED_SOLVER_ALWAYS_INLINE uint64_t
+    nested_solver_bs_feedback(const uint64_t* seq, size_t n) {
+    uint64_t feed = 0;
+    for(uint8_t j = 0; j < 24; j++) {
+        if(NESTED_SOLVER_LF_POLY_ODD >> j & 1) feed ^= seq[n - 2 * j];
+        if(NESTED_SOLVER_LF_POLY_EVEN >> j & 1) feed ^= seq[n - 1 - 2 * j];
+    }
+    return feed;
+}
+
+// Lane i holds key_base + i, so key bits 0-5 differ between lanes
+static void nested_solver_bs_load_key(uint64_t* seq, uint64_t key_base) {
+    static const uint64_t lane_bits[] = {
+        0xAAAAAAAAAAAAAAAAULL,
+        0xCCCCCCCCCCCCCCCCULL,
+        0xF0F0F0F0F0F0F0F0ULL,
+        0xFF00FF00FF00FF00ULL,
+        0xFFFF0000FFFF0000ULL,
+        0xFFFFFFFF00000000ULL,
+    };
+
+    for(uint8_t k = 0; k < NESTED_SOLVER_LFSR_BITS; k++) {
+        uint64_t lanes = k < 6 ? lane_bits[k] : NESTED_SOLVER_LANES(key_base >> k);
+        seq[NESTED_SOLVER_LFSR_BITS - 1 - (k ^ 7)] = lanes;
+    }
+}
+
+static uint64_t nested_solver_bs_check_known(
+    uint64_t* seq,
+    const NestedSolverNonce* nonce,
+    uint64_t alive) {
+    uint32_t in = nonce->cuid ^ nonce->nt;
+    uint32_t ks = nonce->nt ^ nonce->nt_enc;
+
+    for(size_t t = 0; t < NESTED_SOLVER_NONCE_BITS; t++) {
+        size_t n = NESTED_SOLVER_LFSR_BITS - 1 + t;
+        uint64_t out = nested_solver_bs_filter(seq, n);
+        alive &= ~(out ^ NESTED_SOLVER_LANES(NESTED_SOLVER_BEBIT(ks, t)));
+        if(!alive) break;
+        seq[n + 1] =
+            nested_solver_bs_feedback(seq, n) ^ NESTED_SOLVER_LANES(NESTED_SOLVER_BEBIT(in, t));
+    }
+
+    return alive;
+}
+
+// Nonce is decrypted as it's fed, decrypted byte parity is checked with the next keystream bit
+static uint64_t nested_solver_bs_check_parity(
+    uint64_t* seq,
+    const NestedSolverNonce* nonce,
+    uint64_t alive) {
+    uint64_t parity = 0;
+
+    for(size_t t = 0; t <= NESTED_SOLVER_NONCE_BITS; t++) {
+        size_t n = NESTED_SOLVER_LFSR_BITS - 1 + t;
+        uint64_t out = nested_solver_bs_filter(seq, n);
+        if(t && t % 8 == 0) {
+            uint8_t par_bit = nonce->par >> (4 - t / 8) & 1;
+            alive &= ~(parity ^ out ^ NESTED_SOLVER_LANES(par_bit));
+            if(!alive || t == NESTED_SOLVER_NONCE_BITS) break;
+            parity = 0;
+        }
+
+        uint64_t nt_bit = NESTED_SOLVER_LANES(NESTED_SOLVER_BEBIT(nonce->nt_enc, t)) ^ out;
+        parity ^= nt_bit;
+        seq[n + 1] = nested_solver_bs_feedback(seq, n) ^
+                     NESTED_SOLVER_LANES(NESTED_SOLVER_BEBIT(nonce->cuid, t)) ^ nt_bit;
+    }
+
+    return alive;
+}
+
+uint64_t nested_solver_crypto1_check_batch(
+    uint64_t key_base,
+    const NestedSolverNonce* nonces,
+    size_t count) {
+    uint64_t seq[NESTED_SOLVER_SEQ_LEN];
+    uint64_t alive = UINT64_MAX;
+
+    for(size_t i = 0; i < count && alive; i++) {
+        nested_solver_bs_load_key(seq, key_base);
+        if(nonces[i].nt_known) {
+            alive = nested_solver_bs_check_known(seq, &nonces[i], alive);
+        } else {
+            alive = nested_solver_bs_check_parity(seq, &nonces[i], alive);
+        }
+    }
+
+    return alive;
+}
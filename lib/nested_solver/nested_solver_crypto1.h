@@ -0,0 +1,77 @@
+/**
+ * @file nested_solver_crypto1.h
+ * @brief Crypto1 candidate key checks of the nested solver.
+ */
+#pragma once
+
+#include "nested_solver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Keys checked by one bitsliced batch */
+#define NESTED_SOLVER_BATCH_SIZE (64U)
+
+/**
+ * @brief Check 64 keys against the nonces at once
+ *
+ * Lane i of the result stands for key_base + i. Lanes are dropped as soon as they
+ * mismatch a keystream or parity bit, the batch is abandoned once no lanes are left.
+ *
+ * @param key_base first key of the batch, multiple of 64
+ * @param nonces nonces to check
+ * @param count number of nonces
+ * @return mask of the keys matching all nonces
+ */
+uint64_t nested_solver_crypto1_check_batch(
+    uint64_t key_base,
+    const NestedSolverNonce* nonces,
+    size_t count);
+
+/**
+ * @brief Check one key against the nonces, reference implementation
+ *
+ * @param key key to check
+ * @param nonces nonces to check
+ * @param count number of nonces
+ * @return true if the key matches all nonces
+ */
+bool nested_solver_crypto1_check_key(uint64_t key, const NestedSolverNonce* nonces, size_t count);
+
+/**
+ * @brief Encrypt a tag nonce the way the card sends it in a nested authentication
+ *
+ * Used to produce nonce logs with a known key for self tests. Parity bits are the odd
+ * parity of each plain byte encrypted with the keystream bit which follows the byte,
+ * byte i in bit i, as the poller receives them.
+ *
+ * @param key key of the authenticated sector
+ * @param cuid card UID used in the authentication
+ * @param nt plain tag nonce
+ * @param parity_data received parity bits
+ * @return encrypted tag nonce
+ */
+uint32_t nested_solver_crypto1_encrypt_nonce(
+    uint64_t key,
+    uint32_t cuid,
+    uint32_t nt,
+    uint8_t* parity_data);
+
+/**
+ * @brief Hardnested sum property of a key
+ *
+ * Number of encrypted first nonce bytes, out of all 256, whose first parity bit in the
+ * solver convention differs from the even parity of the encrypted byte. Depends on the
+ * key and the card UID only, so it can be checked against the logged nonces without
+ * knowing any plain nonce.
+ *
+ * @param key key to check
+ * @param cuid card UID used in the authentications
+ * @return sum, 0 to 256
+ */
+uint16_t nested_solver_crypto1_first_byte_sum(uint64_t key, uint32_t cuid);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,225 @@
+#include "nested_solver.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Log lines are written by mf_classic_poller_handler_nested_log():
+//   Sec %d key %c cuid %08lx nt0 %08lx ks0 %08lx par0 %u%u%u%u[ nt1 ... par1 ...][ dist %u]
+// ks is nt_enc ^ nt. Weak PRNG lines end with the PRNG distance, and carry two nonces
+// unless the card uses static encrypted nonces. Hardnested lines have no distance,
+// plain nonce is unknown and logged as 0.
+//
+// Poller inverts the parity bits it receives, giving the even parity convention the
+// solver checks: even parity of the plain byte equals the parity bit xor the next
+// keystream bit. For hardnested nonces it flips them back before logging, so these lines
+// hold the parity bits as received.
+
+#define NESTED_SOLVER_LOG_LINE_LEN_MAX (256U)
+#define NESTED_SOLVER_LOG_NONCES_MAX   (2U)
+
+// Static encrypted nonce is only known with the Auth3 backdoor, distance is set to this otherwise
+#define NESTED_SOLVER_LOG_DIST_UNKNOWN (UINT16_MAX)
+
+static void
+    nested_solver_log_add_first_byte(NestedSolverTarget* target, const NestedSolverNonce* nonce) {
+    uint8_t byte = nonce->nt_enc >> 24;
+    uint8_t mask = 1 << (byte % 8);
+    uint8_t parity = ((nonce->par >> 3) ^ __builtin_parity(byte)) & 1 ? mask : 0;
+
+    if(target->first_byte_seen[byte / 8] & mask) {
+        if((target->first_byte_parity[byte / 8] & mask) != parity) {
+            target->first_byte_conflict = true;
+        }
+    } else {
+        target->first_byte_seen[byte / 8] |= mask;
+        target->first_byte_parity[byte / 8] |= parity;
+    }
+}
+
+static bool nested_solver_log_parse_parity(const char* bits, uint8_t* par) {
+    if(strlen(bits) != 4) return false;
+
+    *par = 0;
+    for(uint8_t i = 0; i < 4; i++) {
+        *par = *par << 1 | (bits[i] == '1');
+    }
+    return true;
+}
+
+bool nested_solver_log_parse_line(const char* line, NestedSolverTarget* target) {
+    unsigned int sector = 0;
+    char key_type = 0;
+    uint32_t cuid = 0;
+    uint32_t nt[NESTED_SOLVER_LOG_NONCES_MAX] = {};
+    uint32_t ks[NESTED_SOLVER_LOG_NONCES_MAX] = {};
+    char par_bits[NESTED_SOLVER_LOG_NONCES_MAX][5] = {};
+    int offset = 0;
+
+    int parsed = sscanf(
+        line,
+        "Sec %u key %c cuid %" SCNx32 " nt0 %" SCNx32 " ks0 %" SCNx32 " par0 %4[01]%n",
+        &sector,
+        &key_type,
+        &cuid,
+        &nt[0],
+        &ks[0],
+        par_bits[0],
+        &offset);
+    if(parsed != 6 || (key_type != 'A' && key_type != 'B')) return false;
+
+    size_t count = 1;
+    line += offset;
+    offset = 0;
+    parsed = sscanf(
+        line,
+        " nt1 %" SCNx32 " ks1 %" SCNx32 " par1 %4[01]%n",
+        &nt[1],
+        &ks[1],
+        par_bits[1],
+        &offset);
+    if(parsed == 3) {
+        count = 2;
+        line += offset;
+    }
+
+    unsigned int dist = 0;
+    bool is_weak = sscanf(line, " dist %u", &dist) == 1;
+    bool nt_known = is_weak && dist != NESTED_SOLVER_LOG_DIST_UNKNOWN;
+
+    if(target->nonces_count == 0) {
+        target->cuid = cuid;
+        target->sector = sector;
+        target->key_type = key_type;
+    } else if(target->cuid != cuid || target->sector != sector || target->key_type != key_type) {
+        return false;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        NestedSolverNonce nonce = {
+            .cuid = cuid,
+            .nt = nt_known ? nt[i] : 0,
+            .nt_enc = nt[i] ^ ks[i],
+            .nt_known = nt_known,
+        };
+        if(!nested_solver_log_parse_parity(par_bits[i], &nonce.par)) return false;
+        // Received hardnested parity to the even parity convention of the weak PRNG lines
+        if(!is_weak) nonce.par ^= 0x0F;
+
+        if(!nonce.nt_known) nested_solver_log_add_first_byte(target, &nonce);
+        if(target->nonces_count < NESTED_SOLVER_TARGET_NONCES_MAX) {
+            target->nonces[target->nonces_count++] = nonce;
+        }
+    }
+
+    return true;
+}
+
+static int nested_solver_nonce_compare(const void* a, const void* b) {
+    const NestedSolverNonce* x = a;
+    const NestedSolverNonce* y = b;
+    return (int)y->nt_known - (int)x->nt_known;
+}
+
+size_t nested_solver_log_load(const char* path, NestedSolverTarget** targets) {
+    FILE* file = fopen(path, "r");
+    if(!file) return 0;
+
+    size_t count = 0;
+    size_t capacity = 0;
+    *targets = NULL;
+
+    char line[NESTED_SOLVER_LOG_LINE_LEN_MAX];
+    while(fgets(line, sizeof(line), file)) {
+        NestedSolverTarget parsed = {};
+        if(!nested_solver_log_parse_line(line, &parsed)) continue;
+
+        NestedSolverTarget* target = NULL;
+        for(size_t i = 0; i < count; i++) {
+            NestedSolverTarget* t = &(*targets)[i];
+            if(t->cuid == parsed.cuid && t->sector == parsed.sector &&
+               t->key_type == parsed.key_type) {
+                target = t;
+                break;
+            }
+        }
+
+        if(!target) {
+            if(count == capacity) {
+                capacity = capacity ? capacity * 2 : 16;
+                *targets = realloc(*targets, capacity * sizeof(NestedSolverTarget));
+            }
+            target = &(*targets)[count++];
+            *target = parsed;
+        } else {
+            for(size_t i = 0; i < parsed.nonces_count; i++) {
+                const NestedSolverNonce* nonce = &parsed.nonces[i];
+                if(!nonce->nt_known) nested_solver_log_add_first_byte(target, nonce);
+                if(target->nonces_count < NESTED_SOLVER_TARGET_NONCES_MAX) {
+                    target->nonces[target->nonces_count++] = *nonce;
+                }
+            }
+        }
+    }
+    fclose(file);
+
+    for(size_t i = 0; i < count; i++) {
+        NestedSolverTarget* target = &(*targets)[i];
+        qsort(
+            target->nonces,
+            target->nonces_count,
+            sizeof(NestedSolverNonce),
+            nested_solver_nonce_compare);
+    }
+
+    if(count == 0) {
+        free(*targets);
+        *targets = NULL;
+    }
+
+    return count;
+}
+
+size_t nested_solver_target_bits(const NestedSolverTarget* target) {
+    size_t bits = 0;
+    for(size_t i = 0; i < target->nonces_count; i++) {
+        bits += target->nonces[i].nt_known ? 32 : 4;
+    }
+    return bits;
+}
+
+bool nested_solver_target_sum(const NestedSolverTarget* target, uint16_t* sum) {
+    if(target->first_byte_conflict) return false;
+
+    *sum = 0;
+    for(size_t i = 0; i < NESTED_SOLVER_FIRST_BYTES / 8; i++) {
+        if(target->first_byte_seen[i] != 0xFF) return false;
+        *sum += __builtin_popcount(target->first_byte_parity[i]);
+    }
+    return true;
+}
+
+uint32_t nested_solver_targets_fingerprint(const NestedSolverTarget* targets, size_t count) {
+    // FNV-1a over the fields the search depends on
+    uint32_t hash = 0x811C9DC5;
+    for(size_t i = 0; i < count; i++) {
+        // Sum filter changes the keys found, logs without it keep their fingerprint
+        uint16_t sum = 0;
+        if(nested_solver_target_sum(&targets[i], &sum)) {
+            hash ^= sum;
+            hash *= 0x01000193;
+        }
+        for(size_t j = 0; j < targets[i].nonces_count; j++) {
+            const NestedSolverNonce* nonce = &targets[i].nonces[j];
+            uint32_t fields[] = {nonce->cuid, nonce->nt, nonce->nt_enc, nonce->par};
+            for(size_t k = 0; k < sizeof(fields) / sizeof(fields[0]); k++) {
+                for(uint8_t shift = 0; shift < 32; shift += 8) {
+                    hash ^= (fields[k] >> shift) & 0xFF;
+                    hash *= 0x01000193;
+                }
+            }
+        }
+    }
+    return hash;
+}
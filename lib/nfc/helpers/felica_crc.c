@@ -1,26 +1,15 @@
 #include "felica_crc.h"
 
 #include <furi/furi.h>
+#include <toolbox/crc.h>
 
-#define FELICA_CRC_POLY (0x1021U) // Polynomial: x^16 + x^12 + x^5 + 1
 #define FELICA_CRC_INIT (0x0000U)
 
 uint16_t felica_crc_calculate(const uint8_t* data, size_t length) {
     furi_check(data);
 
-    uint16_t crc = FELICA_CRC_INIT;
-
-    for(size_t i = 0; i < length; i++) {
-        crc ^= ((uint16_t)data[i] << 8);
-        for(size_t j = 0; j < 8; j++) {
-            if(crc & 0x8000) {
-                crc <<= 1;
-                crc ^= FELICA_CRC_POLY;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
+    // Polynomial: x^16 + x^12 + x^5 + 1, MSB first
+    uint16_t crc = crc16_msb_update(FELICA_CRC_INIT, data, length);
 
     return (crc << 8) | (crc >> 8);
 }
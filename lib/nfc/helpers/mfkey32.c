@@ -0,0 +1,438 @@
+#include "mfkey32.h"
+#include "crypto1.h"
+
+#include <bit_lib/bit_lib.h>
+#include <furi.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// State recovery follows lfsr_recovery32 from crapto1 (https://github.com/RfidResearchGroup/proxmark3.git)
+// Instead of 2^21-entry odd and even tables, odd half candidates are built per window
+// of the first contribution byte and stored fully extended, even half candidates are
+// matched against them as they are generated. Only one window is kept in RAM.
+
+#define TAG "Mfkey32"
+
+#define MFKEY32_LF_POLY_ODD  (0x29CE5C)
+#define MFKEY32_LF_POLY_EVEN (0x870804)
+
+#define MFKEY32_BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+
+// Keystream bit 0 selects the initial 20-bit states, bits 1-4 extend them as is,
+// bits 5-15 extend them and track the contribution of each half in the top byte.
+// Halves of the same LFSR state have equal top bytes after steps 8, 12 and 15.
+#define MFKEY32_SIMPLE_STEPS (4U)
+#define MFKEY32_LEVEL0_END   (8U)
+#define MFKEY32_LEVEL1_END   (12U)
+#define MFKEY32_LEVEL2_END   (15U)
+
+#define MFKEY32_SEMI_STATES_NUM (1UL << 20)
+#define MFKEY32_WINDOWS_NUM     (256U)
+#define MFKEY32_POLL_INTERVAL   (1UL << 14)
+
+// Expected odd records per first contribution byte value
+#define MFKEY32_RECORDS_PER_WINDOW (MFKEY32_SEMI_STATES_NUM / 2U / MFKEY32_WINDOWS_NUM)
+
+// Heap left to the rest of the system when the budget is cut down to the free heap
+#define MFKEY32_HEAP_RESERVE (8U * 1024U)
+
+typedef struct {
+    uint32_t ks; // Keystream bits of the half
+    uint32_t m1; // Contribution masks
+    uint32_t m2;
+    uint32_t in; // Input bits, 2 per contribution step
+} Mfkey32Half;
+
+typedef struct __attribute__((packed)) {
+    uint16_t key; // Top bytes after the first and the second level
+    uint32_t state; // State after the last level, its top byte is the last one
+} Mfkey32Record;
+
+typedef struct {
+    const Mfkey32Nonces* nonces;
+    uint32_t p64b;
+    Mfkey32Half odd;
+    Mfkey32Half even;
+    uint32_t final_in;
+
+    // Window of the first contribution byte: values starting with prefix_bits of prefix
+    uint8_t prefix;
+    uint8_t prefix_bits;
+
+    // Odd half candidates of the window, sorted by key and top byte of the state
+    Mfkey32Record* records;
+    size_t capacity;
+    size_t count;
+    bool overflow;
+
+    Mfkey32ProgressCallback callback;
+    void* context;
+    float progress_base;
+    float progress_scale;
+    bool cancelled;
+
+    bool found;
+    uint64_t key;
+} Mfkey32Context;
+
+// Same as crypto1_filter, split so that states differing in bit 0 share the upper part
+static inline uint32_t mfkey32_filter_upper(uint32_t in) {
+    uint32_t out = 0;
+    out = 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return out;
+}
+
+static inline uint8_t mfkey32_filter_lower(uint32_t upper, uint32_t in) {
+    return FURI_BIT(0xEC57E80A, upper | (0xf22c0 >> (in & 0xf) & 16));
+}
+
+static inline uint8_t mfkey32_filter(uint32_t in) {
+    return mfkey32_filter_lower(mfkey32_filter_upper(in), in);
+}
+
+static inline uint32_t mfkey32_parity(uint32_t x) {
+    return __builtin_parity(x);
+}
+
+static inline uint32_t
+    mfkey32_contribution(const Mfkey32Half* half, uint32_t item, uint8_t step) {
+    uint32_t p = item >> 25;
+    p = p << 1 | mfkey32_parity(item & half->m1);
+    p = p << 1 | mfkey32_parity(item & half->m2);
+    item = p << 24 | (item & 0xffffff);
+    return item ^ ((half->in >> (2 * (step - MFKEY32_SIMPLE_STEPS)) & 3) << 24);
+}
+
+// Shift in one more bit, keep the states matching keystream bit of the step
+static inline uint8_t
+    mfkey32_extend(const Mfkey32Half* half, uint32_t item, uint8_t step, uint32_t* out) {
+    uint8_t bit = (half->ks >> step) & 1;
+    uint8_t count = 0;
+
+    item <<= 1;
+    uint32_t upper = mfkey32_filter_upper(item);
+    uint8_t f0 = mfkey32_filter_lower(upper, item);
+    uint8_t f1 = mfkey32_filter_lower(upper, item | 1);
+    if(f0 != f1) {
+        out[count++] = item | (f0 ^ bit);
+    } else if(f0 == bit) {
+        out[count++] = item;
+        out[count++] = item | 1;
+    }
+
+    if(step > MFKEY32_SIMPLE_STEPS) {
+        for(uint8_t i = 0; i < count; i++) {
+            out[i] = mfkey32_contribution(half, out[i], step);
+        }
+    }
+
+    return count;
+}
+
+// Top byte bits known after the contribution step must match the window prefix
+static inline bool mfkey32_window_match(const Mfkey32Context* ctx, uint32_t item, uint8_t step) {
+    uint8_t known = 2 * (step - MFKEY32_SIMPLE_STEPS);
+    uint8_t bits = MIN(known, ctx->prefix_bits);
+    uint32_t top = (item >> 24) & ((1U << known) - 1);
+    return (top >> (known - bits)) == (uint32_t)(ctx->prefix >> (ctx->prefix_bits - bits));
+}
+
+// Extend item through steps [from, to], at most 4 steps, dropping states outside of the window
+static uint8_t mfkey32_extend_steps(
+    const Mfkey32Context* ctx,
+    const Mfkey32Half* half,
+    uint32_t item,
+    uint8_t from,
+    uint8_t to,
+    uint32_t* out) {
+    uint32_t next[16];
+    uint8_t count = 1;
+    out[0] = item;
+
+    for(uint8_t step = from; step <= to && count; step++) {
+        uint8_t next_count = 0;
+        for(uint8_t i = 0; i < count; i++) {
+            next_count += mfkey32_extend(half, out[i], step, &next[next_count]);
+        }
+
+        count = 0;
+        for(uint8_t i = 0; i < next_count; i++) {
+            if(step > MFKEY32_SIMPLE_STEPS && step <= MFKEY32_LEVEL0_END &&
+               !mfkey32_window_match(ctx, next[i], step)) {
+                continue;
+            }
+            out[count++] = next[i];
+        }
+    }
+
+    return count;
+}
+
+static int mfkey32_record_compare(const void* a, const void* b) {
+    const Mfkey32Record* x = a;
+    const Mfkey32Record* y = b;
+    if(x->key != y->key) return x->key < y->key ? -1 : 1;
+    uint32_t x_top = x->state >> 24;
+    uint32_t y_top = y->state >> 24;
+    return (x_top > y_top) - (x_top < y_top);
+}
+
+static uint64_t mfkey32_get_lfsr(const Crypto1* state) {
+    uint64_t lfsr = 0;
+    for(int8_t i = 23; i >= 0; i--) {
+        lfsr = lfsr << 1 | FURI_BIT(state->odd, i ^ 3);
+        lfsr = lfsr << 1 | FURI_BIT(state->even, i ^ 3);
+    }
+    return lfsr;
+}
+
+// Roll candidate state back to the key and replay the second authentication
+static bool mfkey32_check(Mfkey32Context* ctx, Crypto1* state) {
+    const Mfkey32Nonces* nonces = ctx->nonces;
+
+    crypto1_lfsr_rollback_word(state, 0, 0);
+    crypto1_lfsr_rollback_word(state, nonces->nr0, 1);
+    crypto1_lfsr_rollback_word(state, nonces->cuid ^ nonces->nt0, 0);
+    uint64_t key = mfkey32_get_lfsr(state);
+
+    crypto1_word(state, nonces->cuid ^ nonces->nt1, 0);
+    crypto1_word(state, nonces->nr1, 1);
+    if((crypto1_word(state, 0, 0) ^ ctx->p64b) != nonces->ar1) return false;
+
+    ctx->key = key;
+    ctx->found = true;
+    return true;
+}
+
+// Combine even half candidate with all odd half records of the same key and top byte
+static void mfkey32_match(Mfkey32Context* ctx, uint16_t key, uint32_t even) {
+    Mfkey32Record needle = {.key = key, .state = even};
+
+    // Lower bound of the matching records
+    size_t lo = 0;
+    size_t hi = ctx->count;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(mfkey32_record_compare(&ctx->records[mid], &needle) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    uint32_t e = even << 1 ^ mfkey32_parity(even & MFKEY32_LF_POLY_EVEN) ^ ctx->final_in;
+    for(size_t i = lo; i < ctx->count; i++) {
+        const Mfkey32Record* record = &ctx->records[i];
+        if(mfkey32_record_compare(record, &needle) != 0) break;
+
+        Crypto1 state = {
+            .odd = (e ^ mfkey32_parity(record->state & MFKEY32_LF_POLY_ODD)) & 0xffffff,
+            .even = record->state & 0xffffff,
+        };
+        if(mfkey32_check(ctx, &state)) break;
+    }
+}
+
+// Walk all the candidates of the half grown from semi_state, which fall into the window
+static void
+    mfkey32_walk(Mfkey32Context* ctx, const Mfkey32Half* half, uint32_t semi_state) {
+    uint32_t simple[16];
+    uint32_t level0[16];
+    uint32_t level1[16];
+    uint32_t level2[8];
+
+    uint8_t simple_count =
+        mfkey32_extend_steps(ctx, half, semi_state, 1, MFKEY32_SIMPLE_STEPS, simple);
+    for(uint8_t i = 0; i < simple_count; i++) {
+        uint8_t level0_count = mfkey32_extend_steps(
+            ctx, half, simple[i], MFKEY32_SIMPLE_STEPS + 1, MFKEY32_LEVEL0_END, level0);
+        for(uint8_t j = 0; j < level0_count; j++) {
+            uint8_t level1_count = mfkey32_extend_steps(
+                ctx, half, level0[j], MFKEY32_LEVEL0_END + 1, MFKEY32_LEVEL1_END, level1);
+            for(uint8_t k = 0; k < level1_count; k++) {
+                uint16_t key = (level0[j] >> 24) << 8 | level1[k] >> 24;
+                uint8_t level2_count = mfkey32_extend_steps(
+                    ctx, half, level1[k], MFKEY32_LEVEL1_END + 1, MFKEY32_LEVEL2_END, level2);
+                for(uint8_t l = 0; l < level2_count; l++) {
+                    if(half == &ctx->even) {
+                        mfkey32_match(ctx, key, level2[l]);
+                        if(ctx->found) return;
+                    } else if(ctx->count == ctx->capacity) {
+                        ctx->overflow = true;
+                        return;
+                    } else {
+                        ctx->records[ctx->count].key = key;
+                        ctx->records[ctx->count].state = level2[l];
+                        ctx->count++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static bool mfkey32_scan(Mfkey32Context* ctx, const Mfkey32Half* half, float progress_offset) {
+    for(uint32_t semi_state = 0; semi_state < MFKEY32_SEMI_STATES_NUM; semi_state++) {
+        if(semi_state % MFKEY32_POLL_INTERVAL == 0 && ctx->callback) {
+            float progress = progress_offset + (float)semi_state / MFKEY32_SEMI_STATES_NUM / 2;
+            if(!ctx->callback(ctx->progress_base + ctx->progress_scale * progress, ctx->context)) {
+                ctx->cancelled = true;
+                return false;
+            }
+        }
+
+        if(mfkey32_filter(semi_state) != (half->ks & 1)) continue;
+        mfkey32_walk(ctx, half, semi_state);
+        if(ctx->overflow || ctx->found) return false;
+    }
+
+    return true;
+}
+
+// Recover candidates with the first contribution byte in the current window
+static void mfkey32_process_window(Mfkey32Context* ctx) {
+    ctx->count = 0;
+    ctx->overflow = false;
+
+    if(!mfkey32_scan(ctx, &ctx->odd, 0.0f)) return;
+    qsort(ctx->records, ctx->count, sizeof(Mfkey32Record), mfkey32_record_compare);
+    mfkey32_scan(ctx, &ctx->even, 0.5f);
+}
+
+Mfkey32Error mfkey32_recover(
+    const Mfkey32Nonces* nonces,
+    size_t ram_budget,
+    MfClassicKey* key,
+    Mfkey32ProgressCallback callback,
+    void* context) {
+    furi_check(nonces);
+    furi_check(key);
+
+    Mfkey32Context* ctx = malloc(sizeof(Mfkey32Context));
+    memset(ctx, 0, sizeof(Mfkey32Context));
+    ctx->nonces = nonces;
+    ctx->p64b = crypto1_prng_successor(nonces->nt1, 64);
+    ctx->callback = callback;
+    ctx->context = context;
+
+    // Keystream of the first reader answer, split into odd and even bits
+    uint32_t ks2 = nonces->ar0 ^ crypto1_prng_successor(nonces->nt0, 64);
+    for(int8_t i = 31; i >= 0; i -= 2) {
+        ctx->odd.ks = ctx->odd.ks << 1 | MFKEY32_BEBIT(ks2, i);
+    }
+    for(int8_t i = 30; i >= 0; i -= 2) {
+        ctx->even.ks = ctx->even.ks << 1 | MFKEY32_BEBIT(ks2, i);
+    }
+    ctx->odd.m1 = MFKEY32_LF_POLY_EVEN << 1 | 1;
+    ctx->odd.m2 = MFKEY32_LF_POLY_ODD << 1;
+    ctx->even.m1 = MFKEY32_LF_POLY_ODD;
+    ctx->even.m2 = MFKEY32_LF_POLY_EVEN << 1 | 1;
+    // Reader answer keystream is generated with no input
+    ctx->odd.in = 0;
+    ctx->even.in = 0;
+    ctx->final_in = 0;
+
+    // Budget larger than the free heap would crash in malloc, a smaller one only costs time
+    furi_kernel_lock();
+    size_t max_free_block = memmgr_heap_get_max_free_block();
+    size_t available =
+        (max_free_block > MFKEY32_HEAP_RESERVE) ? max_free_block - MFKEY32_HEAP_RESERVE : 0;
+    if(ram_budget > available) ram_budget = available;
+    ctx->capacity = ram_budget / sizeof(Mfkey32Record);
+    if(ctx->capacity >= MFKEY32_RECORDS_PER_WINDOW) {
+        ctx->records = malloc(ctx->capacity * sizeof(Mfkey32Record));
+    }
+    furi_kernel_unlock();
+
+    if(!ctx->records) {
+        FURI_LOG_E(TAG, "Budget of %zu bytes doesn't fit a single window", ram_budget);
+        free(ctx);
+        return Mfkey32ErrorMemory;
+    }
+    FURI_LOG_D(TAG, "Budget %zu bytes", ram_budget);
+
+    // Widest window which is expected to fit with a quarter to spare
+    uint8_t max_window_bits = 0;
+    while(max_window_bits < 8 &&
+          (MFKEY32_RECORDS_PER_WINDOW << (max_window_bits + 1)) * 5 / 4 <= ctx->capacity) {
+        max_window_bits++;
+    }
+    uint8_t window_bits = max_window_bits;
+
+    Mfkey32Error error = Mfkey32ErrorNotFound;
+    uint32_t window = 0;
+    while(window < MFKEY32_WINDOWS_NUM) {
+        ctx->prefix_bits = 8 - window_bits;
+        ctx->prefix = window >> window_bits;
+        ctx->progress_base = (float)window / MFKEY32_WINDOWS_NUM;
+        ctx->progress_scale = (float)(1U << window_bits) / MFKEY32_WINDOWS_NUM;
+
+        mfkey32_process_window(ctx);
+
+        if(ctx->found) {
+            bit_lib_num_to_bytes_be(ctx->key, sizeof(MfClassicKey), key->data);
+            error = Mfkey32ErrorNone;
+            break;
+        } else if(ctx->cancelled) {
+            error = Mfkey32ErrorCancelled;
+            break;
+        } else if(ctx->overflow) {
+            if(window_bits == 0) {
+                FURI_LOG_E(TAG, "Single window doesn't fit in %zu records", ctx->capacity);
+                error = Mfkey32ErrorMemory;
+                break;
+            }
+            // Retry with a narrower window
+            window_bits--;
+        } else {
+            window += 1U << window_bits;
+            // Widen the window back once it's aligned
+            if(window_bits < max_window_bits && (window & (1U << window_bits)) == 0) {
+                window_bits++;
+            }
+        }
+    }
+
+    if(error == Mfkey32ErrorNotFound && callback) callback(1.0f, context);
+
+    free(ctx->records);
+    free(ctx);
+
+    return error;
+}
+
+bool mfkey32_parse_log_line(
+    const char* line,
+    Mfkey32Nonces* nonces,
+    uint8_t* sector_num,
+    MfClassicKeyType* key_type) {
+    furi_check(line);
+    furi_check(nonces);
+
+    unsigned int sector = 0;
+    char key_char = 0;
+    int parsed = sscanf(
+        line,
+        "Sec %u key %c cuid %" SCNx32 " nt0 %" SCNx32 " nr0 %" SCNx32 " ar0 %" SCNx32
+        " nt1 %" SCNx32 " nr1 %" SCNx32 " ar1 %" SCNx32,
+        &sector,
+        &key_char,
+        &nonces->cuid,
+        &nonces->nt0,
+        &nonces->nr0,
+        &nonces->ar0,
+        &nonces->nt1,
+        &nonces->nr1,
+        &nonces->ar1);
+    if(parsed != 9 || (key_char != 'A' && key_char != 'B')) return false;
+
+    if(sector_num) *sector_num = sector;
+    if(key_type) *key_type = key_char == 'A' ? MfClassicKeyTypeA : MfClassicKeyTypeB;
+
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <protocols/mf_classic/mf_classic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default RAM budget for the candidate lists, bytes */
+#define MFKEY32_DEFAULT_RAM_BUDGET (48 * 1024)
+
+/** Two reader authentications to the same sector with the same key */
+typedef struct {
+    uint32_t cuid; /**< Card UID presented to the reader */
+    uint32_t nt0; /**< First tag nonce, plain */
+    uint32_t nr0; /**< First reader nonce, encrypted */
+    uint32_t ar0; /**< First reader answer, encrypted */
+    uint32_t nt1; /**< Second tag nonce, plain */
+    uint32_t nr1; /**< Second reader nonce, encrypted */
+    uint32_t ar1; /**< Second reader answer, encrypted */
+} Mfkey32Nonces;
+
+typedef enum {
+    Mfkey32ErrorNone, /**< Key recovered */
+    Mfkey32ErrorNotFound, /**< No key matches both authentications */
+    Mfkey32ErrorCancelled, /**< Recovery was cancelled by the callback */
+    Mfkey32ErrorMemory, /**< RAM budget or free heap is too small for the candidate lists */
+} Mfkey32Error;
+
+/**
+ * @brief Progress callback
+ *
+ * @param progress recovery progress, 0.0 to 1.0
+ * @param context callback context
+ * @return true to continue, false to cancel the recovery
+ */
+typedef bool (*Mfkey32ProgressCallback)(float progress, void* context);
+
+/**
+ * @brief Recover the key from two logged reader authentications
+ *
+ * LFSR state is recovered from the first reader answer keystream, every candidate
+ * is rolled back to the key and checked against the second authentication.
+ * Candidate lists are built in chunks that fit into ram_budget, recovery time
+ * grows as the budget shrinks. Budget is cut down to the largest free heap block,
+ * less a reserve for the rest of the system.
+ *
+ * @param nonces authentications to recover the key from
+ * @param ram_budget RAM available for the candidate lists, bytes
+ * @param key recovered key, valid if Mfkey32ErrorNone is returned
+ * @param callback progress callback, called periodically, can be NULL
+ * @param context callback context
+ * @return Mfkey32Error
+ */
+Mfkey32Error mfkey32_recover(
+    const Mfkey32Nonces* nonces,
+    size_t ram_budget,
+    MfClassicKey* key,
+    Mfkey32ProgressCallback callback,
+    void* context);
+
+/**
+ * @brief Parse one line of the mfkey32 log written by the NFC app
+ *
+ * @param line log line, "Sec 1 key A cuid 2a234f80 nt0 ... ar1 ..."
+ * @param nonces parsed authentications
+ * @param sector_num parsed sector number, can be NULL
+ * @param key_type parsed key type, can be NULL
+ * @return true if the line is well formed
+ */
+bool mfkey32_parse_log_line(
+    const char* line,
+    Mfkey32Nonces* nonces,
+    uint8_t* sector_num,
+    MfClassicKeyType* key_type);
+
+#ifdef __cplusplus
+}
+#endif
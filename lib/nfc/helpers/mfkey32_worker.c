@@ -0,0 +1,102 @@
+#include "mfkey32_worker.h"
+
+#include <furi.h>
+
+#define TAG "Mfkey32Worker"
+
+#define MFKEY32_WORKER_STACK_SIZE (2048)
+#define MFKEY32_WORKER_FLAG_STOP  (1UL << 0)
+
+struct Mfkey32Worker {
+    FuriThread* thread;
+    FuriEventFlag* flags;
+    size_t ram_budget;
+
+    Mfkey32Nonces nonces;
+    Mfkey32WorkerCallback callback;
+    void* context;
+};
+
+static bool mfkey32_worker_progress_callback(float progress, void* context) {
+    Mfkey32Worker* worker = context;
+
+    if(furi_event_flag_get(worker->flags) & MFKEY32_WORKER_FLAG_STOP) return false;
+
+    Mfkey32WorkerEvent event = {
+        .type = Mfkey32WorkerEventTypeProgress,
+        .progress = progress,
+    };
+    worker->callback(&event, worker->context);
+
+    return true;
+}
+
+static int32_t mfkey32_worker_thread(void* context) {
+    Mfkey32Worker* worker = context;
+
+    Mfkey32WorkerEvent event = {
+        .type = Mfkey32WorkerEventTypeFinished,
+        .progress = 1.0f,
+    };
+
+    uint32_t start = furi_get_tick();
+    event.error = mfkey32_recover(
+        &worker->nonces,
+        worker->ram_budget,
+        &event.key,
+        mfkey32_worker_progress_callback,
+        worker);
+    FURI_LOG_I(TAG, "Finished with %d in %lums", event.error, furi_get_tick() - start);
+
+    worker->callback(&event, worker->context);
+
+    return 0;
+}
+
+Mfkey32Worker* mfkey32_worker_alloc(size_t ram_budget) {
+    Mfkey32Worker* worker = malloc(sizeof(Mfkey32Worker));
+
+    worker->thread = furi_thread_alloc_ex(
+        "Mfkey32Worker", MFKEY32_WORKER_STACK_SIZE, mfkey32_worker_thread, worker);
+    // Recovery takes a while, keep the rest of the system responsive
+    furi_thread_set_priority(worker->thread, FuriThreadPriorityLow);
+    worker->flags = furi_event_flag_alloc();
+    worker->ram_budget = ram_budget;
+
+    return worker;
+}
+
+void mfkey32_worker_free(Mfkey32Worker* worker) {
+    furi_check(worker);
+    furi_check(furi_thread_get_state(worker->thread) == FuriThreadStateStopped);
+
+    furi_thread_free(worker->thread);
+    furi_event_flag_free(worker->flags);
+
+    free(worker);
+}
+
+void mfkey32_worker_start(
+    Mfkey32Worker* worker,
+    const Mfkey32Nonces* nonces,
+    Mfkey32WorkerCallback callback,
+    void* context) {
+    furi_check(worker);
+    furi_check(nonces);
+    furi_check(callback);
+    furi_check(furi_thread_get_state(worker->thread) == FuriThreadStateStopped);
+
+    worker->nonces = *nonces;
+    worker->callback = callback;
+    worker->context = context;
+    furi_event_flag_clear(worker->flags, MFKEY32_WORKER_FLAG_STOP);
+
+    furi_thread_start(worker->thread);
+}
+
+void mfkey32_worker_stop(Mfkey32Worker* worker) {
+    furi_check(worker);
+
+    furi_event_flag_set(worker->flags, MFKEY32_WORKER_FLAG_STOP);
+    furi_thread_join(worker->thread);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "mfkey32.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Mfkey32Worker Mfkey32Worker;
+
+typedef enum {
+    Mfkey32WorkerEventTypeProgress, /**< Recovery progress changed */
+    Mfkey32WorkerEventTypeFinished, /**< Recovery finished, worker can be stopped */
+} Mfkey32WorkerEventType;
+
+typedef struct {
+    Mfkey32WorkerEventType type;
+    float progress; /**< Recovery progress, 0.0 to 1.0 */
+    Mfkey32Error error; /**< Recovery result, valid on Mfkey32WorkerEventTypeFinished */
+    MfClassicKey key; /**< Recovered key, valid if error is Mfkey32ErrorNone */
+} Mfkey32WorkerEvent;
+
+/**
+ * @brief Worker event callback, called from the worker thread
+ *
+ * @param event worker event
+ * @param context callback context
+ */
+typedef void (*Mfkey32WorkerCallback)(const Mfkey32WorkerEvent* event, void* context);
+
+/**
+ * @brief Allocate a new Mfkey32Worker instance
+ *
+ * @param ram_budget RAM available for the candidate lists, bytes
+ * @return Mfkey32Worker*
+ */
+Mfkey32Worker* mfkey32_worker_alloc(size_t ram_budget);
+
+/**
+ * @brief Free a Mfkey32Worker instance
+ *
+ * @param worker Mfkey32Worker instance, must be stopped
+ */
+void mfkey32_worker_free(Mfkey32Worker* worker);
+
+/**
+ * @brief Start key recovery in the background
+ *
+ * @param worker Mfkey32Worker instance
+ * @param nonces authentications to recover the key from, copied
+ * @param callback event callback
+ * @param context callback context
+ */
+void mfkey32_worker_start(
+    Mfkey32Worker* worker,
+    const Mfkey32Nonces* nonces,
+    Mfkey32WorkerCallback callback,
+    void* context);
+
+/**
+ * @brief Stop the worker, cancelling the recovery if it's still running
+ *
+ * Finished event with Mfkey32ErrorCancelled is sent if the recovery is cancelled.
+ *
+ * @param worker Mfkey32Worker instance
+ */
+void mfkey32_worker_stop(Mfkey32Worker* worker);
+
+#ifdef __cplusplus
+}
+#endif
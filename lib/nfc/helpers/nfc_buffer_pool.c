@@ -0,0 +1,71 @@
+#include "nfc_buffer_pool.h"
+
+#include <furi/furi.h>
+
+#define NFC_BUFFER_POOL_COUNT_MAX (32U)
+
+struct NfcBufferPool {
+    size_t count;
+    uint32_t full_mask;
+    uint32_t free_mask;
+    BitBuffer* buffers[];
+};
+
+NfcBufferPool* nfc_buffer_pool_alloc(size_t count, size_t capacity_bytes) {
+    furi_check(count > 0);
+    furi_check(count <= NFC_BUFFER_POOL_COUNT_MAX);
+
+    NfcBufferPool* instance = malloc(sizeof(NfcBufferPool) + count * sizeof(BitBuffer*));
+    instance->count = count;
+    instance->full_mask = UINT32_MAX >> (NFC_BUFFER_POOL_COUNT_MAX - count);
+    instance->free_mask = instance->full_mask;
+    for(size_t i = 0; i < count; i++) {
+        instance->buffers[i] = bit_buffer_alloc(capacity_bytes);
+    }
+
+    return instance;
+}
+
+void nfc_buffer_pool_free(NfcBufferPool* instance) {
+    furi_check(instance);
+    furi_check(instance->free_mask == instance->full_mask, "NFC buffer not returned");
+
+    for(size_t i = 0; i < instance->count; i++) {
+        bit_buffer_free(instance->buffers[i]);
+    }
+    free(instance);
+}
+
+BitBuffer* nfc_buffer_pool_borrow(NfcBufferPool* instance) {
+    furi_check(instance);
+
+    FURI_CRITICAL_ENTER();
+    uint32_t free_mask = instance->free_mask;
+    // Lowest free buffer, mask is cleared by its own lowest set bit
+    instance->free_mask &= free_mask - 1;
+    FURI_CRITICAL_EXIT();
+
+    // Pool is sized for the deepest nesting of temporaries, running out of it is a bug
+    furi_check(free_mask, "NFC buffer pool exhausted");
+
+    BitBuffer* buffer = instance->buffers[__builtin_ctz(free_mask)];
+    bit_buffer_reset(buffer);
+
+    return buffer;
+}
+
+void nfc_buffer_pool_return(NfcBufferPool* instance, BitBuffer* buffer) {
+    furi_check(instance);
+    furi_check(buffer);
+
+    size_t index = 0;
+    while(index < instance->count && instance->buffers[index] != buffer) {
+        index++;
+    }
+    furi_check(index < instance->count, "Buffer doesn't belong to the pool");
+    furi_check(!(instance->free_mask & (1UL << index)), "Buffer returned twice");
+
+    FURI_CRITICAL_ENTER();
+    instance->free_mask |= 1UL << index;
+    FURI_CRITICAL_EXIT();
+}
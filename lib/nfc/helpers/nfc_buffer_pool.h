@@ -0,0 +1,26 @@
+#pragma once
+
+#include <toolbox/bit_buffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fixed set of BitBuffers allocated once and lent out without touching the heap.
+ *
+ * Backs nfc_buffer_borrow() and nfc_buffer_return() of both the Nfc transport and its mock.
+ */
+typedef struct NfcBufferPool NfcBufferPool;
+
+NfcBufferPool* nfc_buffer_pool_alloc(size_t count, size_t capacity_bytes);
+
+void nfc_buffer_pool_free(NfcBufferPool* instance);
+
+BitBuffer* nfc_buffer_pool_borrow(NfcBufferPool* instance);
+
+void nfc_buffer_pool_return(NfcBufferPool* instance, BitBuffer* buffer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #ifndef FW_CFG_unit_tests
 
 #include "nfc.h"
+#include "helpers/nfc_buffer_pool.h"
 
 #include <furi_hal_nfc.h>
 #include <furi/furi.h>
@@ -58,6 +59,8 @@ struct Nfc {
     uint8_t rx_buffer[NFC_MAX_BUFFER_SIZE];
     size_t rx_bits;
 
+    NfcBufferPool* buffer_pool;
+
     FuriThread* worker_thread;
 };
 
@@ -242,6 +245,8 @@ Nfc* nfc_alloc(void) {
     instance->state = NfcStateIdle;
     instance->comm_state = NfcCommStateIdle;
     instance->config_state = NfcConfigurationStateIdle;
+    instance->buffer_pool =
+        nfc_buffer_pool_alloc(NFC_BUFFER_POOL_SIZE, NFC_BUFFER_POOL_BUFFER_SIZE);
 
     instance->worker_thread = furi_thread_alloc();
     furi_thread_set_name(instance->worker_thread, "NfcWorker");
@@ -257,11 +262,24 @@ void nfc_free(Nfc* instance) {
     furi_check(instance->state == NfcStateIdle);
 
     furi_thread_free(instance->worker_thread);
+    nfc_buffer_pool_free(instance->buffer_pool);
     free(instance);
 
     furi_hal_nfc_release();
 }
 
+BitBuffer* nfc_buffer_borrow(Nfc* instance) {
+    furi_check(instance);
+
+    return nfc_buffer_pool_borrow(instance->buffer_pool);
+}
+
+void nfc_buffer_return(Nfc* instance, BitBuffer* buffer) {
+    furi_check(instance);
+
+    nfc_buffer_pool_return(instance->buffer_pool, buffer);
+}
+
 void nfc_config(Nfc* instance, NfcMode mode, NfcTech tech) {
     furi_check(instance);
     furi_check(mode < NfcModeNum);
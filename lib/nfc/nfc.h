@@ -254,6 +254,39 @@ NfcError
  */
 NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer);
 
+/**
+ * @brief Capacity of the buffers lent out by nfc_buffer_borrow(), in bytes.
+ */
+#define NFC_BUFFER_POOL_BUFFER_SIZE (64U)
+
+/**
+ * @brief Number of buffers each Nfc instance can lend out at the same time.
+ */
+#define NFC_BUFFER_POOL_SIZE (4U)
+
+/**
+ * @brief Borrow a temporary buffer from the Nfc instance.
+ *
+ * The buffers are allocated together with the Nfc instance, so that short-lived
+ * frames can be built during exchanges without touching the heap. The buffer is
+ * empty and can hold up to NFC_BUFFER_POOL_BUFFER_SIZE bytes.
+ *
+ * Borrowing more than NFC_BUFFER_POOL_SIZE buffers at once will crash, so every
+ * borrowed buffer must be given back with nfc_buffer_return() on all paths.
+ *
+ * @param[in,out] instance pointer to the instance to borrow the buffer from.
+ * @returns pointer to the borrowed buffer.
+ */
+BitBuffer* nfc_buffer_borrow(Nfc* instance);
+
+/**
+ * @brief Return a buffer obtained with nfc_buffer_borrow().
+ *
+ * @param[in,out] instance pointer to the instance the buffer was borrowed from.
+ * @param[in] buffer pointer to the buffer to be returned.
+ */
+void nfc_buffer_return(Nfc* instance, BitBuffer* buffer);
+
 /*
  * Technology-specific functions.
  *
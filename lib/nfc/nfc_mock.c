@@ -1,6 +1,8 @@
 #ifdef FW_CFG_unit_tests
 
 #include <lib/nfc/nfc.h>
+#include <lib/nfc/nfc_mock.h>
+#include <lib/nfc/helpers/nfc_buffer_pool.h>
 #include <lib/nfc/helpers/iso14443_crc.h>
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <lib/nfc/protocols/felica/felica.h>
@@ -9,7 +11,10 @@
 
 #include <furi/furi.h>
 
-#define NFC_MAX_BUFFER_SIZE (256)
+#define NFC_MAX_BUFFER_SIZE       (256)
+#define NFC_TEST_PRINT_LINE_BYTES (16)
+
+#define NFC_MOCK_CARRIER_FREQUENCY_HZ (13560000UL)
 
 typedef enum {
     NfcTransportLogLevelWarning,
@@ -33,8 +38,23 @@ typedef struct {
 typedef struct {
     NfcMessageType type;
     NfcMessageData data;
+    uint32_t fdt_listen_fc;
 } NfcMessage;
 
+typedef struct {
+    uint32_t bit_fc; /**< Carrier cycles per bit */
+    uint32_t byte_overhead_bits; /**< Parity, start and stop bits per byte */
+    uint32_t frame_overhead_bits; /**< SOF, EOF, preamble and sync per frame */
+    uint32_t fdt_listen_fc; /**< Nominal listener response delay */
+} NfcMockTechTiming;
+
+typedef struct {
+    uint64_t time_fc;
+    uint32_t exchanges;
+    uint32_t timeouts;
+    uint32_t allocations;
+} NfcMockClock;
+
 typedef enum {
     NfcStateIdle,
     NfcStateReady,
@@ -74,6 +94,12 @@ typedef struct {
 
 struct Nfc {
     NfcState state;
+    NfcTech tech;
+
+    uint32_t fdt_listen_fc;
+    uint32_t fdt_poll_fc;
+    uint32_t fdt_poll_poll_us;
+    uint32_t guard_time_us;
 
     Iso14443_3aColResStatus col_res_status;
     Iso14443_3aColResData col_res_data;
@@ -85,27 +111,90 @@ struct Nfc {
 
     NfcMode mode;
 
+    NfcBufferPool* buffer_pool;
+
     FuriThread* worker_thread;
 };
 
+static const NfcMockTechTiming nfc_mock_tech_timing[NfcTechNum] = {
+    [NfcTechIso14443a] =
+        {
+            .bit_fc = 128,
+            .byte_overhead_bits = 1,
+            .frame_overhead_bits = 2,
+            .fdt_listen_fc = 1172,
+        },
+    [NfcTechIso14443b] =
+        {
+            .bit_fc = 128,
+            .byte_overhead_bits = 2,
+            .frame_overhead_bits = 24,
+            .fdt_listen_fc = 1024,
+        },
+    [NfcTechIso15693] =
+        {
+            .bit_fc = 512,
+            .byte_overhead_bits = 0,
+            .frame_overhead_bits = 8,
+            .fdt_listen_fc = 4320,
+        },
+    [NfcTechFelica] =
+        {
+            .bit_fc = 64,
+            .byte_overhead_bits = 0,
+            .frame_overhead_bits = 64,
+            .fdt_listen_fc = 2400,
+        },
+};
+
+// Simulated time, advanced by the poller side only
+static NfcMockClock nfc_mock_clock = {};
+
+static uint32_t nfc_mock_us_to_fc(uint32_t us) {
+    return (uint64_t)us * NFC_MOCK_CARRIER_FREQUENCY_HZ / 1000000UL;
+}
+
+static uint32_t nfc_mock_frame_fc(NfcTech tech, size_t bits) {
+    const NfcMockTechTiming* timing = &nfc_mock_tech_timing[tech];
+    size_t frame_bits =
+        bits + (bits / 8) * timing->byte_overhead_bits + timing->frame_overhead_bits;
+
+    return frame_bits * timing->bit_fc;
+}
+
+void nfc_mock_stats_reset(void) {
+    memset(&nfc_mock_clock, 0, sizeof(nfc_mock_clock));
+}
+
+void nfc_mock_stats_get(NfcMockStats* stats) {
+    furi_check(stats);
+
+    stats->time_us = nfc_mock_clock.time_fc * 1000000UL / NFC_MOCK_CARRIER_FREQUENCY_HZ;
+    stats->exchanges = nfc_mock_clock.exchanges;
+    stats->timeouts = nfc_mock_clock.timeouts;
+    stats->allocations = nfc_mock_clock.allocations;
+}
+
 static void nfc_test_print(
     NfcTransportLogLevel log_level,
     const char* message,
     uint8_t* buffer,
     uint16_t bits) {
-    FuriString* str = furi_string_alloc();
+    // Frames are dumped in short lines from the stack, so that tracing doesn't allocate
+    char line[NFC_TEST_PRINT_LINE_BYTES * 3 + 1];
     size_t bytes = (bits + 7) / 8;
 
-    for(size_t i = 0; i < bytes; i++) {
-        furi_string_cat_printf(str, " %02X", buffer[i]);
-    }
-    if(log_level == NfcTransportLogLevelWarning) {
-        FURI_LOG_W(message, "%s", furi_string_get_cstr(str));
-    } else {
-        FURI_LOG_I(message, "%s", furi_string_get_cstr(str));
+    for(size_t start = 0; start < bytes; start += NFC_TEST_PRINT_LINE_BYTES) {
+        size_t end = MIN(start + NFC_TEST_PRINT_LINE_BYTES, bytes);
+        for(size_t i = start; i < end; i++) {
+            snprintf(&line[(i - start) * 3], 4, " %02X", buffer[i]);
+        }
+        if(log_level == NfcTransportLogLevelWarning) {
+            FURI_LOG_W(message, "%s", line);
+        } else {
+            FURI_LOG_I(message, "%s", line);
+        }
     }
-
-    furi_string_free(str);
 }
 
 static void nfc_prepare_col_res_data(
@@ -141,6 +230,8 @@ static void nfc_prepare_col_res_data(
 
 Nfc* nfc_alloc(void) {
     Nfc* instance = malloc(sizeof(Nfc));
+    instance->buffer_pool =
+        nfc_buffer_pool_alloc(NFC_BUFFER_POOL_SIZE, NFC_BUFFER_POOL_BUFFER_SIZE);
 
     return instance;
 }
@@ -148,24 +239,40 @@ Nfc* nfc_alloc(void) {
 void nfc_free(Nfc* instance) {
     furi_check(instance);
 
+    nfc_buffer_pool_free(instance->buffer_pool);
     free(instance);
 }
 
+BitBuffer* nfc_buffer_borrow(Nfc* instance) {
+    furi_check(instance);
+
+    return nfc_buffer_pool_borrow(instance->buffer_pool);
+}
+
+void nfc_buffer_return(Nfc* instance, BitBuffer* buffer) {
+    furi_check(instance);
+
+    nfc_buffer_pool_return(instance->buffer_pool, buffer);
+}
+
 void nfc_config(Nfc* instance, NfcMode mode, NfcTech tech) {
-    UNUSED(instance);
-    UNUSED(tech);
+    furi_check(instance);
+    furi_check(tech < NfcTechNum);
 
     instance->mode = mode;
+    instance->tech = tech;
 }
 
 void nfc_set_fdt_poll_fc(Nfc* instance, uint32_t fdt_poll_fc) {
-    UNUSED(instance);
-    UNUSED(fdt_poll_fc);
+    furi_check(instance);
+
+    instance->fdt_poll_fc = fdt_poll_fc;
 }
 
 void nfc_set_fdt_listen_fc(Nfc* instance, uint32_t fdt_listen_fc) {
-    UNUSED(instance);
-    UNUSED(fdt_listen_fc);
+    furi_check(instance);
+
+    instance->fdt_listen_fc = fdt_listen_fc;
 }
 
 void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
@@ -174,13 +281,15 @@ void nfc_set_mask_receive_time_fc(Nfc* instance, uint32_t mask_rx_time_fc) {
 }
 
 void nfc_set_fdt_poll_poll_us(Nfc* instance, uint32_t fdt_poll_poll_us) {
-    UNUSED(instance);
-    UNUSED(fdt_poll_poll_us);
+    furi_check(instance);
+
+    instance->fdt_poll_poll_us = fdt_poll_poll_us;
 }
 
 void nfc_set_guard_time_us(Nfc* instance, uint32_t guard_time_us) {
-    UNUSED(instance);
-    UNUSED(guard_time_us);
+    furi_check(instance);
+
+    instance->guard_time_us = guard_time_us;
 }
 
 NfcError nfc_iso14443a_listener_set_col_res_data(
@@ -203,6 +312,12 @@ static int32_t nfc_worker_poller(void* context) {
     Nfc* instance = context;
     furi_check(instance->callback);
 
+    // Pollers are allocated by the caller, everything allocated here is done per exchange
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    bool heap_trace = memmgr_heap_get_thread_alloc_count(thread_id) == MEMMGR_HEAP_UNKNOWN;
+    if(heap_trace) memmgr_heap_enable_thread_trace(thread_id);
+    size_t allocations_start = memmgr_heap_get_thread_alloc_count(thread_id);
+
     instance->state = NfcStateReady;
     NfcCommand command = NfcCommandContinue;
     NfcEvent event = {};
@@ -217,12 +332,16 @@ static int32_t nfc_worker_poller(void* context) {
 
     instance->state = NfcStateIdle;
 
+    nfc_mock_clock.allocations +=
+        memmgr_heap_get_thread_alloc_count(thread_id) - allocations_start;
+    if(heap_trace) memmgr_heap_disable_thread_trace(thread_id);
+
     return 0;
 }
 
 static void nfc_worker_listener_pass_col_res(Nfc* instance, uint8_t* rx_data, uint16_t rx_bits) {
     furi_check(instance->col_res_status != Iso14443_3aColResStatusDone);
-    BitBuffer* tx_buffer = bit_buffer_alloc(NFC_MAX_BUFFER_SIZE);
+    BitBuffer* tx_buffer = nfc_buffer_borrow(instance);
 
     bool processed = false;
 
@@ -291,7 +410,7 @@ static void nfc_worker_listener_pass_col_res(Nfc* instance, uint8_t* rx_data, ui
         furi_message_queue_put(poller_queue, &message, FuriWaitForever);
     }
 
-    bit_buffer_free(tx_buffer);
+    nfc_buffer_return(instance, tx_buffer);
 }
 
 static int32_t nfc_worker_listener(void* context) {
@@ -357,6 +476,8 @@ void nfc_start(Nfc* instance, NfcEventCallback callback, void* context) {
         listener_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
     } else {
         poller_queue = furi_message_queue_alloc(4, sizeof(NfcMessage));
+        // Field is switched on, wait for the card to power up
+        nfc_mock_clock.time_fc += nfc_mock_us_to_fc(instance->guard_time_us);
     }
 
     instance->worker_thread = furi_thread_alloc();
@@ -411,6 +532,7 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     NfcMessage message = {};
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
+    message.fdt_listen_fc = instance->fdt_listen_fc;
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
 
     furi_message_queue_put(poller_queue, &message, FuriWaitForever);
@@ -429,7 +551,6 @@ NfcError
     furi_check(rx_buffer);
     furi_check(poller_queue);
     furi_check(listener_queue);
-    UNUSED(fwt);
 
     NfcError error = NfcErrorNone;
 
@@ -439,6 +560,7 @@ NfcError
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
     // Tx
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
+    nfc_mock_clock.time_fc += nfc_mock_frame_fc(instance->tech, message.data.data_bits);
     // Rx
     FuriStatus status = furi_message_queue_get(poller_queue, &message, 50);
 
@@ -452,6 +574,21 @@ NfcError
         error = NfcErrorTimeout;
     }
 
+    if(error == NfcErrorNone) {
+        uint32_t fdt_listen_fc = message.fdt_listen_fc ?
+                                     message.fdt_listen_fc :
+                                     nfc_mock_tech_timing[instance->tech].fdt_listen_fc;
+        nfc_mock_clock.time_fc += fdt_listen_fc;
+        nfc_mock_clock.time_fc += nfc_mock_frame_fc(instance->tech, message.data.data_bits);
+    } else {
+        nfc_mock_clock.time_fc += fwt;
+        nfc_mock_clock.timeouts++;
+    }
+    nfc_mock_clock.exchanges++;
+    // Next frame can't be sent earlier than both poller delays expire
+    nfc_mock_clock.time_fc +=
+        MAX(instance->fdt_poll_fc, nfc_mock_us_to_fc(instance->fdt_poll_poll_us));
+
     return error;
 }
 
@@ -472,13 +609,12 @@ NfcError nfc_iso14443a_poller_trx_short_frame(
     uint32_t fwt) {
     UNUSED(frame);
 
-    BitBuffer* tx_buffer = bit_buffer_alloc(32);
+    BitBuffer* tx_buffer = nfc_buffer_borrow(instance);
     bit_buffer_set_size(tx_buffer, 7);
     bit_buffer_set_byte(tx_buffer, 0, 0x52);
 
     NfcError error = nfc_poller_trx(instance, tx_buffer, rx_buffer, fwt);
-
-    bit_buffer_free(tx_buffer);
+    nfc_buffer_return(instance, tx_buffer);
 
     return error;
 }
@@ -0,0 +1,46 @@
+/**
+ * @file nfc_mock.h
+ * @brief Simulated clock of the NFC transport mock.
+ *
+ * Available in the unit_tests firmware configuration only, where nfc_mock.c replaces nfc.c.
+ * Poller and listener exchange frames over message queues, and the mock accounts for the time
+ * the same exchanges would take over the air: frame airtime at the technology bit rate,
+ * listener frame delay, poller frame delays, field-on guard time and frame waiting time
+ * of unanswered frames. Heap allocations of the poller worker thread are counted as well,
+ * reading ISO14443-3A, MIFARE Ultralight/NTAG and MIFARE Classic cards must not make any.
+ * DESFire and ISO15693 pollers allocate card data arrays sized from the card answers
+ * while reading, so they are not held to that.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Simulated transport statistics.
+ */
+typedef struct {
+    uint32_t time_us; /**< Simulated time since the last reset. */
+    uint32_t exchanges; /**< Number of poller frame exchanges. */
+    uint32_t timeouts; /**< Number of exchanges left unanswered by the listener. */
+    uint32_t allocations; /**< Number of heap allocations made by the poller worker thread. */
+} NfcMockStats;
+
+/**
+ * @brief Reset the simulated clock, exchange and allocation counters.
+ */
+void nfc_mock_stats_reset(void);
+
+/**
+ * @brief Get the simulated transport statistics.
+ *
+ * @param[out] stats pointer to the statistics to be filled.
+ */
+void nfc_mock_stats_get(NfcMockStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,11 +2,17 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+#define NFC_SCANNER_SCORE_HIT (128U)
+
+#define NFC_SCANNER_SAK_MF_ULTRALIGHT (0x00)
+#define NFC_SCANNER_SAK_ISO14443_4    (0x20)
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -23,8 +29,17 @@ typedef enum {
     NfcScannerSessionStateStopRequest,
 } NfcScannerSessionState;
 
+typedef enum {
+    NfcScannerFingerprintUnknown,
+    NfcScannerFingerprintMatch,
+    NfcScannerFingerprintMismatch,
+} NfcScannerFingerprint;
+
+typedef NfcScannerFingerprint (*NfcScannerFingerprintCheck)(const Iso14443_3aData* data);
+
 struct NfcScanner {
     Nfc* nfc;
+    NfcScannerMode mode;
     NfcScannerState state;
     NfcScannerSessionState session_state;
 
@@ -51,9 +66,39 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    bool iso14443_3a_data_valid;
+    Iso14443_3aData* iso14443_3a_data;
+
+    // Decaying hit scores of base protocols, kept across scans of this instance
+    uint8_t base_protocol_score[NfcProtocolNum];
+
     FuriThread* scan_worker;
 };
 
+static NfcScannerFingerprint nfc_scanner_fingerprint_iso14443_4a(const Iso14443_3aData* data) {
+    return iso14443_3a_supports_iso14443_4(data) ? NfcScannerFingerprintMatch :
+                                                   NfcScannerFingerprintMismatch;
+}
+
+static NfcScannerFingerprint nfc_scanner_fingerprint_mf_ultralight(const Iso14443_3aData* data) {
+    return (data->sak == NFC_SCANNER_SAK_MF_ULTRALIGHT) ? NfcScannerFingerprintUnknown :
+                                                          NfcScannerFingerprintMismatch;
+}
+
+static NfcScannerFingerprint nfc_scanner_fingerprint_mf_classic(const Iso14443_3aData* data) {
+    // Ultralight/NTAG and pure ISO14443-4 cards never answer MIFARE Classic AUTH
+    return ((data->sak == NFC_SCANNER_SAK_MF_ULTRALIGHT) ||
+            (data->sak == NFC_SCANNER_SAK_ISO14443_4)) ?
+               NfcScannerFingerprintMismatch :
+               NfcScannerFingerprintUnknown;
+}
+
+static const NfcScannerFingerprintCheck nfc_scanner_fingerprint_checks[NfcProtocolNum] = {
+    [NfcProtocolIso14443_4a] = nfc_scanner_fingerprint_iso14443_4a,
+    [NfcProtocolMfUltralight] = nfc_scanner_fingerprint_mf_ultralight,
+    [NfcProtocolMfClassic] = nfc_scanner_fingerprint_mf_classic,
+};
+
 static void nfc_scanner_reset(NfcScanner* instance) {
     instance->base_protocols_idx = 0;
     instance->base_protocols_num = 0;
@@ -65,6 +110,45 @@ static void nfc_scanner_reset(NfcScanner* instance) {
     instance->detected_base_protocols_num = 0;
 
     instance->current_protocol = 0;
+
+    instance->iso14443_3a_data_valid = false;
+}
+
+static bool nfc_scanner_is_protocol_detected(NfcScanner* instance, NfcProtocol protocol) {
+    bool detected = false;
+
+    for(size_t i = 0; i < instance->detected_protocols_num; i++) {
+        if(instance->detected_protocols[i] == protocol) {
+            detected = true;
+            break;
+        }
+    }
+
+    return detected;
+}
+
+static void nfc_scanner_sort_base_protocols(NfcScanner* instance) {
+    // Insertion sort keeps the enum order for protocols with equal scores
+    for(size_t i = 1; i < instance->base_protocols_num; i++) {
+        NfcProtocol protocol = instance->base_protocols[i];
+        size_t j = i;
+        while((j > 0) && (instance->base_protocol_score[instance->base_protocols[j - 1]] <
+                          instance->base_protocol_score[protocol])) {
+            instance->base_protocols[j] = instance->base_protocols[j - 1];
+            j--;
+        }
+        instance->base_protocols[j] = protocol;
+    }
+}
+
+static void nfc_scanner_update_base_protocol_scores(NfcScanner* instance) {
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        instance->base_protocol_score[i] /= 2;
+    }
+    for(size_t i = 0; i < instance->detected_base_protocols_num; i++) {
+        instance->base_protocol_score[instance->detected_base_protocols[i]] +=
+            NFC_SCANNER_SCORE_HIT;
+    }
 }
 
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
@@ -79,6 +163,10 @@ void nfc_scanner_state_handler_idle(NfcScanner* instance) {
     }
     FURI_LOG_D(TAG, "Found %zu base protocols", instance->base_protocols_num);
 
+    if(instance->mode == NfcScannerModeAdaptive) {
+        nfc_scanner_sort_base_protocols(instance);
+    }
+
     instance->first_detected_protocol = NfcProtocolInvalid;
     instance->state = NfcScannerStateTryBasePollers;
 }
@@ -94,6 +182,11 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        if(protocol_detected && (instance->current_protocol == NfcProtocolIso14443_3a)) {
+            // Keep ATQA/SAK to decide on children protocols without probing them
+            iso14443_3a_copy(instance->iso14443_3a_data, nfc_poller_get_data(poller));
+            instance->iso14443_3a_data_valid = true;
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -117,6 +210,8 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 }
 
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
+    nfc_scanner_update_base_protocol_scores(instance);
+
     for(size_t i = 0; i < NfcProtocolNum; i++) {
         for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
             if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
@@ -134,14 +229,45 @@ void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     FURI_LOG_D(TAG, "Found %zu children", instance->children_protocols_num);
 }
 
+static NfcScannerFingerprint nfc_scanner_check_fingerprint(NfcScanner* instance) {
+    NfcScannerFingerprint fingerprint = NfcScannerFingerprintUnknown;
+
+    do {
+        NfcProtocol parent_protocol = nfc_protocol_get_parent(instance->current_protocol);
+        // Children are listed in protocol order, so intermediate parents are checked first
+        if((nfc_protocol_get_parent(parent_protocol) != NfcProtocolInvalid) &&
+           !nfc_scanner_is_protocol_detected(instance, parent_protocol)) {
+            fingerprint = NfcScannerFingerprintMismatch;
+            break;
+        }
+
+        NfcScannerFingerprintCheck check =
+            nfc_scanner_fingerprint_checks[instance->current_protocol];
+        if(check && instance->iso14443_3a_data_valid &&
+           nfc_protocol_has_parent(instance->current_protocol, NfcProtocolIso14443_3a)) {
+            fingerprint = check(instance->iso14443_3a_data);
+        }
+    } while(false);
+
+    return fingerprint;
+}
+
 void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
     furi_assert(instance->children_protocols_num);
 
     instance->current_protocol = instance->children_protocols[instance->children_protocols_idx];
 
-    NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
-    bool protocol_detected = nfc_poller_detect(poller);
-    nfc_poller_free(poller);
+    NfcScannerFingerprint fingerprint = NfcScannerFingerprintUnknown;
+    if(instance->mode == NfcScannerModeAdaptive) {
+        fingerprint = nfc_scanner_check_fingerprint(instance);
+    }
+
+    bool protocol_detected = (fingerprint == NfcScannerFingerprintMatch);
+    if(fingerprint == NfcScannerFingerprintUnknown) {
+        NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
+        protocol_detected = nfc_poller_detect(poller);
+        nfc_poller_free(poller);
+    }
 
     if(protocol_detected) {
         instance->detected_protocols[instance->detected_protocols_num] =
@@ -222,6 +348,7 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc) {
 
     NfcScanner* instance = malloc(sizeof(NfcScanner));
     instance->nfc = nfc;
+    instance->iso14443_3a_data = iso14443_3a_alloc();
 
     return instance;
 }
@@ -230,9 +357,18 @@ void nfc_scanner_free(NfcScanner* instance) {
     furi_check(instance);
     furi_check(instance->state == NfcScannerStateIdle);
 
+    iso14443_3a_free(instance->iso14443_3a_data);
     free(instance);
 }
 
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode) {
+    furi_check(instance);
+    furi_check(mode < NfcScannerModeNum);
+    furi_check(instance->state == NfcScannerStateIdle);
+
+    instance->mode = mode;
+}
+
 void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context) {
     furi_check(instance);
     furi_check(callback);
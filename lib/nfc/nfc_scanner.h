@@ -11,6 +11,11 @@
  *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
+ *
+ * In adaptive mode, base protocols are tried starting with the most recently detected ones,
+ * and children protocols which can be ruled in or out by the ISO14443-3A ATQA/SAK
+ * captured during base protocol detection are not probed separately. Detection history
+ * belongs to the instance, so it should be kept and restarted for repeated scans.
  */
 #pragma once
 
@@ -26,6 +31,16 @@ extern "C" {
  */
 typedef struct NfcScanner NfcScanner;
 
+/**
+ * @brief Scanning mode.
+ */
+typedef enum {
+    NfcScannerModeDefault, /**< Probe every protocol in the protocol enumeration order. */
+    NfcScannerModeAdaptive, /**< Order probes by recent detections, skip needless probes. */
+
+    NfcScannerModeNum, /**< Special value representing the number of available modes. */
+} NfcScannerMode;
+
 /**
  * @brief Event type passed to the user callback.
  */
@@ -76,6 +91,16 @@ NfcScanner* nfc_scanner_alloc(Nfc* nfc);
  */
 void nfc_scanner_free(NfcScanner* instance);
 
+/**
+ * @brief Set an NfcScanner scanning mode.
+ *
+ * Must be called before nfc_scanner_start(). The default mode is NfcScannerModeDefault.
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] mode scanning mode to be used.
+ */
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode);
+
 /**
  * @brief Start an NfcScanner.
  *
@@ -8,6 +8,10 @@
 #define FELICA_LISTENER_RESPONSE_CODE_READ  (0x07)
 #define FELICA_LISTENER_RESPONSE_CODE_WRITE (0x09)
 
+#define FELICA_LISTENER_READ_RESPONSE_SIZE_MAX   \
+    (sizeof(FelicaListenerReadCommandResponse) + \
+     FELICA_LISTENER_READ_BLOCK_COUNT_MAX * FELICA_DATA_BLOCK_SIZE)
+
 #define TAG "FelicaListener"
 
 FelicaListener* felica_listener_alloc(Nfc* nfc, FelicaData* data) {
@@ -64,9 +68,8 @@ static FelicaError felica_listener_command_handler_read(
     const FelicaListenerReadRequest* request = (FelicaListenerReadRequest*)generic_request;
     FURI_LOG_D(TAG, "Read cmd");
 
-    FelicaListenerReadCommandResponse* resp = malloc(
-        sizeof(FelicaCommandResponseHeader) + 1 +
-        FELICA_LISTENER_READ_BLOCK_COUNT_MAX * FELICA_DATA_BLOCK_SIZE);
+    uint8_t resp_data[FELICA_LISTENER_READ_RESPONSE_SIZE_MAX] = {};
+    FelicaListenerReadCommandResponse* resp = (FelicaListenerReadCommandResponse*)resp_data;
 
     resp->header.response_code = FELICA_LISTENER_RESPONSE_CODE_READ;
     resp->header.idm = request->base.header.idm;
@@ -95,7 +98,6 @@ static FelicaError felica_listener_command_handler_read(
 
     bit_buffer_reset(instance->tx_buffer);
     bit_buffer_append_bytes(instance->tx_buffer, (uint8_t*)resp, resp->header.length);
-    free(resp);
 
     return felica_listener_frame_exchange(instance, instance->tx_buffer);
 }
@@ -109,7 +111,8 @@ static FelicaError felica_listener_command_handler_write(
     const FelicaListenerWriteBlockData* data_ptr =
         felica_listener_get_write_request_data_pointer(instance, generic_request);
 
-    FelicaListenerWriteCommandResponse* resp = malloc(sizeof(FelicaListenerWriteCommandResponse));
+    FelicaListenerWriteCommandResponse write_resp = {};
+    FelicaListenerWriteCommandResponse* resp = &write_resp;
 
     resp->response_code = FELICA_LISTENER_RESPONSE_CODE_WRITE;
     resp->idm = request->base.header.idm;
@@ -131,7 +134,6 @@ static FelicaError felica_listener_command_handler_write(
 
     bit_buffer_reset(instance->tx_buffer);
     bit_buffer_append_bytes(instance->tx_buffer, (uint8_t*)resp, resp->length);
-    free(resp);
 
     return felica_listener_frame_exchange(instance, instance->tx_buffer);
 }
@@ -2216,9 +2216,9 @@ bool mf_classic_poller_detect(NfcGenericEvent event, void* context) {
     Iso14443_3aPollerEvent* iso14443_3a_event = event.event_data;
     bool detected = false;
     const uint8_t auth_cmd[] = {MF_CLASSIC_CMD_AUTH_KEY_A, 0};
-    BitBuffer* tx_buffer = bit_buffer_alloc(COUNT_OF(auth_cmd));
+    BitBuffer* tx_buffer = nfc_buffer_borrow(iso3_poller->nfc);
     bit_buffer_copy_bytes(tx_buffer, auth_cmd, COUNT_OF(auth_cmd));
-    BitBuffer* rx_buffer = bit_buffer_alloc(sizeof(MfClassicNt));
+    BitBuffer* rx_buffer = nfc_buffer_borrow(iso3_poller->nfc);
 
     if(iso14443_3a_event->type == Iso14443_3aPollerEventTypeReady) {
         Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
@@ -2230,8 +2230,8 @@ bool mf_classic_poller_detect(NfcGenericEvent event, void* context) {
         }
     }
 
-    bit_buffer_free(tx_buffer);
-    bit_buffer_free(rx_buffer);
+    nfc_buffer_return(iso3_poller->nfc, rx_buffer);
+    nfc_buffer_return(iso3_poller->nfc, tx_buffer);
 
     return detected;
 }
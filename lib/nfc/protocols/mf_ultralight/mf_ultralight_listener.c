@@ -2,6 +2,7 @@
 #include "mf_ultralight_listener_defs.h"
 
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/helpers/iso14443_crc.h>
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -40,7 +41,7 @@ static void mf_ultralight_listener_send_short_resp(MfUltralightListener* instanc
     iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
 }
 
-static void mf_ultralight_listener_perform_read(
+static void mf_ultralight_listener_read_pages(
     MfUltralightPage* pages,
     MfUltralightListener* instance,
     uint16_t start_page,
@@ -68,9 +69,102 @@ static void mf_ultralight_listener_perform_read(
             mf_ultralight_mirror_read_handler(page, pages[i].data, instance);
         }
     }
+}
+
+static void mf_ultralight_listener_perform_read(
+    MfUltralightPage* pages,
+    MfUltralightListener* instance,
+    uint16_t start_page,
+    uint8_t page_cnt,
+    bool do_i2c_page_check) {
+    mf_ultralight_listener_read_pages(pages, instance, start_page, page_cnt, do_i2c_page_check);
     mf_ultralight_single_counter_try_increase(instance);
 }
 
+static bool mf_ultralight_listener_read_cache_is_valid(
+    MfUltralightListener* instance,
+    uint16_t start_page) {
+    MfUltralightListenerReadCache* cache = &instance->read_cache;
+    return (start_page < cache->size) &&
+           (cache->valid[start_page / 32] & (1UL << (start_page % 32)));
+}
+
+static bool mf_ultralight_listener_read_cache_is_cacheable(
+    MfUltralightListener* instance,
+    uint16_t start_page) {
+    bool cacheable = false;
+
+    do {
+        if(start_page >= instance->read_cache.size) break;
+        // Sector select and ASCII mirror make the response depend on more than page data
+        if(mf_ultralight_is_i2c_tag(instance->data->type)) break;
+        if(mf_ultralight_mirror_enabled(instance)) break;
+
+        // Only windows readable without authentication, their content doesn't depend on it
+        MfUltralightListenerAuthState auth_state = instance->auth_state;
+        instance->auth_state = MfUltralightListenerAuthStateIdle;
+        cacheable = true;
+        for(uint8_t i = 0; i < 4; i++) {
+            if(!mf_ultralight_listener_check_access(
+                   instance, start_page + i, MfUltralightListenerAccessTypeRead)) {
+                cacheable = false;
+                break;
+            }
+        }
+        instance->auth_state = auth_state;
+    } while(false);
+
+    return cacheable;
+}
+
+static void mf_ultralight_listener_read_cache_store(
+    MfUltralightListener* instance,
+    uint16_t start_page,
+    const BitBuffer* frame) {
+    MfUltralightListenerReadCache* cache = &instance->read_cache;
+    bit_buffer_write_bytes(
+        frame, cache->frames[start_page], MF_ULTRALIGHT_LISTENER_READ_FRAME_SIZE);
+    cache->valid[start_page / 32] |= 1UL << (start_page % 32);
+}
+
+static void mf_ultralight_listener_read_cache_build(MfUltralightListener* instance) {
+    MfUltralightListenerReadCache* cache = &instance->read_cache;
+
+    for(uint16_t start_page = 0; start_page < cache->size; start_page++) {
+        if(!mf_ultralight_listener_read_cache_is_cacheable(instance, start_page)) continue;
+
+        MfUltralightPage pages[4] = {};
+        mf_ultralight_listener_read_pages(pages, instance, start_page, 4, false);
+        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+        iso14443_crc_append(Iso14443CrcTypeA, instance->tx_buffer);
+        mf_ultralight_listener_read_cache_store(instance, start_page, instance->tx_buffer);
+    }
+}
+
+static void
+    mf_ultralight_listener_read_cache_invalidate(MfUltralightListener* instance, uint16_t page) {
+    MfUltralightListenerReadCache* cache = &instance->read_cache;
+    if(page >= cache->size) return;
+
+    uint16_t config_page = mf_ultralight_get_config_page_num(instance->data->type);
+    bool access_changed = (instance->config != NULL) && (page >= config_page);
+    if(mf_ultralight_support_feature(instance->features, MfUltralightFeatureSupportAuthenticate)) {
+        // AUTH0 and AUTH1 of Ultralight C
+        access_changed = (page >= 42);
+    }
+
+    if(access_changed) {
+        // Protection or mirror settings changed, cacheability of every window has to be rechecked
+        memset(cache->valid, 0, ((cache->size + 31) / 32) * sizeof(uint32_t));
+    } else {
+        // READ wraps around pages_total, so the page is covered by the 4 windows ending at it
+        for(uint16_t i = 0; i < 4; i++) {
+            uint16_t start_page = (page + cache->size - i) % cache->size;
+            cache->valid[start_page / 32] &= ~(1UL << (start_page % 32));
+        }
+    }
+}
+
 static MfUltralightCommand mf_ultralight_listener_perform_write(
     MfUltralightListener* instance,
     const uint8_t* const rx_data,
@@ -93,6 +187,10 @@ static MfUltralightCommand mf_ultralight_listener_perform_write(
         memcpy(instance->data->page[page].data, rx_data, sizeof(MfUltralightPage));
     }
 
+    if(command == MfUltralightCommandProcessedACK && !do_i2c_check) {
+        mf_ultralight_listener_read_cache_invalidate(instance, start_page);
+    }
+
     return command;
 }
 
@@ -118,12 +216,24 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[4] = {};
-        mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
+        if(mf_ultralight_listener_read_cache_is_valid(instance, start_page)) {
+            bit_buffer_copy_bytes(
+                instance->tx_buffer,
+                instance->read_cache.frames[start_page],
+                MF_ULTRALIGHT_LISTENER_READ_FRAME_SIZE);
+            mf_ultralight_single_counter_try_increase(instance);
+        } else {
+            MfUltralightPage pages[4] = {};
+            mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
 
-        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
-        iso14443_3a_listener_send_standard_frame(
-            instance->iso14443_3a_listener, instance->tx_buffer);
+            bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+            iso14443_crc_append(Iso14443CrcTypeA, instance->tx_buffer);
+            if(mf_ultralight_listener_read_cache_is_cacheable(instance, start_page)) {
+                mf_ultralight_listener_read_cache_store(instance, start_page, instance->tx_buffer);
+            }
+        }
+
+        iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
         command = MfUltralightCommandProcessed;
 
     } while(false);
@@ -751,6 +861,12 @@ MfUltralightListener* mf_ultralight_listener_alloc(
     instance->sector = 0;
     instance->tx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_LISTENER_MAX_TX_BUFF_SIZE);
 
+    instance->read_cache.size = data->pages_total;
+    instance->read_cache.frames =
+        malloc(instance->read_cache.size * MF_ULTRALIGHT_LISTENER_READ_FRAME_SIZE);
+    instance->read_cache.valid = malloc(((instance->read_cache.size + 31) / 32) * sizeof(uint32_t));
+    mf_ultralight_listener_read_cache_build(instance);
+
     instance->mfu_event.data = &instance->mfu_event_data;
     instance->generic_event.protocol = NfcProtocolMfUltralight;
     instance->generic_event.instance = instance;
@@ -766,6 +882,8 @@ void mf_ultralight_listener_free(MfUltralightListener* instance) {
     furi_assert(instance->tx_buffer);
 
     bit_buffer_free(instance->tx_buffer);
+    free(instance->read_cache.frames);
+    free(instance->read_cache.valid);
     furi_string_free(instance->mirror.ascii_mirror_data);
     mbedtls_des3_free(&instance->des_context);
     free(instance);
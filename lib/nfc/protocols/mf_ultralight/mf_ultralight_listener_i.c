@@ -100,7 +100,7 @@ static bool mf_ultralight_mirror_check_boundaries(MfUltralightListener* instance
     return result;
 }
 
-static bool mf_ultralight_mirror_enabled(MfUltralightListener* instance) {
+bool mf_ultralight_mirror_enabled(MfUltralightListener* instance) {
     bool mirror_enabled = false;
     if(mf_ultralight_support_feature(instance->features, MfUltralightFeatureSupportAsciiMirror) &&
        (instance->config != NULL) && mf_ultralight_mirror_check_boundaries(instance)) {
@@ -47,6 +47,15 @@ typedef struct {
     FuriString* ascii_mirror_data;
 } MfUltralightMirrorMode;
 
+// READ response: 4 pages followed by CRC_A
+#define MF_ULTRALIGHT_LISTENER_READ_FRAME_SIZE (4 * sizeof(MfUltralightPage) + 2)
+
+typedef struct {
+    uint8_t (*frames)[MF_ULTRALIGHT_LISTENER_READ_FRAME_SIZE];
+    uint32_t* valid;
+    uint16_t size;
+} MfUltralightListenerReadCache;
+
 typedef uint16_t MfUltralightStaticLockData;
 typedef uint32_t MfUltralightDynamicLockData;
 
@@ -55,6 +64,7 @@ struct MfUltralightListener {
     MfUltralightListenerAuthState auth_state;
     MfUltralightData* data;
     BitBuffer* tx_buffer;
+    MfUltralightListenerReadCache read_cache;
     MfUltralightFeatureSupport features;
     MfUltralightConfigPages* config;
     MfUltralightStaticLockData* static_lock;
@@ -80,6 +90,7 @@ void mf_ultralight_single_counter_try_to_unlock(
     Iso14443_3aListenerEventType type);
 
 void mf_ultralight_mirror_prepare_emulation(MfUltralightListener* instance);
+bool mf_ultralight_mirror_enabled(MfUltralightListener* instance);
 void mf_ultraligt_mirror_format_counter(MfUltralightListener* instance);
 void mf_ultralight_mirror_read_prepare(uint8_t start_page, MfUltralightListener* instance);
 void mf_ultralight_mirror_read_handler(
@@ -1,12 +1,28 @@
 #include "environment.h"
 #include "registry.h"
 
+#define TAG "SubGhzEnvironment"
+
+typedef enum {
+    SubGhzEnvironmentRainbowTableCameAtomo,
+    SubGhzEnvironmentRainbowTableNiceFlorS,
+    SubGhzEnvironmentRainbowTableAlutechAt4n,
+
+    SubGhzEnvironmentRainbowTableNum,
+} SubGhzEnvironmentRainbowTableIndex;
+
+typedef struct {
+    const char* file_name;
+    uint8_t* data;
+    size_t size;
+    bool load_attempted;
+} SubGhzEnvironmentRainbowTable;
+
 struct SubGhzEnvironment {
     SubGhzKeystore* keystore;
     const SubGhzProtocolRegistry* protocol_registry;
-    const char* came_atomo_rainbow_table_file_name;
-    const char* nice_flor_s_rainbow_table_file_name;
-    const char* alutech_at_4n_rainbow_table_file_name;
+    SubGhzEnvironmentRainbowTable rainbow_table[SubGhzEnvironmentRainbowTableNum];
+    FuriMutex* rainbow_table_mutex;
 };
 
 SubGhzEnvironment* subghz_environment_alloc(void) {
@@ -14,20 +30,37 @@ SubGhzEnvironment* subghz_environment_alloc(void) {
 
     instance->keystore = subghz_keystore_alloc();
     instance->protocol_registry = NULL;
-    instance->came_atomo_rainbow_table_file_name = NULL;
-    instance->nice_flor_s_rainbow_table_file_name = NULL;
-    instance->alutech_at_4n_rainbow_table_file_name = NULL;
+    instance->rainbow_table_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 
     return instance;
 }
 
+static void subghz_environment_rainbow_table_reset(SubGhzEnvironmentRainbowTable* table) {
+    free(table->data);
+    table->data = NULL;
+    table->size = 0;
+    table->load_attempted = false;
+}
+
+static void subghz_environment_set_rainbow_table_file_name(
+    SubGhzEnvironment* instance,
+    SubGhzEnvironmentRainbowTableIndex index,
+    const char* filename) {
+    furi_check(furi_mutex_acquire(instance->rainbow_table_mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_environment_rainbow_table_reset(&instance->rainbow_table[index]);
+    instance->rainbow_table[index].file_name = filename;
+    furi_mutex_release(instance->rainbow_table_mutex);
+}
+
 void subghz_environment_free(SubGhzEnvironment* instance) {
     furi_check(instance);
 
     instance->protocol_registry = NULL;
-    instance->came_atomo_rainbow_table_file_name = NULL;
-    instance->nice_flor_s_rainbow_table_file_name = NULL;
-    instance->alutech_at_4n_rainbow_table_file_name = NULL;
+    for(size_t i = 0; i < SubGhzEnvironmentRainbowTableNum; i++) {
+        subghz_environment_rainbow_table_reset(&instance->rainbow_table[i]);
+        instance->rainbow_table[i].file_name = NULL;
+    }
+    furi_mutex_free(instance->rainbow_table_mutex);
     subghz_keystore_free(instance->keystore);
 
     free(instance);
@@ -50,14 +83,15 @@ void subghz_environment_set_came_atomo_rainbow_table_file_name(
     const char* filename) {
     furi_check(instance);
 
-    instance->came_atomo_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table_file_name(
+        instance, SubGhzEnvironmentRainbowTableCameAtomo, filename);
 }
 
 const char*
     subghz_environment_get_came_atomo_rainbow_table_file_name(SubGhzEnvironment* instance) {
     furi_check(instance);
 
-    return instance->came_atomo_rainbow_table_file_name;
+    return instance->rainbow_table[SubGhzEnvironmentRainbowTableCameAtomo].file_name;
 }
 
 void subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
@@ -65,14 +99,15 @@ void subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
     const char* filename) {
     furi_check(instance);
 
-    instance->alutech_at_4n_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table_file_name(
+        instance, SubGhzEnvironmentRainbowTableAlutechAt4n, filename);
 }
 
 const char*
     subghz_environment_get_alutech_at_4n_rainbow_table_file_name(SubGhzEnvironment* instance) {
     furi_check(instance);
 
-    return instance->alutech_at_4n_rainbow_table_file_name;
+    return instance->rainbow_table[SubGhzEnvironmentRainbowTableAlutechAt4n].file_name;
 }
 
 void subghz_environment_set_nice_flor_s_rainbow_table_file_name(
@@ -80,14 +115,75 @@ void subghz_environment_set_nice_flor_s_rainbow_table_file_name(
     const char* filename) {
     furi_check(instance);
 
-    instance->nice_flor_s_rainbow_table_file_name = filename;
+    subghz_environment_set_rainbow_table_file_name(
+        instance, SubGhzEnvironmentRainbowTableNiceFlorS, filename);
 }
 
 const char*
     subghz_environment_get_nice_flor_s_rainbow_table_file_name(SubGhzEnvironment* instance) {
     furi_check(instance);
 
-    return instance->nice_flor_s_rainbow_table_file_name;
+    return instance->rainbow_table[SubGhzEnvironmentRainbowTableNiceFlorS].file_name;
+}
+
+/** Decrypt the table once, tables that don't fit the cap stay on the storage */
+static void subghz_environment_rainbow_table_load(SubGhzEnvironmentRainbowTable* table) {
+    table->load_attempted = true;
+
+    size_t size = SUBGHZ_ENVIRONMENT_RAINBOW_TABLE_SIZE_MAX;
+    uint8_t* data = malloc(size);
+    if(subghz_keystore_raw_load(table->file_name, data, &size)) {
+        table->data = realloc(data, size);
+        table->size = size;
+        FURI_LOG_D(TAG, "Cached %zu bytes of %s", size, table->file_name);
+    } else {
+        free(data);
+        FURI_LOG_W(TAG, "Using paged reads for %s", table->file_name);
+    }
+}
+
+bool subghz_environment_get_rainbow_table_data(
+    SubGhzEnvironment* instance,
+    const char* file_name,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    furi_check(instance);
+    furi_check(file_name);
+    furi_check(data);
+
+    SubGhzEnvironmentRainbowTable* table = NULL;
+    for(size_t i = 0; i < SubGhzEnvironmentRainbowTableNum; i++) {
+        const char* table_file_name = instance->rainbow_table[i].file_name;
+        if(table_file_name && strcmp(table_file_name, file_name) == 0) {
+            table = &instance->rainbow_table[i];
+            break;
+        }
+    }
+
+    bool cached = false;
+    bool result = false;
+    if(table) {
+        furi_check(
+            furi_mutex_acquire(instance->rainbow_table_mutex, FuriWaitForever) == FuriStatusOk);
+        if(!table->load_attempted) {
+            subghz_environment_rainbow_table_load(table);
+        }
+        if(table->data) {
+            cached = true;
+            if(offset + len <= table->size) {
+                memcpy(data, &table->data[offset], len);
+                result = true;
+            }
+        }
+        furi_mutex_release(instance->rainbow_table_mutex);
+    }
+
+    if(!cached) {
+        result = subghz_keystore_raw_get_data(file_name, offset, data, len);
+    }
+
+    return result;
 }
 
 void subghz_environment_set_protocol_registry(
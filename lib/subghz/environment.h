@@ -9,6 +9,9 @@
 extern "C" {
 #endif
 
+/** Largest rainbow table kept decrypted in RAM, bigger ones are read from the file every time */
+#define SUBGHZ_ENVIRONMENT_RAINBOW_TABLE_SIZE_MAX (512U)
+
 typedef struct SubGhzEnvironment SubGhzEnvironment;
 typedef struct SubGhzProtocolRegistry SubGhzProtocolRegistry;
 
@@ -88,6 +91,24 @@ void subghz_environment_set_nice_flor_s_rainbow_table_file_name(
 const char*
     subghz_environment_get_nice_flor_s_rainbow_table_file_name(SubGhzEnvironment* instance);
 
+/**
+ * Read decrypted bytes from one of the rainbow tables set in the environment.
+ * The table is decrypted on first use and served from RAM afterwards, tables over
+ * SUBGHZ_ENVIRONMENT_RAINBOW_TABLE_SIZE_MAX or unknown to the environment are read from the file.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @param file_name Full path to the file
+ * @param offset Offset from the start of the table
+ * @param data Returned array
+ * @param len Required data length
+ * @return true On success
+ */
+bool subghz_environment_get_rainbow_table_data(
+    SubGhzEnvironment* instance,
+    const char* file_name,
+    size_t offset,
+    uint8_t* data,
+    size_t len);
+
 /**
  * Set list of protocols to work.
  * @param instance Pointer to a SubGhzEnvironment instance
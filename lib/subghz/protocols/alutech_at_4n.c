@@ -26,6 +26,7 @@ struct SubGhzProtocolDecoderAlutech_at_4n {
     uint32_t crc;
     uint16_t header_count;
 
+    SubGhzEnvironment* environment;
     const char* alutech_at_4n_rainbow_table_file_name;
 };
 
@@ -76,11 +77,13 @@ const SubGhzProtocol subghz_protocol_alutech_at_4n = {
 
 /**
  * Read bytes from rainbow table
+ * @param environment Pointer to a SubGhzEnvironment instance caching the table
  * @param file_name Full path to rainbow table the file
  * @param number_alutech_at_4n_magic_data number in the array
  * @return alutech_at_4n_magic_data
  */
 static uint32_t subghz_protocol_alutech_at_4n_get_magic_data_in_file(
+    SubGhzEnvironment* environment,
     const char* file_name,
     uint8_t number_alutech_at_4n_magic_data) {
     if(!strcmp(file_name, "")) return SUBGHZ_NO_ALUTECH_AT_4N_RAINBOW_TABLE;
@@ -89,7 +92,8 @@ static uint32_t subghz_protocol_alutech_at_4n_get_magic_data_in_file(
     uint32_t address = number_alutech_at_4n_magic_data * sizeof(uint32_t);
     uint32_t alutech_at_4n_magic_data = 0;
 
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint32_t))) {
+    if(subghz_environment_get_rainbow_table_data(
+           environment, file_name, address, buffer, sizeof(uint32_t))) {
         for(size_t i = 0; i < sizeof(uint32_t); i++) {
             alutech_at_4n_magic_data = (alutech_at_4n_magic_data << 8) | buffer[i];
         }
@@ -129,18 +133,21 @@ static uint8_t subghz_protocol_alutech_at_4n_decrypt_data_crc(uint8_t data) {
     return ~crc;
 }
 
-static uint64_t subghz_protocol_alutech_at_4n_decrypt(uint64_t data, const char* file_name) {
+static uint64_t subghz_protocol_alutech_at_4n_decrypt(
+    uint64_t data,
+    SubGhzEnvironment* environment,
+    const char* file_name) {
     uint8_t* p = (uint8_t*)&data;
     uint32_t data1 = p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3];
     uint32_t data2 = p[4] << 24 | p[5] << 16 | p[6] << 8 | p[7];
     uint32_t data3 = 0;
     uint32_t magic_data[] = {
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 0),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 1),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 2),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 3),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 4),
-        subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 5)};
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 0),
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 1),
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 2),
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 3),
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 4),
+        subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 5)};
 
     uint32_t i = magic_data[0];
     do {
@@ -171,11 +178,11 @@ static uint64_t subghz_protocol_alutech_at_4n_decrypt(uint64_t data, const char*
 //     uint32_t data3 = p[4] << 24 | p[5] << 16 | p[6] << 8 | p[7];
 //     uint32_t magic_data[] = {
 //         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 6),
-//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 4),
-//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 5),
-//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 1),
-//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 2),
-//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 0)};
+//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 4),
+//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 5),
+//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 1),
+//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 2),
+//         subghz_protocol_alutech_at_4n_get_magic_data_in_file(environment, file_name, 0)};
 
 //     do {
 //         data1 = data1 + magic_data[0];
@@ -201,6 +208,7 @@ void* subghz_protocol_decoder_alutech_at_4n_alloc(SubGhzEnvironment* environment
         malloc(sizeof(SubGhzProtocolDecoderAlutech_at_4n));
     instance->base.protocol = &subghz_protocol_alutech_at_4n;
     instance->generic.protocol_name = instance->base.protocol->name;
+    instance->environment = environment;
     instance->alutech_at_4n_rainbow_table_file_name =
         subghz_environment_get_alutech_at_4n_rainbow_table_file_name(environment);
     if(instance->alutech_at_4n_rainbow_table_file_name) {
@@ -334,11 +342,13 @@ void subghz_protocol_decoder_alutech_at_4n_feed(void* context, bool level, uint3
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param environment Pointer to a SubGhzEnvironment instance
  * @param file_name Full path to rainbow table the file
  */
 static void subghz_protocol_alutech_at_4n_remote_controller(
     SubGhzBlockGeneric* instance,
     uint8_t crc,
+    SubGhzEnvironment* environment,
     const char* file_name) {
     /**
  *  Message format 72bit LSB first
@@ -361,7 +371,7 @@ static void subghz_protocol_alutech_at_4n_remote_controller(
     crc = subghz_protocol_blocks_reverse_key(crc, 8);
 
     if(crc == subghz_protocol_alutech_at_4n_crc(data)) {
-        data = subghz_protocol_alutech_at_4n_decrypt(data, file_name);
+        data = subghz_protocol_alutech_at_4n_decrypt(data, environment, file_name);
         status = true;
     }
 
@@ -433,7 +443,10 @@ void subghz_protocol_decoder_alutech_at_4n_get_string(void* context, FuriString*
     furi_assert(context);
     SubGhzProtocolDecoderAlutech_at_4n* instance = context;
     subghz_protocol_alutech_at_4n_remote_controller(
-        &instance->generic, instance->crc, instance->alutech_at_4n_rainbow_table_file_name);
+        &instance->generic,
+        instance->crc,
+        instance->environment,
+        instance->alutech_at_4n_rainbow_table_file_name);
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
@@ -24,6 +24,7 @@ struct SubGhzProtocolDecoderCameAtomo {
     SubGhzBlockGeneric generic;
 
     ManchesterState manchester_saved_state;
+    SubGhzEnvironment* environment;
     const char* came_atomo_rainbow_table_file_name;
 };
 
@@ -74,6 +75,7 @@ void* subghz_protocol_decoder_came_atomo_alloc(SubGhzEnvironment* environment) {
     SubGhzProtocolDecoderCameAtomo* instance = malloc(sizeof(SubGhzProtocolDecoderCameAtomo));
     instance->base.protocol = &subghz_protocol_came_atomo;
     instance->generic.protocol_name = instance->base.protocol->name;
+    instance->environment = environment;
     instance->came_atomo_rainbow_table_file_name =
         subghz_environment_get_came_atomo_rainbow_table_file_name(environment);
     if(instance->came_atomo_rainbow_table_file_name) {
@@ -188,11 +190,13 @@ void subghz_protocol_decoder_came_atomo_feed(void* context, bool level, uint32_t
 
 /** 
  * Read bytes from rainbow table
+ * @param environment Pointer to a SubGhzEnvironment instance caching the table
  * @param file_name Full path to rainbow table the file 
  * @param number_atomo_magic_xor number in the array
  * @return atomo_magic_xor
  */
 static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
+    SubGhzEnvironment* environment,
     const char* file_name,
     uint8_t number_atomo_magic_xor) {
     if(!strcmp(file_name, "")) return SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE;
@@ -201,7 +205,8 @@ static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
     uint32_t address = number_atomo_magic_xor * sizeof(uint64_t);
     uint64_t atomo_magic_xor = 0;
 
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint64_t))) {
+    if(subghz_environment_get_rainbow_table_data(
+           environment, file_name, address, buffer, sizeof(uint64_t))) {
         for(size_t i = 0; i < sizeof(uint64_t); i++) {
             atomo_magic_xor = (atomo_magic_xor << 8) | buffer[i];
         }
@@ -214,10 +219,12 @@ static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param environment Pointer to a SubGhzEnvironment instance
  * @param file_name Full path to rainbow table the file
  */
 static void subghz_protocol_came_atomo_remote_controller(
     SubGhzBlockGeneric* instance,
+    SubGhzEnvironment* environment,
     const char* file_name) {
     /* 
     * 0x1fafef3ed0f7d9ef
@@ -277,7 +284,8 @@ static void subghz_protocol_came_atomo_remote_controller(
     parcel_counter >>= 4;
     uint8_t ind = (parcel_counter + 1) % 32;
     uint64_t temp_data = instance->data & 0x0000FFFFFFFFFFFF;
-    uint64_t atomo_magic_xor = subghz_protocol_came_atomo_get_magic_xor_in_file(file_name, ind);
+    uint64_t atomo_magic_xor =
+        subghz_protocol_came_atomo_get_magic_xor_in_file(environment, file_name, ind);
 
     if(atomo_magic_xor != SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE) {
         temp_data = temp_data ^ atomo_magic_xor;
@@ -321,7 +329,7 @@ void subghz_protocol_decoder_came_atomo_get_string(void* context, FuriString* ou
     furi_assert(context);
     SubGhzProtocolDecoderCameAtomo* instance = context;
     subghz_protocol_came_atomo_remote_controller(
-        &instance->generic, instance->came_atomo_rainbow_table_file_name);
+        &instance->generic, instance->environment, instance->came_atomo_rainbow_table_file_name);
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
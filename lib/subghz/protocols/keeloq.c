@@ -12,6 +12,38 @@
 
 #define TAG "SubGhzProtocolKeeloq"
 
+#define KEELOQ_LEARNED_CACHE_SIZE     (8U)
+#define KEELOQ_CANDIDATES_PER_KEY_MAX (8U)
+
+/** Remote found in the keystore, repeat parcels are checked with one decrypt */
+typedef struct {
+    uint32_t serial;
+    uint32_t fix;
+    uint64_t key;
+    uint64_t man;
+    uint8_t learning;
+    bool centurion;
+    const char* manufacture_name;
+} SubGhzKeeloqLearned;
+
+/** Manufacture key with one of its learning types */
+typedef struct {
+    const SubGhzKey* manufacture_code;
+    uint64_t key;
+    uint8_t learning;
+    bool centurion;
+} SubGhzKeeloqCandidate;
+
+typedef struct {
+    SubGhzKeeloqLearned learned[KEELOQ_LEARNED_CACHE_SIZE]; // Most recently used first
+    size_t learned_count;
+
+    SubGhzKeeloqCandidate candidate[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t data[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint64_t key[KEELOQ_DECRYPT_BATCH_SIZE];
+    uint32_t result[2][KEELOQ_DECRYPT_BATCH_SIZE];
+} SubGhzKeeloqSearch;
+
 static const SubGhzBlockConst subghz_protocol_keeloq_const = {
     .te_short = 400,
     .te_long = 800,
@@ -27,6 +59,7 @@ struct SubGhzProtocolDecoderKeeloq {
 
     uint16_t header_count;
     SubGhzKeystore* keystore;
+    SubGhzKeeloqSearch* search;
     const char* manufacture_name;
 };
 
@@ -37,6 +70,7 @@ struct SubGhzProtocolEncoderKeeloq {
     SubGhzBlockGeneric generic;
 
     SubGhzKeystore* keystore;
+    SubGhzKeeloqSearch* search;
     const char* manufacture_name;
 };
 
@@ -84,11 +118,13 @@ const SubGhzProtocol subghz_protocol_keeloq = {
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param search Pointer to a SubGhzKeeloqSearch instance
  * @param manufacture_name
  */
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearch* search,
     const char** manufacture_name);
 
 void* subghz_protocol_encoder_keeloq_alloc(SubGhzEnvironment* environment) {
@@ -97,6 +133,7 @@ void* subghz_protocol_encoder_keeloq_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_keeloq;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->search = malloc(sizeof(SubGhzKeeloqSearch));
 
     instance->encoder.repeat = 10;
     instance->encoder.size_upload = 256;
@@ -109,6 +146,7 @@ void subghz_protocol_encoder_keeloq_free(void* context) {
     furi_assert(context);
     SubGhzProtocolEncoderKeeloq* instance = context;
     free(instance->encoder.upload);
+    free(instance->search);
     free(instance);
 }
 
@@ -269,7 +307,7 @@ SubGhzProtocolStatus
             break;
         }
         subghz_protocol_keeloq_check_remote_controller(
-            &instance->generic, instance->keystore, &instance->manufacture_name);
+            &instance->generic, instance->keystore, instance->search, &instance->manufacture_name);
 
         if(strcmp(instance->manufacture_name, "DoorHan") != 0) {
             FURI_LOG_E(TAG, "Wrong manufacturer name");
@@ -334,6 +372,7 @@ void* subghz_protocol_decoder_keeloq_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_keeloq;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->search = malloc(sizeof(SubGhzKeeloqSearch));
 
     return instance;
 }
@@ -342,6 +381,7 @@ void subghz_protocol_decoder_keeloq_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
 
+    free(instance->search);
     free(instance);
 }
 
@@ -480,12 +520,254 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+/**
+ * Device key of a remote
+ * @param learning Learning type, KEELOQ_LEARNING_UNKNOWN is not allowed
+ * @param fix Fix part of the parcel
+ * @param key Manufacture key
+ * @return Device key
+ */
+static uint64_t subghz_protocol_keeloq_learn(uint8_t learning, uint32_t fix, uint64_t key) {
+    switch(learning) {
+    case KEELOQ_LEARNING_NORMAL:
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KEELOQ_LEARNING_SECURE:
+        return subghz_protocol_keeloq_common_secure_learning(fix, 0, key);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    default:
+        return key;
+    }
+}
+
+static bool subghz_protocol_keeloq_check_candidate(
+    SubGhzBlockGeneric* instance,
+    uint32_t decrypt,
+    uint8_t btn,
+    uint32_t end_serial,
+    bool centurion) {
+    return centurion ? subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn) :
+                       subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+}
+
+/**
+ * Repeat parcel of a recently found remote, one decrypt with the learned device key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param search Pointer to a SubGhzKeeloqSearch instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param manufacture_name
+ * @return true if the remote is known and the parcel is valid for it
+ */
+static bool subghz_protocol_keeloq_learned_check(
+    SubGhzBlockGeneric* instance,
+    SubGhzKeeloqSearch* search,
+    uint32_t fix,
+    uint32_t hop,
+    const char** manufacture_name) {
+    uint32_t serial = fix & 0x0FFFFFFF;
+    bool found = false;
+
+    for(size_t i = 0; i < search->learned_count; i++) {
+        SubGhzKeeloqLearned* learned = &search->learned[i];
+        if(learned->serial != serial) continue;
+
+        // Some learning types mix the button into the device key
+        if(learned->fix != fix) {
+            learned->fix = fix;
+            learned->man = subghz_protocol_keeloq_learn(learned->learning, fix, learned->key);
+        }
+
+        uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, learned->man);
+        if(subghz_protocol_keeloq_check_candidate(
+               instance, decrypt, fix >> 28, fix & 0xFF, learned->centurion)) {
+            SubGhzKeeloqLearned hit = *learned;
+            memmove(&search->learned[1], &search->learned[0], i * sizeof(SubGhzKeeloqLearned));
+            search->learned[0] = hit;
+            *manufacture_name = hit.manufacture_name;
+            found = true;
+        }
+        break;
+    }
+
+    return found;
+}
+
+static void subghz_protocol_keeloq_learned_add(
+    SubGhzKeeloqSearch* search,
+    const SubGhzKeeloqCandidate* candidate,
+    uint64_t man,
+    uint32_t fix) {
+    uint32_t serial = fix & 0x0FFFFFFF;
+
+    // Entry of the same serial failed the check above, replace it. Otherwise evict the oldest.
+    size_t index = 0;
+    while(index < search->learned_count && search->learned[index].serial != serial) {
+        index++;
+    }
+    if(index == search->learned_count) {
+        if(search->learned_count < KEELOQ_LEARNED_CACHE_SIZE) search->learned_count++;
+        index = search->learned_count - 1;
+    }
+    memmove(&search->learned[1], &search->learned[0], index * sizeof(SubGhzKeeloqLearned));
+
+    search->learned[0] = (SubGhzKeeloqLearned){
+        .serial = serial,
+        .fix = fix,
+        .key = candidate->key,
+        .man = man,
+        .learning = candidate->learning,
+        .centurion = candidate->centurion,
+        .manufacture_name = furi_string_get_cstr(candidate->manufacture_code->name),
+    };
+}
+
+static uint64_t subghz_protocol_keeloq_mirror_key(uint64_t key) {
+    uint64_t man_rev = 0;
+    uint64_t man_rev_byte = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev_byte = (uint8_t)(key >> i);
+        man_rev = man_rev | man_rev_byte << (56 - i);
+    }
+    return man_rev;
+}
+
+static size_t subghz_protocol_keeloq_candidates_count(const SubGhzKey* manufacture_code) {
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        return KEELOQ_CANDIDATES_PER_KEY_MAX;
+    } else if(manufacture_code->type <= KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3) {
+        return 1;
+    } else {
+        return 0;
+    }
+}
+
+/**
+ * Expand manufacture key into candidates in the order they have to be tried
+ * @param candidate Destination, subghz_protocol_keeloq_candidates_count items
+ * @param manufacture_code Manufacture key
+ */
+static void subghz_protocol_keeloq_candidates_add(
+    SubGhzKeeloqCandidate* candidate,
+    const SubGhzKey* manufacture_code) {
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        // Simple, normal, secure and magic xor learning, each also with mirrored key
+        static const uint8_t learning[KEELOQ_CANDIDATES_PER_KEY_MAX / 2] = {
+            KEELOQ_LEARNING_SIMPLE,
+            KEELOQ_LEARNING_NORMAL,
+            KEELOQ_LEARNING_SECURE,
+            KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+        };
+        uint64_t man_rev = subghz_protocol_keeloq_mirror_key(manufacture_code->key);
+        for(size_t i = 0; i < COUNT_OF(learning); i++) {
+            candidate[i * 2] = (SubGhzKeeloqCandidate){
+                .manufacture_code = manufacture_code,
+                .key = manufacture_code->key,
+                .learning = learning[i],
+            };
+            candidate[i * 2 + 1] = (SubGhzKeeloqCandidate){
+                .manufacture_code = manufacture_code,
+                .key = man_rev,
+                .learning = learning[i],
+            };
+        }
+    } else {
+        *candidate = (SubGhzKeeloqCandidate){
+            .manufacture_code = manufacture_code,
+            .key = manufacture_code->key,
+            .learning = manufacture_code->type,
+            .centurion = (manufacture_code->type == KEELOQ_LEARNING_NORMAL) &&
+                         (strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0),
+        };
+    }
+}
+
+/**
+ * Check the parcel against a batch of candidates
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param search Pointer to a SubGhzKeeloqSearch instance with candidates filled
+ * @param count Number of candidates
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param manufacture_name
+ * @return true on successful search
+ */
+static bool subghz_protocol_keeloq_candidates_check(
+    SubGhzBlockGeneric* instance,
+    SubGhzKeeloqSearch* search,
+    size_t count,
+    uint32_t fix,
+    uint32_t hop,
+    const char** manufacture_name) {
+    // Normal and secure learning derive the device key with two decrypts each
+    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+    uint32_t serial = fix & 0x0FFFFFFF;
+    uint32_t seed = 0;
+    for(size_t half = 0; half < 2; half++) {
+        size_t jobs = 0;
+        for(size_t i = 0; i < count; i++) {
+            const SubGhzKeeloqCandidate* candidate = &search->candidate[i];
+            if(candidate->learning == KEELOQ_LEARNING_NORMAL) {
+                search->data[jobs] = serial | (half ? 0x60000000 : 0x20000000);
+            } else if(candidate->learning == KEELOQ_LEARNING_SECURE) {
+                search->data[jobs] = half ? seed : serial;
+            } else {
+                continue;
+            }
+            search->key[jobs++] = candidate->key;
+        }
+        if(jobs) {
+            subghz_protocol_keeloq_common_decrypt_batch(
+                search->data, search->key, search->result[half], jobs);
+        }
+    }
+
+    for(size_t i = 0, job = 0; i < count; i++) {
+        const SubGhzKeeloqCandidate* candidate = &search->candidate[i];
+        if(candidate->learning == KEELOQ_LEARNING_NORMAL) {
+            search->key[i] = ((uint64_t)search->result[1][job] << 32) | search->result[0][job];
+            job++;
+        } else if(candidate->learning == KEELOQ_LEARNING_SECURE) {
+            search->key[i] = ((uint64_t)search->result[0][job] << 32) | search->result[1][job];
+            job++;
+        } else {
+            search->key[i] =
+                subghz_protocol_keeloq_learn(candidate->learning, fix, candidate->key);
+        }
+        search->data[i] = hop;
+    }
+    subghz_protocol_keeloq_common_decrypt_batch(
+        search->data, search->key, search->result[0], count);
+
+    // Candidates keep the keystore order, so the first valid one is the same as tried one by one
+    bool found = false;
+    for(size_t i = 0; i < count; i++) {
+        const SubGhzKeeloqCandidate* candidate = &search->candidate[i];
+        if(subghz_protocol_keeloq_check_candidate(
+               instance, search->result[0][i], fix >> 28, fix & 0xFF, candidate->centurion)) {
+            subghz_protocol_keeloq_learned_add(search, candidate, search->key[i], fix);
+            *manufacture_name = furi_string_get_cstr(candidate->manufacture_code->name);
+            found = true;
+            break;
+        }
+    }
+
+    return found;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param search Pointer to a SubGhzKeeloqSearch instance
  * @param manufacture_name 
  * @return true on successful search
  */
@@ -494,167 +776,37 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t fix,
     uint32_t hop,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearch* search,
     const char** manufacture_name) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
 
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
-    uint32_t seed = 0;
+    if(subghz_protocol_keeloq_learned_check(instance, search, fix, hop, manufacture_name)) {
+        return 1;
+    }
 
+    size_t count = 0;
     for
         M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_SIMPLE:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_NORMAL:
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                    if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                } else {
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        return 1;
-                    }
-                }
-                break;
-            case KEELOQ_LEARNING_SECURE:
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            size_t code_count = subghz_protocol_keeloq_candidates_count(manufacture_code);
+            if(!code_count) continue;
+            if(count + code_count > KEELOQ_DECRYPT_BATCH_SIZE) {
+                if(subghz_protocol_keeloq_candidates_check(
+                       instance, search, count, fix, hop, manufacture_name)) {
                     return 1;
                 }
-                break;
-            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Secure Learning
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Magic xor type1 learning
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
+                count = 0;
             }
+            subghz_protocol_keeloq_candidates_add(&search->candidate[count], manufacture_code);
+            count += code_count;
         }
 
+    if(count && subghz_protocol_keeloq_candidates_check(
+                    instance, search, count, fix, hop, manufacture_name)) {
+        return 1;
+    }
+
     *manufacture_name = "Unknown";
     instance->cnt = 0;
 
@@ -664,6 +816,7 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeeloqSearch* search,
     const char** manufacture_name) {
     uint64_t key = subghz_protocol_blocks_reverse_key(instance->data, instance->data_count_bit);
     uint32_t key_fix = key >> 32;
@@ -678,7 +831,7 @@ static void subghz_protocol_keeloq_check_remote_controller(
         instance->cnt = key_hop >> 16;
     } else {
         subghz_protocol_keeloq_check_remote_controller_selector(
-            instance, key_fix, key_hop, keystore, manufacture_name);
+            instance, key_fix, key_hop, keystore, search, manufacture_name);
     }
 
     instance->serial = key_fix & 0x0FFFFFFF;
@@ -699,7 +852,7 @@ SubGhzProtocolStatus subghz_protocol_decoder_keeloq_serialize(
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->search, &instance->manufacture_name);
 
     SubGhzProtocolStatus res =
         subghz_block_generic_serialize(&instance->generic, flipper_format, preset);
@@ -725,7 +878,7 @@ void subghz_protocol_decoder_keeloq_get_string(void* context, FuriString* output
     furi_assert(context);
     SubGhzProtocolDecoderKeeloq* instance = context;
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->search, &instance->manufacture_name);
 
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
@@ -35,6 +35,75 @@ inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const
     return x;
 }
 
+/** Transpose 32x32 bit matrix around the anti-diagonal
+ * @param a - matrix, bit j of a[i] is swapped with bit 31 - i of a[31 - j]
+ */
+static void subghz_protocol_keeloq_common_transpose(uint32_t* a) {
+    uint32_t m = 0x0000FFFF;
+    for(uint32_t j = 16; j != 0; j >>= 1, m ^= m << j) {
+        for(uint32_t k = 0; k < 32; k = (k + j + 1) & ~j) {
+            uint32_t t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k] ^= t;
+            a[k + j] ^= t << j;
+        }
+    }
+}
+
+/** Bitsliced Decrypt
+ * @param data - keeloq encrypt data, count items
+ * @param key - manufacture (64bit), count items
+ * @param result - decrypted data, count items
+ * @param count - number of pairs, KEELOQ_DECRYPT_BATCH_SIZE max
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t* data,
+    const uint64_t* key,
+    uint32_t* result,
+    size_t count) {
+    furi_check(count <= KEELOQ_DECRYPT_BATCH_SIZE);
+
+    // Bitsliced: bit j of every word belongs to lane j, words are bits of the lane state and key.
+    // After the transpose state bit p of lane j is at bit j of x[31 - p].
+    uint32_t x[32] = {};
+    uint32_t k_lo[32] = {};
+    uint32_t k_hi[32] = {};
+    for(size_t i = 0; i < count; i++) {
+        x[31 - i] = data[i];
+        k_lo[31 - i] = (uint32_t)key[i];
+        k_hi[31 - i] = (uint32_t)(key[i] >> 32);
+    }
+    subghz_protocol_keeloq_common_transpose(x);
+    subghz_protocol_keeloq_common_transpose(k_lo);
+    subghz_protocol_keeloq_common_transpose(k_hi);
+
+    // State bit p is at x[(o - p) & 31], shifting the register left only moves o
+    uint32_t o = 31;
+    for(uint32_t r = 0; r < 528; r++) {
+        uint32_t a = x[o & 31];
+        uint32_t b = x[(o - 8) & 31];
+        uint32_t c = x[(o - 19) & 31];
+        uint32_t d = x[(o - 25) & 31];
+        uint32_t e = x[(o - 30) & 31];
+        // KEELOQ_NLF in algebraic normal form
+        uint32_t nlf = a ^ b ^ (a & b) ^ (b & c) ^ (a & d) ^ (c & d) ^
+                       (e & (a ^ c ^ (a & b) ^ (a & c) ^ (b & d) ^ (c & d)));
+        uint32_t k_bit = (15 - r) & 63;
+        uint32_t k = (k_bit < 32) ? k_lo[31 - k_bit] : k_hi[63 - k_bit];
+
+        o++;
+        x[o & 31] ^= x[(o - 16) & 31] ^ k ^ nlf;
+    }
+
+    uint32_t y[32];
+    for(uint32_t p = 0; p < 32; p++) {
+        y[31 - p] = x[(o - p) & 31];
+    }
+    subghz_protocol_keeloq_common_transpose(y);
+    for(size_t i = 0; i < count; i++) {
+        result[i] = y[31 - i];
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
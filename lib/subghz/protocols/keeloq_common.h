@@ -25,6 +25,9 @@
 #define KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2 6u
 #define KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 7u
 
+/** Number of keys decrypted in one pass of subghz_protocol_keeloq_common_decrypt_batch */
+#define KEELOQ_DECRYPT_BATCH_SIZE 32u
+
 /**
  * Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
@@ -41,6 +44,19 @@ uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64
  */
 uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key);
 
+/** 
+ * Bitsliced Decrypt of up to KEELOQ_DECRYPT_BATCH_SIZE data/key pairs in one pass
+ * @param data - keeloq encrypt data, count items
+ * @param key - manufacture (64bit), count items
+ * @param result - decrypted data, count items
+ * @param count - number of pairs, KEELOQ_DECRYPT_BATCH_SIZE max
+ */
+void subghz_protocol_keeloq_common_decrypt_batch(
+    const uint32_t* data,
+    const uint64_t* key,
+    uint32_t* result,
+    size_t count);
+
 /** 
  * Normal Learning
  * @param data - serial number (28bit)
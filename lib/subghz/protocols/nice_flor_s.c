@@ -30,6 +30,7 @@ struct SubGhzProtocolDecoderNiceFlorS {
     SubGhzBlockDecoder decoder;
     SubGhzBlockGeneric generic;
 
+    SubGhzEnvironment* environment;
     const char* nice_flor_s_rainbow_table_file_name;
     uint64_t data;
 };
@@ -141,16 +142,20 @@ const SubGhzProtocol subghz_protocol_nice_flor_s = {
 
 /** 
  * Read bytes from rainbow table
+ * @param environment Pointer to a SubGhzEnvironment instance caching the table
  * @param file_name Full path to rainbow table the file 
  * @param address Byte address in file
  * @return data
  */
-static uint8_t
-    subghz_protocol_nice_flor_s_get_byte_in_file(const char* file_name, uint32_t address) {
+static uint8_t subghz_protocol_nice_flor_s_get_byte_in_file(
+    SubGhzEnvironment* environment,
+    const char* file_name,
+    uint32_t address) {
     if(!file_name) return 0;
 
     uint8_t buffer[1] = {0};
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint8_t))) {
+    if(subghz_environment_get_rainbow_table_data(
+           environment, file_name, address, buffer, sizeof(uint8_t))) {
         return buffer[0];
     } else {
         return 0;
@@ -163,17 +168,20 @@ static inline void subghz_protocol_decoder_nice_flor_s_magic_xor(uint8_t* p, uin
     }
 }
 
-uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_name) {
+uint64_t subghz_protocol_nice_flor_s_encrypt(
+    uint64_t data,
+    SubGhzEnvironment* environment,
+    const char* file_name) {
     uint8_t* p = (uint8_t*)&data;
 
     uint8_t k = 0;
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(environment, file_name, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0xe0;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(environment, file_name, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -197,8 +205,10 @@ uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_nam
     return data;
 }
 
-static uint64_t
-    subghz_protocol_nice_flor_s_decrypt(SubGhzBlockGeneric* instance, const char* file_name) {
+static uint64_t subghz_protocol_nice_flor_s_decrypt(
+    SubGhzBlockGeneric* instance,
+    SubGhzEnvironment* environment,
+    const char* file_name) {
     furi_assert(instance);
     uint64_t data = instance->data;
     uint8_t* p = (uint8_t*)&data;
@@ -215,12 +225,12 @@ static uint64_t
     p[1] = k;
 
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(environment, file_name, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0x7;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(environment, file_name, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -239,6 +249,7 @@ void* subghz_protocol_decoder_nice_flor_s_alloc(SubGhzEnvironment* environment)
     SubGhzProtocolDecoderNiceFlorS* instance = malloc(sizeof(SubGhzProtocolDecoderNiceFlorS));
     instance->base.protocol = &subghz_protocol_nice_flor_s;
     instance->generic.protocol_name = instance->base.protocol->name;
+    instance->environment = environment;
     instance->nice_flor_s_rainbow_table_file_name =
         subghz_environment_get_nice_flor_s_rainbow_table_file_name(environment);
     if(instance->nice_flor_s_rainbow_table_file_name) {
@@ -352,10 +363,12 @@ void subghz_protocol_decoder_nice_flor_s_feed(void* context, bool level, uint32_
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param environment Pointer to a SubGhzEnvironment instance
  * @param file_name Full path to rainbow table the file 
  */
 static void subghz_protocol_nice_flor_s_remote_controller(
     SubGhzBlockGeneric* instance,
+    SubGhzEnvironment* environment,
     const char* file_name) {
     /*
     * Protocol Nice Flor-S
@@ -403,7 +416,7 @@ static void subghz_protocol_nice_flor_s_remote_controller(
         instance->serial = 0;
         instance->btn = 0;
     } else {
-        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, file_name);
+        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, environment, file_name);
         instance->cnt = decrypt & 0xFFFF;
         instance->serial = (decrypt >> 16) & 0xFFFFFFF;
         instance->btn = (decrypt >> 48) & 0xF;
@@ -475,7 +488,7 @@ void subghz_protocol_decoder_nice_flor_s_get_string(void* context, FuriString* o
     SubGhzProtocolDecoderNiceFlorS* instance = context;
 
     subghz_protocol_nice_flor_s_remote_controller(
-        &instance->generic, instance->nice_flor_s_rainbow_table_file_name);
+        &instance->generic, instance->environment, instance->nice_flor_s_rainbow_table_file_name);
 
     if(instance->generic.data_count_bit == NICE_ONE_COUNT_BIT) {
         furi_string_cat_printf(
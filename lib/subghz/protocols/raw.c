@@ -10,7 +10,7 @@
 
 #define TAG "SubGhzProtocolRaw"
 
-#define SUBGHZ_DOWNLOAD_MAX_SIZE 512
+#define SUBGHZ_DOWNLOAD_MAX_SIZE SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
 
 static const SubGhzBlockConst subghz_protocol_raw_const = {
     .te_short = 50,
@@ -26,6 +26,8 @@ struct SubGhzProtocolDecoderRAW {
     uint16_t ind_write;
     Storage* storage;
     FlipperFormat* flipper_file;
+    SubGhzRawEncoding encoding;
+    SubGhzRawCodec* codec;
     uint32_t file_is_open;
     FuriString* file_name;
     size_t sample_write;
@@ -81,6 +83,14 @@ const SubGhzProtocol subghz_protocol_raw = {
     .encoder = &subghz_protocol_raw_encoder,
 };
 
+void subghz_protocol_raw_save_to_file_set_encoding(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawEncoding encoding) {
+    furi_check(instance);
+
+    instance->encoding = encoding;
+}
+
 bool subghz_protocol_raw_save_to_file_init(
     SubGhzProtocolDecoderRAW* instance,
     const char* dev_name,
@@ -121,7 +131,9 @@ bool subghz_protocol_raw_save_to_file_init(
         }
 
         if(!flipper_format_write_header_cstr(
-               instance->flipper_file, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION)) {
+               instance->flipper_file,
+               SUBGHZ_RAW_FILE_TYPE,
+               subghz_raw_codec_get_file_version(instance->encoding))) {
             FURI_LOG_E(TAG, "Unable to add header");
             break;
         }
@@ -156,6 +168,14 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        instance->codec = subghz_raw_codec_alloc(instance->encoding);
+        if(!subghz_raw_codec_write_start(instance->codec, instance->flipper_file)) {
+            FURI_LOG_E(TAG, "Unable to add RAW_Encoding");
+            subghz_raw_codec_free(instance->codec);
+            instance->codec = NULL;
+            break;
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -174,8 +194,11 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        if(!subghz_raw_codec_write(
+               instance->codec,
+               instance->flipper_file,
+               instance->upload_raw,
+               instance->ind_write)) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -194,6 +217,8 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
+        subghz_raw_codec_free(instance->codec);
+        instance->codec = NULL;
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
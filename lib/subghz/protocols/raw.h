@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include "../subghz_raw_codec.h"
 
 #define SUBGHZ_PROTOCOL_RAW_NAME "RAW"
 
@@ -17,6 +18,15 @@ extern const SubGhzProtocolDecoder subghz_protocol_raw_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_raw_encoder;
 extern const SubGhzProtocol subghz_protocol_raw;
 
+/**
+ * Set the encoding of RAW data for the next file opened for writing, text by default
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param encoding SubGhzRawEncoding
+ */
+void subghz_protocol_raw_save_to_file_set_encoding(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawEncoding encoding);
+
 /**
  * Open file for writing
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -3,38 +3,124 @@
 #include "registry.h"
 
 #include <m-array.h>
+#include <stdatomic.h>
+
+#define TAG "SubGhzReceiver"
 
 typedef struct {
-    SubGhzProtocolEncoderBase* base;
+    const SubGhzProtocol* protocol;
+    SubGhzProtocolDecoderBase* base;
+    size_t memory;
+    bool pinned;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 #define M_OPL_SubGhzReceiverSlotArray_t() ARRAY_OPLIST(SubGhzReceiverSlotArray, M_POD_OPLIST)
 
+typedef struct {
+    const SubGhzProtocolDecoder* decoder;
+    SubGhzProtocolDecoderBase* base;
+} SubGhzReceiverActiveDecoder;
+
+// Immutable once published, replaced as a whole on filter change
+typedef struct {
+    size_t count;
+    SubGhzReceiverActiveDecoder decoders[];
+} SubGhzReceiverActiveSet;
+
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
+    SubGhzEnvironment* environment;
+    // Guards slots against concurrent filter changes and searches, decode does not take it
+    FuriMutex* mutex;
+
+    // Decoders fed by subghz_receiver_decode
+    _Atomic(SubGhzReceiverActiveSet*) active;
+    // Number of subghz_receiver_decode calls in progress
+    atomic_uint feeders;
 
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    SubGhzReceiver* instance = context;
+    if(instance->callback) {
+        instance->callback(instance, decoder_base, instance->context);
+    }
+}
+
+static void subghz_receiver_slot_alloc(SubGhzReceiver* instance, SubGhzReceiverSlot* slot) {
+    // Count only this thread's allocations, threads started with heap trace are already traced
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    bool heap_trace = memmgr_heap_get_thread_alloc_count(thread_id) == MEMMGR_HEAP_UNKNOWN;
+    if(heap_trace) memmgr_heap_enable_thread_trace(thread_id);
+    size_t memory_before = memmgr_heap_get_thread_memory(thread_id);
+
+    slot->base = slot->protocol->decoder->alloc(instance->environment);
+
+    size_t memory_after = memmgr_heap_get_thread_memory(thread_id);
+    if(heap_trace) memmgr_heap_disable_thread_trace(thread_id);
+    slot->memory = (memory_after > memory_before) ? memory_after - memory_before : 0;
+
+    subghz_protocol_decoder_base_set_decoder_callback(
+        slot->base, subghz_receiver_rx_callback, instance);
+
+    FURI_LOG_D(TAG, "Decoder %s: %zu bytes", slot->protocol->name, slot->memory);
+}
+
+static SubGhzReceiverActiveSet* subghz_receiver_active_set_alloc(SubGhzReceiver* instance) {
+    size_t count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(slot->base && (slot->protocol->flag & instance->filter) != 0) count++;
+        }
+
+    SubGhzReceiverActiveSet* active =
+        malloc(sizeof(SubGhzReceiverActiveSet) + count * sizeof(SubGhzReceiverActiveDecoder));
+    active->count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(slot->base && (slot->protocol->flag & instance->filter) != 0) {
+                active->decoders[active->count].decoder = slot->protocol->decoder;
+                active->decoders[active->count].base = slot->base;
+                active->count++;
+            }
+        }
+
+    return active;
+}
+
+static void subghz_receiver_slot_free(SubGhzReceiverSlot* slot) {
+    slot->protocol->decoder->free(slot->base);
+    slot->base = NULL;
+    slot->memory = 0;
+    slot->pinned = false;
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
+    instance->environment = environment;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     const SubGhzProtocolRegistry* protocol_registry_items =
         subghz_environment_get_protocol_registry(environment);
 
+    // Decoders are allocated when the filter or a search by name asks for them
     for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry_items); ++i) {
         const SubGhzProtocol* protocol =
             subghz_protocol_registry_get_by_index(protocol_registry_items, i);
 
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
-            slot->base = protocol->decoder->alloc(environment);
+            slot->protocol = protocol;
         }
     }
 
+    atomic_init(&instance->active, subghz_receiver_active_set_alloc(instance));
+    atomic_init(&instance->feeders, 0);
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -49,11 +135,14 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
     // Release allocated slots
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            slot->base->protocol->decoder->free(slot->base);
-            slot->base = NULL;
+            if(slot->base) {
+                subghz_receiver_slot_free(slot);
+            }
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    free(atomic_load(&instance->active));
 
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
@@ -61,29 +150,27 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_check(instance);
     furi_check(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
-        }
+    // Register before loading the set, so a filter change keeps the old set until we are done
+    atomic_fetch_add(&instance->feeders, 1);
+    SubGhzReceiverActiveSet* active = atomic_load(&instance->active);
+    for(size_t i = 0; i < active->count; i++) {
+        active->decoders[i].decoder->feed(active->decoders[i].base, level, duration);
+    }
+    atomic_fetch_sub(&instance->feeders, 1);
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
     furi_check(instance);
     furi_check(instance->slots);
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            slot->base->protocol->decoder->reset(slot->base);
+            if(slot->base) {
+                slot->protocol->decoder->reset(slot->base);
+            }
         }
-}
-
-static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
-    SubGhzReceiver* instance = context;
-    if(instance->callback) {
-        instance->callback(instance, decoder_base, instance->context);
-    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
 }
 
 void subghz_receiver_set_rx_callback(
@@ -92,19 +179,50 @@ void subghz_receiver_set_rx_callback(
     void* context) {
     furi_check(instance);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            subghz_protocol_decoder_base_set_decoder_callback(
-                (SubGhzProtocolDecoderBase*)slot->base, subghz_receiver_rx_callback, instance);
-        }
-
+    // Decoders are bound to subghz_receiver_rx_callback once allocated
     instance->callback = callback;
     instance->context = context;
 }
 
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_check(instance);
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     instance->filter = filter;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if((slot->protocol->flag & filter) != 0 && !slot->base) {
+                subghz_receiver_slot_alloc(instance, slot);
+            }
+        }
+
+    // Publish the new set, then wait for feeders that may still hold the old one
+    SubGhzReceiverActiveSet* active = subghz_receiver_active_set_alloc(instance);
+    SubGhzReceiverActiveSet* retired = atomic_exchange(&instance->active, active);
+    while(atomic_load(&instance->feeders) != 0) {
+        furi_delay_tick(1);
+    }
+    free(retired);
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if((slot->protocol->flag & filter) == 0 && slot->base && !slot->pinned) {
+                subghz_receiver_slot_free(slot);
+            }
+        }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+}
+
+static SubGhzReceiverSlot*
+    subghz_receiver_find_slot(SubGhzReceiver* instance, const char* decoder_name) {
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(strcmp(slot->protocol->name, decoder_name) == 0) {
+                return slot;
+            }
+        }
+    return NULL;
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -114,12 +232,48 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
 
     SubGhzProtocolDecoderBase* result = NULL;
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzReceiverSlot* slot = subghz_receiver_find_slot(instance, decoder_name);
+    if(slot) {
+        if(!slot->base) {
+            subghz_receiver_slot_alloc(instance, slot);
+        }
+        // Caller may keep the pointer, so filter changes must not free it
+        slot->pinned = true;
+        result = slot->base;
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return result;
+}
+
+size_t subghz_receiver_get_decoder_memory(SubGhzReceiver* instance, const char* decoder_name) {
+    furi_check(instance);
+    furi_check(decoder_name);
+
+    size_t memory = 0;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzReceiverSlot* slot = subghz_receiver_find_slot(instance, decoder_name);
+    if(slot) {
+        memory = slot->memory;
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return memory;
+}
+
+size_t subghz_receiver_get_memory(SubGhzReceiver* instance) {
+    furi_check(instance);
+
+    size_t memory = 0;
+
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
-                result = (SubGhzProtocolDecoderBase*)slot->base;
-                break;
-            }
+            memory += slot->memory;
         }
-    return result;
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
+
+    return memory;
 }
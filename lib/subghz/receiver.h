@@ -54,6 +54,10 @@ void subghz_receiver_set_rx_callback(
 
 /**
  * Set the filter of receivers that will work at the moment.
+ * Decoders matching the filter are allocated, the others are freed unless
+ * they were returned by subghz_receiver_search_decoder_base_by_name.
+ * Waits for subghz_receiver_decode calls in progress before freeing decoders,
+ * so it must not be called from the receiver callback.
  * @param instance Pointer to a SubGhzReceiver instance
  * @param filter Filter, SubGhzProtocolFlag
  */
@@ -61,6 +65,7 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
 
 /**
  * Search for a cattery by his name.
+ * Decoder is allocated if needed and kept until the receiver is freed.
  * @param instance Pointer to a SubGhzReceiver instance
  * @param decoder_name Receiver name
  * @return SubGhzProtocolDecoderBase* pointer to a SubGhzProtocolDecoderBase instance
@@ -68,6 +73,21 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
 SubGhzProtocolDecoderBase*
     subghz_receiver_search_decoder_base_by_name(SubGhzReceiver* instance, const char* decoder_name);
 
+/**
+ * Get heap memory taken by a decoder.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param decoder_name Receiver name
+ * @return size_t bytes taken by the decoder, 0 if it is not allocated
+ */
+size_t subghz_receiver_get_decoder_memory(SubGhzReceiver* instance, const char* decoder_name);
+
+/**
+ * Get heap memory taken by all allocated decoders.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return size_t bytes taken by the decoders
+ */
+size_t subghz_receiver_get_memory(SubGhzReceiver* instance);
+
 #ifdef __cplusplus
 }
 #endif
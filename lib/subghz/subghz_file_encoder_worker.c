@@ -4,11 +4,11 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
-#include <lib/toolbox/strint.h>
+#include "subghz_raw_codec.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_LOAD SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -16,6 +16,8 @@ struct SubGhzFileEncoderWorker {
 
     Storage* storage;
     FlipperFormat* flipper_format;
+    SubGhzRawCodec* codec;
+    int32_t* samples;
 
     volatile bool worker_running;
     volatile bool worker_stoping;
@@ -45,28 +47,25 @@ void subghz_file_encoder_worker_add_level_duration(
     if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for the key in the line
-    char* str = strstr(strStart, "RAW_Data: ");
-    bool res = false;
-
-    if(str) {
-        // Skip key
-        str = strchr(str, ' ');
-
-        // Parse next element
-        int32_t duration;
-        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            subghz_file_encoder_worker_add_level_duration(instance, duration);
-            if(*str == ',') str++; // could also be `\0`
-        }
-
-        res = true;
+/** Blocks until all durations are in the stream, the stream is refilled as soon as it has room
+ * 
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param samples Durations
+ * @param count Number of durations
+ */
+static void subghz_file_encoder_worker_add_samples(
+    SubGhzFileEncoderWorker* instance,
+    const int32_t* samples,
+    size_t count) {
+    const uint8_t* data = (const uint8_t*)samples;
+    size_t size = count * sizeof(int32_t);
+
+    while(size && instance->worker_running) {
+        // Stream only ever holds whole durations, so partial sends are whole durations too
+        size_t ret = furi_stream_buffer_send(instance->stream, data, size, 100);
+        data += ret;
+        size -= ret;
     }
-
-    return res;
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
@@ -102,7 +101,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
     instance->is_storage_slow = false;
-    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
@@ -116,31 +114,27 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
+        if(!subghz_raw_codec_read_start(instance->codec, instance->flipper_format)) {
+            FURI_LOG_E(TAG, "Unsupported RAW data");
+            break;
+        }
 
-        //skip the end of the previous line "\n"
-        stream_seek(stream, 1, StreamOffsetFromCurrent);
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
     while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
-            }
-        } else {
-            furi_delay_ms(1);
+        size_t count = subghz_raw_codec_read(
+            instance->codec,
+            instance->flipper_format,
+            instance->samples,
+            SUBGHZ_FILE_ENCODER_LOAD);
+        if(!count) {
+            subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+            break;
         }
+        subghz_file_encoder_worker_add_samples(instance, instance->samples, count);
     }
     //waiting for the end of the transfer
     if(instance->is_storage_slow) {
@@ -175,6 +169,8 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->codec = subghz_raw_codec_alloc(SubGhzRawEncodingText);
+    instance->samples = malloc(SUBGHZ_FILE_ENCODER_LOAD * sizeof(int32_t));
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -192,6 +188,8 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
 
+    free(instance->samples);
+    subghz_raw_codec_free(instance->codec);
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
 
@@ -484,19 +484,17 @@ bool subghz_keystore_raw_encrypted_save(
     return encrypted;
 }
 
-bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
+/**
+ * Open RAW keystore file and check its header, the stream is left at the encrypted data.
+ * IV is read only when `iv` is not NULL.
+ */
+static bool
+    subghz_keystore_raw_open(FlipperFormat* flipper_format, const char* file_name, uint8_t* iv) {
     bool result = false;
-    uint8_t iv[16];
     uint32_t version;
     uint32_t encryption;
+    FuriString* str_temp = furi_string_alloc();
 
-    FuriString* str_temp;
-    str_temp = furi_string_alloc();
-
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    char* decrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-
-    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
     do {
         if(!flipper_format_file_open_existing(flipper_format, file_name)) {
             FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
@@ -517,13 +515,12 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
             break;
         }
 
-        Stream* stream = flipper_format_get_raw_stream(flipper_format);
         if(encryption != SubGhzKeystoreEncryptionAES256) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
 
-        if(offset < 16) {
+        if(iv) {
             if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
                 FURI_LOG_E(TAG, "Missing IV");
                 break;
@@ -536,19 +533,78 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
             break;
         }
 
-        size_t bufer_size;
-        if(len <= (16 - offset % 16)) {
-            bufer_size = 32;
-        } else {
-            bufer_size = (((len) / 16) + 2) * 32;
+        //skip the end of the previous line "\n"
+        uint8_t newline;
+        stream_read(flipper_format_get_raw_stream(flipper_format), &newline, 1);
+
+        result = true;
+    } while(0);
+
+    furi_string_free(str_temp);
+
+    return result;
+}
+
+/**
+ * Read `size` bytes of hex encoded data
+ */
+static bool subghz_keystore_raw_read_hex(Stream* stream, uint8_t* data, size_t size) {
+    uint8_t buffer[32];
+
+    for(size_t offset = 0; offset < size; offset += sizeof(buffer) / 2) {
+        size_t read_size = MIN(sizeof(buffer), (size - offset) * 2);
+        if(stream_read(stream, buffer, read_size) != read_size) return false;
+
+        for(size_t i = 0; i < read_size; i += 2) {
+            uint8_t hi_nibble = 0;
+            uint8_t lo_nibble = 0;
+            hex_char_to_hex_nibble(buffer[i], &hi_nibble);
+            hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
+            data[offset + i / 2] = (hi_nibble << 4) | lo_nibble;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Decrypt whole AES blocks in place, in one CBC pass from `iv`
+ */
+static bool subghz_keystore_raw_decrypt(const uint8_t* iv, uint8_t* data, size_t size) {
+    if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+        FURI_LOG_E(TAG, "Unable to load encryption key");
+        return false;
+    }
+
+    bool result = furi_hal_crypto_decrypt(data, data, size);
+    if(!result) {
+        FURI_LOG_E(TAG, "Decryption failed");
+    }
+
+    furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    return result;
+}
+
+bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
+    bool result = false;
+    uint8_t iv[16];
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    do {
+        // Data past the first block is chained from the previous block instead of the IV
+        if(!subghz_keystore_raw_open(flipper_format, file_name, (offset < 16) ? iv : NULL)) {
+            break;
         }
-        furi_assert(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE >= bufer_size / 2);
+
+        // AES blocks holding the requested bytes
+        size_t bufer_size = ((offset % 16 + len + 15) / 16) * 16;
+        furi_assert(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE >= bufer_size);
 
         uint8_t buffer[bufer_size];
-        size_t ret = 0;
-        bool decrypted = true;
-        //skip the end of the previous line "\n"
-        stream_read(stream, buffer, 1);
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
 
         size_t size = stream_size(stream);
         size -= stream_tell(stream);
@@ -559,55 +615,65 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
 
         if(offset >= 16) {
             stream_seek(stream, ((offset / 16) - 1) * 32, StreamOffsetFromCurrent);
-            ret = stream_read(stream, buffer, 32);
-            furi_assert(ret == 32);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                iv[i / 2] = (hi_nibble << 4) | lo_nibble;
+            if(!subghz_keystore_raw_read_hex(stream, iv, 16)) {
+                FURI_LOG_E(TAG, "Unable to read Encrypt_data");
+                break;
             }
         }
 
-        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
-            FURI_LOG_E(TAG, "Unable to load encryption key");
+        memset(buffer, 0, bufer_size);
+        if(!subghz_keystore_raw_read_hex(stream, buffer, bufer_size)) {
+            FURI_LOG_E(TAG, "Unable to read Encrypt_data");
             break;
         }
+        if(!subghz_keystore_raw_decrypt(iv, buffer, bufer_size)) break;
 
-        do {
-            memset(buffer, 0, bufer_size);
-            ret = stream_read(stream, buffer, bufer_size);
-            furi_assert(ret == bufer_size);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                buffer[i / 2] = (hi_nibble << 4) | lo_nibble;
-            }
+        memcpy(data, buffer + (offset - (offset / 16) * 16), len);
+        result = true;
+    } while(0);
+    flipper_format_free(flipper_format);
 
-            memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+    furi_record_close(RECORD_STORAGE);
 
-            if(!furi_hal_crypto_decrypt(
-                   (uint8_t*)buffer, (uint8_t*)decrypted_line, bufer_size / 2)) {
-                decrypted = false;
-                FURI_LOG_E(TAG, "Decryption failed");
-                break;
-            }
-            memcpy(data, (uint8_t*)decrypted_line + (offset - (offset / 16) * 16), len);
+    return result;
+}
 
-        } while(0);
-        furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
-        if(decrypted) result = true;
+bool subghz_keystore_raw_load(const char* file_name, uint8_t* data, size_t* size) {
+    furi_check(file_name);
+    furi_check(data);
+    furi_check(size);
+
+    bool result = false;
+    uint8_t iv[16];
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    do {
+        if(!subghz_keystore_raw_open(flipper_format, file_name, iv)) break;
+
+        // Whole AES blocks only, same as the data written by subghz_keystore_raw_encrypted_save
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        size_t data_size = ((stream_size(stream) - stream_tell(stream)) / 32) * 16;
+        if(data_size == 0 || data_size > *size) {
+            FURI_LOG_E(TAG, "Data size %zu doesn't fit %zu", data_size, *size);
+            break;
+        }
+
+        if(!subghz_keystore_raw_read_hex(stream, data, data_size)) {
+            FURI_LOG_E(TAG, "Unable to read Encrypt_data");
+            break;
+        }
+
+        // One CBC pass over the whole data
+        if(subghz_keystore_raw_decrypt(iv, data, data_size)) {
+            *size = data_size;
+            result = true;
+        }
     } while(0);
     flipper_format_free(flipper_format);
 
     furi_record_close(RECORD_STORAGE);
 
-    free(decrypted_line);
-
-    furi_string_free(str_temp);
-
     return result;
 }
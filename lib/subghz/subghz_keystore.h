@@ -75,6 +75,15 @@ bool subghz_keystore_raw_encrypted_save(
  */
 bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len);
 
+/** 
+ * Decrypt the whole RAW data of the file
+ * @param file_name Full path to the input file
+ * @param data Returned array
+ * @param size Capacity of the array on input, decrypted data length on output
+ * @return true On success, false if the file is broken or its data does not fit the array
+ */
+bool subghz_keystore_raw_load(const char* file_name, uint8_t* data, size_t* size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,370 @@
+#include "subghz_raw_codec.h"
+#include "types.h"
+
+#include <furi.h>
+#include <flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
+#include <toolbox/compress.h>
+#include <toolbox/strint.h>
+#include <toolbox/varint.h>
+
+#define TAG "SubGhzRawCodec"
+
+#define SUBGHZ_RAW_CODEC_ENCODING_KEY "RAW_Encoding"
+#define SUBGHZ_RAW_CODEC_DATA_KEY     "RAW_Data"
+
+#define SUBGHZ_RAW_CODEC_VARINT_SIZE_MAX (SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * 5)
+// Heatshrink output of incompressible data is one byte longer than the input
+#define SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX (SUBGHZ_RAW_CODEC_VARINT_SIZE_MAX + 1)
+
+struct SubGhzRawCodec {
+    SubGhzRawEncoding encoding;
+    bool read_error;
+
+    // Text reading
+    FuriString* line;
+    size_t line_cursor;
+
+    // Binary reading and writing
+    uint8_t* varint;
+    uint8_t* payload;
+    Compress* compress;
+};
+
+static const char* const subghz_raw_codec_encoding_names[] = {
+    [SubGhzRawEncodingVarint] = "Varint",
+    [SubGhzRawEncodingHeatshrink] = "Heatshrink",
+};
+
+static void subghz_raw_codec_set_encoding(SubGhzRawCodec* instance, SubGhzRawEncoding encoding) {
+    instance->encoding = encoding;
+
+    if(encoding != SubGhzRawEncodingText && !instance->varint) {
+        instance->varint = malloc(SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX);
+        instance->payload = malloc(SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX);
+    }
+    if(encoding == SubGhzRawEncodingHeatshrink && !instance->compress) {
+        instance->compress =
+            compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    }
+}
+
+SubGhzRawCodec* subghz_raw_codec_alloc(SubGhzRawEncoding encoding) {
+    SubGhzRawCodec* instance = malloc(sizeof(SubGhzRawCodec));
+    instance->line = furi_string_alloc();
+    subghz_raw_codec_set_encoding(instance, encoding);
+
+    return instance;
+}
+
+void subghz_raw_codec_free(SubGhzRawCodec* instance) {
+    furi_check(instance);
+
+    if(instance->compress) compress_free(instance->compress);
+    free(instance->payload);
+    free(instance->varint);
+    furi_string_free(instance->line);
+    free(instance);
+}
+
+SubGhzRawEncoding subghz_raw_codec_get_encoding(SubGhzRawCodec* instance) {
+    furi_check(instance);
+
+    return instance->encoding;
+}
+
+uint32_t subghz_raw_codec_get_file_version(SubGhzRawEncoding encoding) {
+    return (encoding == SubGhzRawEncodingText) ? SUBGHZ_RAW_FILE_VERSION :
+                                                 SUBGHZ_RAW_FILE_VERSION_BINARY;
+}
+
+bool subghz_raw_codec_write_start(SubGhzRawCodec* instance, FlipperFormat* flipper_format) {
+    furi_check(instance);
+    furi_check(flipper_format);
+
+    if(instance->encoding == SubGhzRawEncodingText) return true;
+
+    return flipper_format_write_string_cstr(
+        flipper_format,
+        SUBGHZ_RAW_CODEC_ENCODING_KEY,
+        subghz_raw_codec_encoding_names[instance->encoding]);
+}
+
+bool subghz_raw_codec_write(
+    SubGhzRawCodec* instance,
+    FlipperFormat* flipper_format,
+    const int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(flipper_format);
+    furi_check(samples);
+    furi_check(count <= SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+
+    if(!count) return true;
+
+    if(instance->encoding == SubGhzRawEncodingText) {
+        return flipper_format_write_int32(
+            flipper_format, SUBGHZ_RAW_CODEC_DATA_KEY, samples, count);
+    }
+
+    size_t varint_size = 0;
+    for(size_t i = 0; i < count; i++) {
+        varint_size += varint_int32_pack(samples[i], &instance->varint[varint_size]);
+    }
+
+    const uint8_t* payload = instance->varint;
+    size_t payload_size = varint_size;
+    if(instance->encoding == SubGhzRawEncodingHeatshrink) {
+        if(!compress_encode(
+               instance->compress,
+               instance->varint,
+               varint_size,
+               instance->payload,
+               SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX,
+               &payload_size)) {
+            FURI_LOG_E(TAG, "Compression failed");
+            return false;
+        }
+        payload = instance->payload;
+    }
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    const uint8_t header[] = {payload_size & 0xFF, payload_size >> 8};
+
+    return stream_write(stream, header, sizeof(header)) == sizeof(header) &&
+           stream_write(stream, payload, payload_size) == payload_size;
+}
+
+bool subghz_raw_codec_read_start(SubGhzRawCodec* instance, FlipperFormat* flipper_format) {
+    furi_check(instance);
+    furi_check(flipper_format);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    instance->line_cursor = 0;
+    instance->read_error = false;
+
+    // Rest of the "Protocol" line
+    stream_read_line(stream, instance->line);
+
+    size_t position = stream_tell(stream);
+    if(stream_read_line(stream, instance->line)) {
+        furi_string_trim(instance->line);
+        if(furi_string_start_with_str(instance->line, SUBGHZ_RAW_CODEC_ENCODING_KEY ":")) {
+            furi_string_right(instance->line, strlen(SUBGHZ_RAW_CODEC_ENCODING_KEY ":"));
+            furi_string_trim(instance->line);
+
+            for(size_t i = 0; i < COUNT_OF(subghz_raw_codec_encoding_names); i++) {
+                const char* name = subghz_raw_codec_encoding_names[i];
+                if(name && furi_string_equal_str(instance->line, name)) {
+                    subghz_raw_codec_set_encoding(instance, i);
+                    return true;
+                }
+            }
+
+            FURI_LOG_E(TAG, "Unknown encoding %s", furi_string_get_cstr(instance->line));
+            return false;
+        }
+    }
+
+    subghz_raw_codec_set_encoding(instance, SubGhzRawEncodingText);
+    return stream_seek(stream, position, StreamOffsetFromStart);
+}
+
+static size_t subghz_raw_codec_read_text(
+    SubGhzRawCodec* instance,
+    Stream* stream,
+    int32_t* samples,
+    size_t capacity) {
+    // Line sample: "RAW_Data: -1, 2, -2..."
+    size_t count = 0;
+
+    while(!count) {
+        if(!instance->line_cursor) {
+            if(!stream_read_line(stream, instance->line)) break;
+            furi_string_trim(instance->line);
+            if(!furi_string_start_with_str(instance->line, SUBGHZ_RAW_CODEC_DATA_KEY ":")) break;
+            instance->line_cursor = strlen(SUBGHZ_RAW_CODEC_DATA_KEY ":");
+        }
+
+        const char* line = furi_string_get_cstr(instance->line);
+        char* str = (char*)&line[instance->line_cursor];
+        int32_t duration;
+        while(count < capacity &&
+              strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+            samples[count++] = duration;
+            if(*str == ',') str++; // could also be `\0`
+        }
+
+        // Lines longer than the capacity are continued by the next call
+        instance->line_cursor = (count < capacity) ? 0 : (size_t)(str - line);
+    }
+
+    return count;
+}
+
+static size_t subghz_raw_codec_read_binary(
+    SubGhzRawCodec* instance,
+    Stream* stream,
+    int32_t* samples,
+    size_t capacity) {
+    uint8_t header[2];
+    if(stream_read(stream, header, sizeof(header)) != sizeof(header)) return 0;
+
+    size_t payload_size = header[0] | (header[1] << 8);
+    if(!payload_size || payload_size > SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX) {
+        FURI_LOG_E(TAG, "Invalid block size %zu", payload_size);
+        instance->read_error = true;
+        return 0;
+    }
+    if(stream_read(stream, instance->payload, payload_size) != payload_size) {
+        FURI_LOG_E(TAG, "Truncated block");
+        instance->read_error = true;
+        return 0;
+    }
+
+    const uint8_t* varint = instance->payload;
+    size_t varint_size = payload_size;
+    if(instance->encoding == SubGhzRawEncodingHeatshrink) {
+        // compress_decode trusts the header, which comes from the file here
+        const CompressHeader* compress_header = (const CompressHeader*)instance->payload;
+        if(compress_header->is_compressed &&
+           (payload_size < sizeof(CompressHeader) ||
+            sizeof(CompressHeader) + compress_header->compressed_buff_size != payload_size)) {
+            FURI_LOG_E(TAG, "Invalid compressed block header");
+            instance->read_error = true;
+            return 0;
+        }
+        if(!compress_decode(
+               instance->compress,
+               instance->payload,
+               payload_size,
+               instance->varint,
+               SUBGHZ_RAW_CODEC_PAYLOAD_SIZE_MAX,
+               &varint_size)) {
+            FURI_LOG_E(TAG, "Decompression failed");
+            instance->read_error = true;
+            return 0;
+        }
+        varint = instance->varint;
+    }
+
+    size_t count = 0;
+    size_t offset = 0;
+    while(offset < varint_size && count < capacity) {
+        offset += varint_int32_unpack(&samples[count], &varint[offset], varint_size - offset);
+        count++;
+    }
+    if(offset != varint_size) {
+        FURI_LOG_E(TAG, "Corrupted block");
+        instance->read_error = true;
+        return 0;
+    }
+
+    return count;
+}
+
+size_t subghz_raw_codec_read(
+    SubGhzRawCodec* instance,
+    FlipperFormat* flipper_format,
+    int32_t* samples,
+    size_t capacity) {
+    furi_check(instance);
+    furi_check(flipper_format);
+    furi_check(samples);
+    furi_check(capacity >= SUBGHZ_RAW_CODEC_BLOCK_SAMPLES);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    if(instance->encoding == SubGhzRawEncodingText) {
+        return subghz_raw_codec_read_text(instance, stream, samples, capacity);
+    } else {
+        return subghz_raw_codec_read_binary(instance, stream, samples, capacity);
+    }
+}
+
+bool subghz_raw_codec_convert(
+    const char* source_file_name,
+    const char* destination_file_name,
+    SubGhzRawEncoding encoding) {
+    furi_check(source_file_name);
+    furi_check(destination_file_name);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* source = flipper_format_file_alloc(storage);
+    FlipperFormat* destination = flipper_format_file_alloc(storage);
+    SubGhzRawCodec* reader = subghz_raw_codec_alloc(SubGhzRawEncodingText);
+    SubGhzRawCodec* writer = subghz_raw_codec_alloc(encoding);
+    int32_t* samples = malloc(SUBGHZ_RAW_CODEC_BLOCK_SAMPLES * sizeof(int32_t));
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version = 0;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(source, source_file_name)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", source_file_name);
+            break;
+        }
+        if(!flipper_format_read_header(source, temp_str, &version)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
+        if(strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           (version != SUBGHZ_RAW_FILE_VERSION && version != SUBGHZ_RAW_FILE_VERSION_BINARY)) {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
+
+        // Version depends on the encoding, the rest of the header is copied up to "Protocol" value
+        Stream* source_stream = flipper_format_get_raw_stream(source);
+        stream_read_line(source_stream, temp_str);
+        size_t header_start = stream_tell(source_stream);
+        if(!flipper_format_read_string(source, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+        size_t header_size = stream_tell(source_stream) - header_start;
+
+        if(!flipper_format_file_open_always(destination, destination_file_name)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", destination_file_name);
+            break;
+        }
+        if(!flipper_format_write_header_cstr(
+               destination, SUBGHZ_RAW_FILE_TYPE, subghz_raw_codec_get_file_version(encoding))) {
+            FURI_LOG_E(TAG, "Unable to add header");
+            break;
+        }
+        Stream* destination_stream = flipper_format_get_raw_stream(destination);
+        if(!stream_seek(source_stream, header_start, StreamOffsetFromStart) ||
+           stream_copy(source_stream, destination_stream, header_size) != header_size ||
+           !stream_write_char(destination_stream, '\n')) {
+            FURI_LOG_E(TAG, "Unable to copy header");
+            break;
+        }
+
+        if(!subghz_raw_codec_read_start(reader, source) ||
+           !subghz_raw_codec_write_start(writer, destination)) {
+            break;
+        }
+
+        bool write_error = false;
+        size_t count;
+        while((count = subghz_raw_codec_read(
+                   reader, source, samples, SUBGHZ_RAW_CODEC_BLOCK_SAMPLES)) > 0) {
+            if(!subghz_raw_codec_write(writer, destination, samples, count)) {
+                FURI_LOG_E(TAG, "Unable to write RAW data");
+                write_error = true;
+                break;
+            }
+        }
+        result = !write_error && !reader->read_error;
+    } while(false);
+
+    furi_string_free(temp_str);
+    free(samples);
+    subghz_raw_codec_free(writer);
+    subghz_raw_codec_free(reader);
+    flipper_format_free(destination);
+    flipper_format_free(source);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <flipper_format/flipper_format.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Most durations in one block of a binary RAW file, same as one RAW_Data line of a recording */
+#define SUBGHZ_RAW_CODEC_BLOCK_SAMPLES (512U)
+
+/**
+ * Storage form of the RAW durations.
+ *
+ * Binary forms keep the text header of the RAW file and add a "RAW_Encoding" key right after
+ * "Protocol". Everything after that line is a sequence of blocks, each block is a little-endian
+ * uint16 payload size followed by the payload: up to SUBGHZ_RAW_CODEC_BLOCK_SAMPLES durations
+ * as zigzag varints, compressed as a whole with heatshrink for SubGhzRawEncodingHeatshrink.
+ */
+typedef enum {
+    SubGhzRawEncodingText, /**< Decimal "RAW_Data" lines */
+    SubGhzRawEncodingVarint, /**< Blocks of zigzag varints */
+    SubGhzRawEncodingHeatshrink, /**< Blocks of zigzag varints compressed with heatshrink */
+} SubGhzRawEncoding;
+
+typedef struct SubGhzRawCodec SubGhzRawCodec;
+
+/**
+ * Allocate SubGhzRawCodec.
+ * @param encoding Encoding used for writing, reading detects it from the file
+ * @return SubGhzRawCodec* pointer to a SubGhzRawCodec instance
+ */
+SubGhzRawCodec* subghz_raw_codec_alloc(SubGhzRawEncoding encoding);
+
+/**
+ * Free SubGhzRawCodec.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ */
+void subghz_raw_codec_free(SubGhzRawCodec* instance);
+
+/**
+ * Get current encoding.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ * @return SubGhzRawEncoding
+ */
+SubGhzRawEncoding subghz_raw_codec_get_encoding(SubGhzRawCodec* instance);
+
+/**
+ * Get version of the RAW file header for the encoding.
+ * Binary files get their own version, so firmware without the codec rejects them.
+ * @param encoding Encoding of the file
+ * @return SUBGHZ_RAW_FILE_VERSION or SUBGHZ_RAW_FILE_VERSION_BINARY
+ */
+uint32_t subghz_raw_codec_get_file_version(SubGhzRawEncoding encoding);
+
+/**
+ * Start writing durations, call right after the "Protocol" key is written.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @return true On success
+ */
+bool subghz_raw_codec_write_start(SubGhzRawCodec* instance, FlipperFormat* flipper_format);
+
+/**
+ * Write durations, positive for high level and negative for low level.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param samples Durations
+ * @param count Number of durations, up to SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
+ * @return true On success
+ */
+bool subghz_raw_codec_write(
+    SubGhzRawCodec* instance,
+    FlipperFormat* flipper_format,
+    const int32_t* samples,
+    size_t count);
+
+/**
+ * Start reading durations, call right after the "Protocol" key is read.
+ * Detects the encoding of the file.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @return true On success
+ */
+bool subghz_raw_codec_read_start(SubGhzRawCodec* instance, FlipperFormat* flipper_format);
+
+/**
+ * Read next durations.
+ * @param instance Pointer to a SubGhzRawCodec instance
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param samples Returned durations
+ * @param capacity Size of the samples array, at least SUBGHZ_RAW_CODEC_BLOCK_SAMPLES
+ * @return Number of durations read, 0 at the end of data or on error
+ */
+size_t subghz_raw_codec_read(
+    SubGhzRawCodec* instance,
+    FlipperFormat* flipper_format,
+    int32_t* samples,
+    size_t capacity);
+
+/**
+ * Convert RAW file to another encoding.
+ * The header is copied as is, except for the version that follows the destination encoding.
+ * @param source_file_name Full path to the source RAW file
+ * @param destination_file_name Full path to the destination file
+ * @param encoding Encoding of the destination file
+ * @return true On success
+ */
+bool subghz_raw_codec_convert(
+    const char* source_file_name,
+    const char* destination_file_name,
+    SubGhzRawEncoding encoding);
+
+#ifdef __cplusplus
+}
+#endif
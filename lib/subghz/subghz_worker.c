@@ -1,12 +1,18 @@
 #include "subghz_worker.h"
 
 #include <furi.h>
+#include <toolbox/spsc_ring.h>
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_RING_SIZE  (4096U)
+#define SUBGHZ_WORKER_WATERMARK  (256U)
+#define SUBGHZ_WORKER_BATCH_SIZE (32U)
+#define SUBGHZ_WORKER_EVENT_DATA (1U << 0)
+
 struct SubGhzWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    SpscRing* ring;
 
     volatile bool running;
     volatile bool overrun;
@@ -33,9 +39,7 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(!spsc_ring_push(instance->ring, &level_duration)) instance->overrun = true;
 }
 
 /** Worker callback thread
@@ -46,31 +50,36 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    LevelDuration batch[SUBGHZ_WORKER_BATCH_SIZE];
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
+        // Woken up by the watermark, timeout keeps latency low on slow signals
+        furi_thread_flags_wait(SUBGHZ_WORKER_EVENT_DATA, FuriFlagWaitAny, 10);
+
+        size_t count;
+        while((count = spsc_ring_pop(instance->ring, batch, SUBGHZ_WORKER_BATCH_SIZE))) {
+            for(size_t i = 0; i < count; i++) {
+                LevelDuration level_duration = batch[i];
+                if(level_duration_is_reset(level_duration)) {
+                    FURI_LOG_E(TAG, "Overrun buffer");
+                    if(instance->overrun_callback) instance->overrun_callback(instance->context);
+                } else {
+                    bool level = level_duration_get_level(level_duration);
+                    uint32_t duration = level_duration_get_duration(level_duration);
+
+                    if((duration < instance->filter_duration) ||
+                       (instance->filter_level_duration.level == level)) {
+                        instance->filter_level_duration.duration += duration;
+
+                    } else if(instance->filter_level_duration.level != level) {
+                        if(instance->pair_callback)
+                            instance->pair_callback(
+                                instance->context,
+                                instance->filter_level_duration.level,
+                                instance->filter_level_duration.duration);
+
+                        instance->filter_level_duration.duration = duration;
+                        instance->filter_level_duration.level = level;
+                    }
                 }
             }
         }
@@ -85,8 +94,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->ring = spsc_ring_alloc(sizeof(LevelDuration), SUBGHZ_WORKER_RING_SIZE);
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -97,7 +105,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_check(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    spsc_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -126,13 +134,20 @@ void subghz_worker_start(SubGhzWorker* instance) {
 
     instance->running = true;
 
+    spsc_ring_flush(instance->ring);
     furi_thread_start(instance->thread);
+    spsc_ring_set_wakeup(
+        instance->ring,
+        furi_thread_get_id(instance->thread),
+        SUBGHZ_WORKER_EVENT_DATA,
+        SUBGHZ_WORKER_WATERMARK);
 }
 
 void subghz_worker_stop(SubGhzWorker* instance) {
     furi_check(instance);
     furi_check(instance->running);
 
+    spsc_ring_set_wakeup(instance->ring, NULL, 0, 1);
     instance->running = false;
 
     furi_thread_join(instance->thread);
@@ -30,14 +30,6 @@ static bool compress_decode_internal(
     size_t data_out_size,
     size_t* data_res_size);
 
-typedef struct {
-    uint8_t is_compressed;
-    uint8_t reserved;
-    uint16_t compressed_buff_size;
-} CompressHeader;
-
-_Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
-
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t* buffer;
@@ -340,7 +332,7 @@ static bool compress_decode_internal(
             *data_res_size = data_out_size - decompressed_context.data_size;
         }
     } else if(data_out_size >= data_in_size - 1) {
-        memcpy(data_out, &data_in[1], data_in_size);
+        memcpy(data_out, &data_in[1], data_in_size - 1);
         *data_res_size = data_in_size - 1;
         result = true;
     } else {
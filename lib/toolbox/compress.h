@@ -64,6 +64,18 @@ typedef struct {
 /** Default configuration for heatshrink compression. Used for image assets. */
 extern const CompressConfigHeatshrink compress_config_heatshrink_default;
 
+/** Header of data encoded by `compress_encode`
+ *
+ * Stored (not compressed) data only has the `is_compressed` byte in front of it.
+ */
+typedef struct {
+    uint8_t is_compressed;
+    uint8_t reserved;
+    uint16_t compressed_buff_size; /**< Size of compressed data following the header */
+} CompressHeader;
+
+_Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
+
 /** Allocate encoder and decoder
  *
  * @param      type     Compression type
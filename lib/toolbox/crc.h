@@ -0,0 +1,56 @@
+/**
+ * @file crc.h
+ * Table driven CRC calculation
+ *
+ * Functions take the current CRC register value and return the updated one,
+ * so data can be processed in chunks. Initial value and final XOR are up to
+ * the caller, as they differ between protocols using the same polynomial.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Update CRC-16 with x^16 + x^12 + x^5 + 1 polynomial, LSB first
+ *
+ * Used by ISO14443-3A/B, ISO13239 (ISO15693, Picopass), X.25.
+ *
+ * @param      crc   current CRC register value
+ * @param      data  data to process
+ * @param      size  data size in bytes
+ *
+ * @return     updated CRC register value
+ */
+uint16_t crc16_lsb_update(uint16_t crc, const void* data, size_t size);
+
+/** Update CRC-16 with x^16 + x^12 + x^5 + 1 polynomial, MSB first
+ *
+ * Used by FeliCa, XMODEM.
+ *
+ * @param      crc   current CRC register value
+ * @param      data  data to process
+ * @param      size  data size in bytes
+ *
+ * @return     updated CRC register value
+ */
+uint16_t crc16_msb_update(uint16_t crc, const void* data, size_t size);
+
+/** Update CRC-32 with IEEE 802.3 polynomial, LSB first
+ *
+ * Standard CRC-32 is crc32_update(0xFFFFFFFF, ...) ^ 0xFFFFFFFF.
+ *
+ * @param      crc   current CRC register value
+ * @param      data  data to process
+ * @param      size  data size in bytes
+ *
+ * @return     updated CRC register value
+ */
+uint32_t crc32_update(uint32_t crc, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,117 @@
+#include "spsc_ring.h"
+
+#include <string.h>
+
+struct SpscRing {
+    size_t element_size;
+    size_t mask;
+
+    // Free running indexes, head is written by the producer only, tail by the consumer only
+    size_t head;
+    size_t tail;
+    uint32_t overrun_count;
+
+    // Wakeup target, thread_id is published last and cleared first on change
+    FuriThreadId thread_id;
+    uint32_t flags;
+    size_t watermark;
+
+    uint8_t data[];
+};
+
+SpscRing* spsc_ring_alloc(size_t element_size, size_t capacity) {
+    furi_check(element_size > 0);
+    furi_check(capacity > 0);
+    furi_check((capacity & (capacity - 1)) == 0);
+
+    SpscRing* ring = malloc(sizeof(SpscRing) + element_size * capacity);
+    ring->element_size = element_size;
+    ring->mask = capacity - 1;
+    ring->watermark = 1;
+
+    return ring;
+}
+
+void spsc_ring_free(SpscRing* ring) {
+    furi_check(ring);
+    free(ring);
+}
+
+void spsc_ring_set_wakeup(
+    SpscRing* ring,
+    FuriThreadId thread_id,
+    uint32_t flags,
+    size_t watermark) {
+    furi_check(ring);
+    furi_check(watermark > 0);
+    furi_check(watermark <= ring->mask + 1);
+
+    // Producer may push meanwhile, it must never see a thread with the old flags or watermark
+    __atomic_store_n(&ring->thread_id, NULL, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ring->flags = flags;
+    ring->watermark = watermark;
+    __atomic_store_n(&ring->thread_id, thread_id, __ATOMIC_RELEASE);
+}
+
+bool spsc_ring_push(SpscRing* ring, const void* element) {
+    size_t head = ring->head;
+    size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    size_t count = head - tail;
+
+    if(count > ring->mask) {
+        ring->overrun_count++;
+        return false;
+    }
+
+    memcpy(&ring->data[(head & ring->mask) * ring->element_size], element, ring->element_size);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+    // Only the push that reaches the watermark wakes the consumer up
+    FuriThreadId thread_id = __atomic_load_n(&ring->thread_id, __ATOMIC_ACQUIRE);
+    if(thread_id && (count + 1 == ring->watermark)) {
+        furi_thread_flags_set(thread_id, ring->flags);
+    }
+
+    return true;
+}
+
+size_t spsc_ring_pop(SpscRing* ring, void* elements, size_t count) {
+    furi_check(ring);
+    furi_check(elements);
+
+    size_t tail = ring->tail;
+    size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    count = MIN(count, head - tail);
+
+    if(count) {
+        // At most two copies, up to the end of the storage and from its start
+        size_t capacity = ring->mask + 1;
+        size_t offset = tail & ring->mask;
+        size_t first = MIN(count, capacity - offset);
+        memcpy(elements, &ring->data[offset * ring->element_size], first * ring->element_size);
+        memcpy(
+            (uint8_t*)elements + first * ring->element_size,
+            ring->data,
+            (count - first) * ring->element_size);
+        __atomic_store_n(&ring->tail, tail + count, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+size_t spsc_ring_get_count(SpscRing* ring) {
+    furi_check(ring);
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - ring->tail;
+}
+
+uint32_t spsc_ring_get_overrun_count(SpscRing* ring) {
+    furi_check(ring);
+    return __atomic_load_n(&ring->overrun_count, __ATOMIC_RELAXED);
+}
+
+void spsc_ring_flush(SpscRing* ring) {
+    furi_check(ring);
+    size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&ring->tail, head, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file spsc_ring.h
+ *
+ * Lock-free ring buffer of fixed size elements with a single producer and a single consumer.
+ *
+ * Meant for passing captured samples from an interrupt handler to a worker thread: pushing an
+ * element is a copy and two index updates, without the critical sections and task notifications
+ * of FuriStreamBuffer. The consumer is woken up with thread flags once the number of pending
+ * elements reaches the watermark and takes everything that is pending in one read.
+ *
+ * The producer only ever calls spsc_ring_push(), everything else belongs to the consumer.
+ * After a wakeup the consumer must read until spsc_ring_pop() returns 0, otherwise the next
+ * wakeup will only come when the ring is drained and refilled up to the watermark.
+ */
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SpscRing SpscRing;
+
+/**
+ * @brief Allocate a SpscRing instance
+ *
+ * @param element_size size of one element in bytes
+ * @param capacity number of elements, must be a power of two
+ * @return SpscRing*
+ */
+SpscRing* spsc_ring_alloc(size_t element_size, size_t capacity);
+
+/**
+ * @brief Free a SpscRing instance
+ *
+ * @param ring
+ */
+void spsc_ring_free(SpscRing* ring);
+
+/**
+ * @brief Set consumer wakeup
+ *
+ * Flags are set on the consumer thread when a push brings the number of pending elements
+ * up to the watermark. Safe to call while the producer runs, pushes in between may miss
+ * a wakeup.
+ *
+ * @param ring
+ * @param thread_id consumer thread, NULL to disable wakeups
+ * @param flags thread flags to set
+ * @param watermark number of pending elements, from 1 to capacity
+ */
+void spsc_ring_set_wakeup(
+    SpscRing* ring,
+    FuriThreadId thread_id,
+    uint32_t flags,
+    size_t watermark);
+
+/**
+ * @brief Push one element, producer side, interrupt safe
+ *
+ * @param ring
+ * @param element pointer to element_size bytes
+ * @return true if pushed, false if the ring is full and the element is dropped
+ */
+bool spsc_ring_push(SpscRing* ring, const void* element);
+
+/**
+ * @brief Pop pending elements, consumer side
+ *
+ * @param ring
+ * @param elements destination for up to count elements
+ * @param count maximum number of elements to pop
+ * @return size_t number of elements popped
+ */
+size_t spsc_ring_pop(SpscRing* ring, void* elements, size_t count);
+
+/**
+ * @brief Get number of pending elements
+ *
+ * @param ring
+ * @return size_t
+ */
+size_t spsc_ring_get_count(SpscRing* ring);
+
+/**
+ * @brief Get number of elements dropped because the ring was full
+ *
+ * Counter is never reset, compare it with a previously read value.
+ *
+ * @param ring
+ * @return uint32_t
+ */
+uint32_t spsc_ring_get_overrun_count(SpscRing* ring);
+
+/**
+ * @brief Drop all pending elements, consumer side
+ *
+ * @param ring
+ */
+void spsc_ring_flush(SpscRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
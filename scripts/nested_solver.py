@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+
+import os
+import shlex
+import subprocess
+import tempfile
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+
+class Main(App):
+    NESTED_LOG_PATH = "/ext/nfc/.nested.log"
+    # Log in the poller format with the parity conventions of the poller, made by
+    # `nested_solver -s -w`, every target uses the same key
+    FIXTURE_NAME = "nested_solver_fixture.log"
+    FIXTURE_KEY = "9abed9c25258"
+    FIXTURE_RANGE = "9abed8000000:9abedc000000"
+
+    def init(self):
+        self.root_dir = os.path.abspath(
+            os.path.join(os.path.dirname(__file__), os.pardir)
+        )
+        self.source_dir = os.path.join(self.root_dir, "lib", "nested_solver")
+
+        self.parser.add_argument(
+            "--build-dir",
+            help="Solver build directory",
+            default=os.path.join(self.root_dir, "build", "nested_solver"),
+        )
+        self.parser.add_argument(
+            "--cc",
+            help="Host C compiler",
+            default=os.environ.get("CC", "cc"),
+        )
+        self.parser.add_argument(
+            "--cflags",
+            help="Host compiler flags",
+            default="-O3 -march=native",
+        )
+
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_solve = self.subparsers.add_parser(
+            "solve", help="Recover keys from the nested attack nonce log"
+        )
+        self.parser_solve.add_argument(
+            "log",
+            nargs="?",
+            help=f"Nonce log, fetched from {self.NESTED_LOG_PATH} if omitted",
+        )
+        self.parser_solve.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_solve.add_argument(
+            "-t", "--threads", type=int, help="Worker threads, all cores by default"
+        )
+        self.parser_solve.add_argument(
+            "-r", "--range", help="Key range to search, hex start:end, end exclusive"
+        )
+        self.parser_solve.add_argument(
+            "-c", "--checkpoint", help="Checkpoint file to resume from and update"
+        )
+        self.parser_solve.add_argument(
+            "-i", "--interval", type=int, help="Checkpoint interval, seconds"
+        )
+        self.parser_solve.add_argument(
+            "-a",
+            "--all",
+            action="store_true",
+            help="Find all matching keys, not only the first one",
+        )
+        self.parser_solve.set_defaults(func=self.solve)
+
+        self.parser_selftest = self.subparsers.add_parser(
+            "selftest",
+            help="Solve a nonce log made with a random key, then the fixture log",
+        )
+        self.parser_selftest.add_argument(
+            "-t", "--threads", type=int, help="Worker threads, all cores by default"
+        )
+        self.parser_selftest.set_defaults(func=self.selftest)
+
+    def _build(self):
+        sources = sorted(
+            os.path.join(self.source_dir, name)
+            for name in os.listdir(self.source_dir)
+            if name.endswith((".c", ".h"))
+        )
+        binary = os.path.join(self.args.build_dir, "nested_solver")
+
+        if os.path.exists(binary):
+            binary_mtime = os.path.getmtime(binary)
+            if all(os.path.getmtime(source) < binary_mtime for source in sources):
+                return binary
+
+        os.makedirs(self.args.build_dir, exist_ok=True)
+        cmd = [
+            self.args.cc,
+            *shlex.split(self.args.cflags),
+            "-std=gnu11",
+            "-pthread",
+            "-o",
+            binary,
+            *(source for source in sources if source.endswith(".c")),
+        ]
+        self.logger.info(f"Building {binary}")
+        self.logger.debug(" ".join(cmd))
+        subprocess.run(cmd, check=True)
+        return binary
+
+    def _fetch_log(self, local_path):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            return False
+
+        with FlipperStorage(port) as storage:
+            if not storage.exist_file(self.NESTED_LOG_PATH):
+                self.logger.error(f"{self.NESTED_LOG_PATH} not found")
+                return False
+            self.logger.info(f"Fetching {self.NESTED_LOG_PATH}")
+            storage.receive_file(self.NESTED_LOG_PATH, local_path)
+        return True
+
+    def _run(self, args):
+        binary = self._build()
+        # Solver prints found keys to stdout and progress to stderr
+        return subprocess.run([binary, *args]).returncode
+
+    def solve(self):
+        args = []
+        if self.args.threads:
+            args += ["-t", str(self.args.threads)]
+        if self.args.range:
+            args += ["-r", self.args.range]
+        if self.args.checkpoint:
+            args += ["-c", self.args.checkpoint]
+        if self.args.interval:
+            args += ["-i", str(self.args.interval)]
+        if self.args.all:
+            args.append("-a")
+
+        if self.args.log:
+            return self._run([*args, self.args.log])
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            log_path = os.path.join(temp_dir, "nested.log")
+            if not self._fetch_log(log_path):
+                return 1
+            return self._run([*args, log_path])
+
+    def selftest(self):
+        args = []
+        if self.args.threads:
+            args += ["-t", str(self.args.threads)]
+        if ret := self._run([*args, "-s"]):
+            return ret
+
+        fixture = os.path.join(self.source_dir, self.FIXTURE_NAME)
+        self.logger.info(f"Solving {fixture}")
+        return self._run(
+            [*args, "-k", self.FIXTURE_KEY, "-r", self.FIXTURE_RANGE, fixture]
+        )
+
+
+if __name__ == "__main__":
+    Main()()
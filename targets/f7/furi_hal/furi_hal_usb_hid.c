@@ -300,6 +300,48 @@ bool furi_hal_hid_kb_release(uint16_t button) {
     return hid_send_report(ReportIdKeyboard);
 }
 
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+
+    size_t free_keys = 0;
+    for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+        if(hid_report.keyboard.boot.btn[key_nb] == 0) free_keys++;
+    }
+    if(count > free_keys) return false;
+
+    uint8_t key_nb = 0;
+    for(size_t i = 0; i < count; i++) {
+        while(hid_report.keyboard.boot.btn[key_nb] != 0) {
+            key_nb++;
+        }
+        hid_report.keyboard.boot.btn[key_nb] = buttons[i] & 0xFF;
+        hid_report.keyboard.boot.mods |= (buttons[i] >> 8);
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+
+    for(size_t i = 0; i < count; i++) {
+        for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+            if(hid_report.keyboard.boot.btn[key_nb] == (buttons[i] & 0xFF)) {
+                hid_report.keyboard.boot.btn[key_nb] = 0;
+                break;
+            }
+        }
+        hid_report.keyboard.boot.mods &= ~(buttons[i] >> 8);
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
+uint8_t furi_hal_hid_kb_get_report(uint8_t* keys) {
+    furi_check(keys);
+
+    memcpy(keys, hid_report.keyboard.boot.btn, HID_KB_MAX_KEYS);
+    return hid_report.keyboard.boot.mods;
+}
+
 bool furi_hal_hid_kb_release_all(void) {
     for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
         hid_report.keyboard.boot.btn[key_nb] = 0;
@@ -222,6 +222,33 @@ bool furi_hal_hid_kb_press(uint16_t button);
  */
 bool furi_hal_hid_kb_release(uint16_t button);
 
+/** Set the following keys to pressed state and send a single HID report
+ *
+ * Keys are placed into free report slots in the order they are given.
+ * Nothing is pressed if there are fewer free slots than keys.
+ *
+ * @param      buttons  key codes
+ * @param      count    number of key codes
+ *
+ * @return     true if the keys were pressed and the report was sent
+ */
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count);
+
+/** Set the following keys to released state and send a single HID report
+ *
+ * @param      buttons  key codes
+ * @param      count    number of key codes
+ */
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count);
+
+/** Get the keyboard report state, as sent by the last report
+ *
+ * @param      keys  buffer for HID_KB_MAX_KEYS key codes, 0 marks a free slot
+ *
+ * @return     modifiers
+ */
+uint8_t furi_hal_hid_kb_get_report(uint8_t* keys);
+
 /** Clear all pressed keys and send HID report
  *
  */